@@ -27,9 +27,7 @@ BlockChainServer::~BlockChainServer()
 void BlockChainServer::Initialize()
 {
 	const FullBlock& genesisBlock = m_config.GetEnvironment().GetGenesisBlock();
-	BlockIndex* pGenesisIndex = new BlockIndex(genesisBlock.GetHash(), 0, nullptr);
-
-	m_pChainStore = new ChainStore(m_config, pGenesisIndex);
+	m_pChainStore = new ChainStore(m_config, genesisBlock.GetHash());
 	m_pChainStore->Load();
 
 	m_pHeaderMMR = HeaderMMRAPI::OpenHeaderMMR(m_config);
@@ -38,7 +36,7 @@ void BlockChainServer::Initialize()
 	m_pChainState = new ChainState(m_config, *m_pChainStore, *m_pBlockStore, *m_pHeaderMMR, m_transactionPool, m_txHashSetManager);
 	m_pChainState->Initialize(genesisBlock.GetBlockHeader());
 
-	// TODO: Trigger Compaction
+	m_txHashSetManager.StartCompaction();
 
 	m_initialized = true;
 }
@@ -49,6 +47,7 @@ void BlockChainServer::Shutdown()
 	{
 		m_initialized = false;
 
+		m_txHashSetManager.StopCompaction();
 		m_pChainState->FlushAll();
 
 		delete m_pChainState;
@@ -89,8 +88,8 @@ EBlockChainStatus BlockChainServer::AddCompactBlock(const CompactBlock& compactB
 {
 	const Hash& hash = compactBlock.GetHash();
 
-	std::unique_ptr<BlockHeader> pConfirmedHeader = m_pChainState->GetBlockHeaderByHeight(compactBlock.GetBlockHeader().GetHeight(), EChainType::CONFIRMED);
-	if (pConfirmedHeader != nullptr && pConfirmedHeader->GetHash() == hash)
+	std::optional<HeaderSummary> confirmedSummaryOpt = m_pChainState->GetHeaderSummaryByHeight(compactBlock.GetBlockHeader().GetHeight(), EChainType::CONFIRMED);
+	if (confirmedSummaryOpt.has_value() && confirmedSummaryOpt.value().GetHash() == hash)
 	{
 		return EBlockChainStatus::ALREADY_EXISTS;
 	}
@@ -160,17 +159,7 @@ EBlockChainStatus BlockChainServer::AddBlockHeaders(const std::vector<BlockHeade
 
 std::vector<BlockHeader> BlockChainServer::GetBlockHeadersByHash(const std::vector<CBigInteger<32>>& hashes) const
 {
-	std::vector<BlockHeader> headers;
-	for (const CBigInteger<32>& hash : hashes)
-	{
-		std::unique_ptr<BlockHeader> pHeader = m_pBlockStore->GetBlockHeaderByHash(hash);
-		if (pHeader != nullptr)
-		{
-			headers.push_back(*pHeader);
-		}
-	}
-
-	return headers;
+	return m_pBlockStore->GetBlockHeadersByHash(hashes);
 }
 
 std::unique_ptr<BlockHeader> BlockChainServer::GetBlockHeaderByHeight(const uint64_t height, const EChainType chainType) const
@@ -178,6 +167,11 @@ std::unique_ptr<BlockHeader> BlockChainServer::GetBlockHeaderByHeight(const uint
 	return m_pChainState->GetBlockHeaderByHeight(height, chainType);
 }
 
+std::optional<HeaderSummary> BlockChainServer::GetHeaderSummaryByHeight(const uint64_t height, const EChainType chainType) const
+{
+	return m_pChainState->GetHeaderSummaryByHeight(height, chainType);
+}
+
 std::unique_ptr<BlockHeader> BlockChainServer::GetBlockHeaderByHash(const CBigInteger<32>& hash) const
 {
 	return m_pBlockStore->GetBlockHeaderByHash(hash);
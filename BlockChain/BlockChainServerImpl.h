@@ -41,6 +41,7 @@ public:
 	virtual std::unique_ptr<Transaction> GetTransactionByKernelHash(const Hash& kernelHash) const override final;
 
 	virtual std::unique_ptr<BlockHeader> GetBlockHeaderByHeight(const uint64_t height, const EChainType chainType) const override final;
+	virtual std::optional<HeaderSummary> GetHeaderSummaryByHeight(const uint64_t height, const EChainType chainType) const override final;
 	virtual std::unique_ptr<BlockHeader> GetBlockHeaderByHash(const CBigInteger<32>& hash) const override final;
 	virtual std::unique_ptr<BlockHeader> GetBlockHeaderByCommitment(const Commitment& outputCommitment) const override final;
 	virtual std::unique_ptr<BlockHeader> GetTipBlockHeader(const EChainType chainType) const override final;
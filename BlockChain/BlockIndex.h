@@ -8,7 +8,7 @@ class BlockIndex
 {
 public:
 	BlockIndex(const Hash& hash, const uint64_t height, BlockIndex* pPrevious)
-		: m_hash(hash), m_height(height), m_pPrevious(pPrevious), m_chainTypeMask(0)
+		: m_hash(hash), m_height(height), m_pPrevious(pPrevious), m_outputMMRSize(0), m_kernelMMRSize(0), m_chainTypeMask(0)
 	{
 
 	}
@@ -17,6 +17,15 @@ public:
 	inline uint64_t GetHeight() const { return m_height; }
 	inline BlockIndex* GetPrevious() const { return m_pPrevious; }
 
+	// MMR sizes are 0 until known, since chains are loaded from their hashes alone.
+	inline uint64_t GetOutputMMRSize() const { return m_outputMMRSize; }
+	inline uint64_t GetKernelMMRSize() const { return m_kernelMMRSize; }
+	inline void SetMMRSizes(const uint64_t outputMMRSize, const uint64_t kernelMMRSize)
+	{
+		m_outputMMRSize = outputMMRSize;
+		m_kernelMMRSize = kernelMMRSize;
+	}
+
 	inline void AddChainType(const EChainType chainType) { m_chainTypeMask = ChainType::AddChainType(m_chainTypeMask, chainType); }
 	inline void RemoveChainType(const EChainType chainType) { m_chainTypeMask = ChainType::RemoveChainType(m_chainTypeMask, chainType); }
 
@@ -29,7 +38,8 @@ public:
 private:
 	Hash m_hash;
 	uint64_t m_height;
-	BlockIndex* m_pPrevious; // TODO: Storing this is probably not necessary
+	BlockIndex* m_pPrevious; // Used to find where chains fork, and to check blocks extend the tip.
+	uint64_t m_outputMMRSize;
+	uint64_t m_kernelMMRSize;
 	uint8_t m_chainTypeMask;
-	// TODO: Also save output & kernel MMR sizes
 };
\ No newline at end of file
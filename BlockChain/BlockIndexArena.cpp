@@ -0,0 +1,41 @@
+#include "BlockIndexArena.h"
+
+#include <new>
+
+BlockIndexArena::BlockIndexArena()
+	: m_numUsed(0)
+{
+
+}
+
+BlockIndex* BlockIndexArena::Create(const Hash& hash, const uint64_t height, BlockIndex* pPrevious)
+{
+	if (!m_freeList.empty())
+	{
+		BlockIndex* pBlockIndex = m_freeList.back();
+		m_freeList.pop_back();
+
+		return new (pBlockIndex) BlockIndex(hash, height, pPrevious);
+	}
+
+	Reserve(m_numUsed + 1);
+
+	Slot* pSlot = &m_slabs[m_numUsed / SLAB_SIZE][m_numUsed % SLAB_SIZE];
+	++m_numUsed;
+
+	return new (pSlot) BlockIndex(hash, height, pPrevious);
+}
+
+void BlockIndexArena::Destroy(BlockIndex* pBlockIndex)
+{
+	pBlockIndex->~BlockIndex();
+	m_freeList.push_back(pBlockIndex);
+}
+
+void BlockIndexArena::Reserve(const size_t numIndexes)
+{
+	while (m_slabs.size() * SLAB_SIZE < numIndexes)
+	{
+		m_slabs.emplace_back(std::make_unique<Slot[]>(SLAB_SIZE));
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "BlockIndex.h"
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+//
+// Allocates BlockIndexes from large slabs, so loading a chain doesn't make an allocation per header,
+// and indexes that are close in height are usually close in memory.
+// Destroyed indexes are reused by the next Create, so rewinds don't churn the heap.
+// Every index is freed along with the arena.
+//
+class BlockIndexArena
+{
+public:
+	BlockIndexArena();
+
+	BlockIndexArena(const BlockIndexArena&) = delete;
+	BlockIndexArena& operator=(const BlockIndexArena&) = delete;
+
+	BlockIndex* Create(const Hash& hash, const uint64_t height, BlockIndex* pPrevious);
+	void Destroy(BlockIndex* pBlockIndex);
+
+	//
+	// Allocates enough slabs up front to hold numIndexes in total.
+	//
+	void Reserve(const size_t numIndexes);
+
+private:
+	// Slabs are released without running destructors.
+	static_assert(std::is_trivially_destructible<BlockIndex>::value, "BlockIndex must be trivially destructible");
+
+	using Slot = std::aligned_storage<sizeof(BlockIndex), alignof(BlockIndex)>::type;
+	static const size_t SLAB_SIZE = 16384;
+
+	std::vector<std::unique_ptr<Slot[]>> m_slabs;
+	size_t m_numUsed;
+	std::vector<BlockIndex*> m_freeList;
+};
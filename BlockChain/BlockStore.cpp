@@ -16,6 +16,21 @@ std::unique_ptr<BlockHeader> BlockStore::GetBlockHeaderByHash(const Hash& hash)
 	return m_blockDB.GetBlockHeader(hash);
 }
 
+std::vector<BlockHeader> BlockStore::GetBlockHeadersByHash(const std::vector<Hash>& hashes) const
+{
+	const std::vector<BlockHeader*> headersFound = m_blockDB.LoadBlockHeaders(hashes);
+
+	std::vector<BlockHeader> headers;
+	headers.reserve(headersFound.size());
+	for (BlockHeader* pHeader : headersFound)
+	{
+		headers.emplace_back(std::move(*pHeader));
+		delete pHeader;
+	}
+
+	return headers;
+}
+
 bool BlockStore::AddHeader(const BlockHeader& blockHeader)
 {
 	m_blockDB.AddBlockHeader(blockHeader);
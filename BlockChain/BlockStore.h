@@ -13,6 +13,7 @@ public:
 	~BlockStore();
 
 	std::unique_ptr<BlockHeader> GetBlockHeaderByHash(const Hash& hash) const;
+	std::vector<BlockHeader> GetBlockHeadersByHash(const std::vector<Hash>& hashes) const;
 
 	bool AddHeader(const BlockHeader& blockHeader);
 	void AddHeaders(const std::vector<BlockHeader>& blockHeaders);
@@ -1,8 +1,8 @@
 #include "Chain.h"
 #include "ChainStore.h"
 
-Chain::Chain(const EChainType chainType, const std::string& path, BlockIndex* pGenesisBlock)
-	: m_chainType(chainType), m_dataFile(path), m_height(0)
+Chain::Chain(const EChainType chainType, const std::string& path, BlockIndexArena& indexArena, BlockIndex* pGenesisBlock)
+	: m_chainType(chainType), m_indexArena(indexArena), m_dataFile(path), m_height(0)
 {
 	pGenesisBlock->AddChainType(m_chainType);
 	m_indices.push_back(pGenesisBlock);
@@ -17,6 +17,9 @@ bool Chain::Load(ChainStore& chainStore)
 	}
 	else
 	{
+		m_indexArena.Reserve(m_dataFile.GetSize());
+		m_indices.reserve(m_dataFile.GetSize());
+
 		BlockIndex* pPrevious = GetByHeight(0);
 		while ((m_height + 1) < m_dataFile.GetSize())
 		{
@@ -96,7 +99,7 @@ bool Chain::Rewind(const uint64_t lastHeight)
 			pBlockIndex->RemoveChainType(m_chainType);
 			if (pBlockIndex->IsSafeToDelete())
 			{
-				delete pBlockIndex;
+				m_indexArena.Destroy(pBlockIndex);
 			}
 		}
 
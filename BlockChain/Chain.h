@@ -1,6 +1,7 @@
 #pragma once
 
 #include "BlockIndex.h"
+#include "BlockIndexArena.h"
 
 #include <Core/DataFile.h>
 
@@ -10,7 +11,7 @@ class ChainStore;
 class Chain
 {
 public:
-	Chain(const EChainType chainType, const std::string& path, BlockIndex* pGenesisBlock);
+	Chain(const EChainType chainType, const std::string& path, BlockIndexArena& indexArena, BlockIndex* pGenesisBlock);
 	bool Load(ChainStore& chainStore);
 
 	BlockIndex* GetByHeight(const uint64_t height);
@@ -27,6 +28,7 @@ public:
 
 private:
 	const EChainType m_chainType;
+	BlockIndexArena& m_indexArena;
 	std::vector<BlockIndex*> m_indices;
 	size_t m_height;
 	DataFile<32> m_dataFile;
@@ -2,12 +2,13 @@
 
 #include <Consensus/BlockTime.h>
 #include <Database/BlockDb.h>
+#include <Infrastructure/Logger.h>
 #include <PMMR/TxHashSetManager.h>
 #include <TxPool/TransactionPool.h>
 #include <PMMR/TxHashSetManager.h>
 
 ChainState::ChainState(const Config& config, ChainStore& chainStore, BlockStore& blockStore, IHeaderMMR& headerMMR, ITransactionPool& transactionPool, TxHashSetManager& txHashSetManager)
-	: m_config(config), m_chainStore(chainStore), m_blockStore(blockStore), m_headerMMR(headerMMR), m_transactionPool(transactionPool), m_txHashSetManager(txHashSetManager)
+	: m_config(config), m_chainStore(chainStore), m_blockStore(blockStore), m_headerSummaries(config.GetChainDirectory() + "candidate.headers"), m_headerMMR(headerMMR), m_transactionPool(transactionPool), m_txHashSetManager(txHashSetManager)
 {
 
 }
@@ -29,27 +30,49 @@ void ChainState::Initialize(const BlockHeader& genesisHeader)
 		m_headerMMR.AddHeader(genesisHeader);
 	}
 
+	// Summaries are missing after upgrading, or may be behind the chain after a crash, so catch them up before they're used.
+	m_headerSummaries.Load();
+	m_headerSummaries.Sync(candidateChain, m_blockStore);
+
+	// The chains only store hashes, so fill in the MMR sizes from the summaries.
+	for (uint64_t height = 0; height <= candidateChain.GetTip()->GetHeight(); height++)
+	{
+		std::optional<HeaderSummary> summaryOpt = m_headerSummaries.GetByHeight(height);
+		BlockIndex* pBlockIndex = candidateChain.GetByHeight(height);
+		if (summaryOpt.has_value() && summaryOpt.value().GetHash() == pBlockIndex->GetHash())
+		{
+			pBlockIndex->SetMMRSizes(summaryOpt.value().GetOutputMMRSize(), summaryOpt.value().GetKernelMMRSize());
+		}
+	}
+
 	const BlockIndex* pConfirmedIndex = m_chainStore.GetConfirmedChain().GetTip();
 	const std::unique_ptr<BlockHeader> pConfirmedHeader = m_blockStore.GetBlockHeaderByHash(pConfirmedIndex->GetHash());
-	m_txHashSetManager.Open(*pConfirmedHeader);
+	if (m_txHashSetManager.Open(*pConfirmedHeader) == nullptr)
+	{
+		// The TxHashSet can't be brought back to the confirmed tip, so start the confirmed chain over and let sync rebuild both.
+		LoggerAPI::LogError("ChainState::Initialize - TxHashSet doesn't match confirmed tip " + pConfirmedHeader->FormatHash() + ". Resyncing it.");
+		m_chainStore.GetConfirmedChain().Rewind(0);
+		m_chainStore.Flush();
+		m_txHashSetManager.Reset(genesisHeader);
+	}
 }
 
 void ChainState::UpdateSyncStatus(SyncStatus& syncStatus) const
 {
 	std::shared_lock<std::shared_mutex> readLock(m_chainMutex);
 
-	const Hash& candidateHeadHash = GetHeadHash_Locked(EChainType::CANDIDATE);
-	std::unique_ptr<BlockHeader> pCandidateHead = m_blockStore.GetBlockHeaderByHash(candidateHeadHash);
-	if (pCandidateHead != nullptr)
+	const uint64_t candidateHeight = m_chainStore.GetCandidateChain().GetTip()->GetHeight();
+	std::optional<HeaderSummary> candidateHeadOpt = GetHeaderSummary_Locked(candidateHeight, EChainType::CANDIDATE);
+	if (candidateHeadOpt.has_value())
 	{
-		syncStatus.UpdateHeaderStatus(pCandidateHead->GetHeight(), pCandidateHead->GetTotalDifficulty());
+		syncStatus.UpdateHeaderStatus(candidateHeight, candidateHeadOpt.value().GetTotalDifficulty());
 	}
 
-	const Hash& confirmedHeadHash = GetHeadHash_Locked(EChainType::CONFIRMED);
-	std::unique_ptr<BlockHeader> pConfirmedHead = m_blockStore.GetBlockHeaderByHash(confirmedHeadHash);
-	if (pConfirmedHead != nullptr)
+	const uint64_t confirmedHeight = m_chainStore.GetConfirmedChain().GetTip()->GetHeight();
+	std::optional<HeaderSummary> confirmedHeadOpt = GetHeaderSummary_Locked(confirmedHeight, EChainType::CONFIRMED);
+	if (confirmedHeadOpt.has_value())
 	{
-		syncStatus.UpdateBlockStatus(pConfirmedHead->GetHeight(), pConfirmedHead->GetTotalDifficulty());
+		syncStatus.UpdateBlockStatus(confirmedHeight, confirmedHeadOpt.value().GetTotalDifficulty());
 	}
 }
 
@@ -57,23 +80,18 @@ uint64_t ChainState::GetHeight(const EChainType chainType) const
 {
 	std::shared_lock<std::shared_mutex> readLock(m_chainMutex);
 
-	std::unique_ptr<BlockHeader> pHead = GetHead_Locked(chainType);
-	if (pHead != nullptr)
-	{
-		return pHead->GetHeight();
-	}
-
-	return 0;
+	return m_chainStore.GetChain(chainType).GetTip()->GetHeight();
 }
 
 uint64_t ChainState::GetTotalDifficulty(const EChainType chainType) const
 {
 	std::shared_lock<std::shared_mutex> readLock(m_chainMutex);
 
-	std::unique_ptr<BlockHeader> pHead = GetHead_Locked(chainType);
-	if (pHead != nullptr)
+	const uint64_t height = m_chainStore.GetChain(chainType).GetTip()->GetHeight();
+	std::optional<HeaderSummary> headOpt = GetHeaderSummary_Locked(height, chainType);
+	if (headOpt.has_value())
 	{
-		return pHead->GetTotalDifficulty();
+		return headOpt.value().GetTotalDifficulty();
 	}
 
 	return 0;
@@ -126,6 +144,13 @@ std::unique_ptr<BlockHeader> ChainState::GetBlockHeaderByCommitment(const Commit
 	return std::unique_ptr<BlockHeader>(nullptr);
 }
 
+std::optional<HeaderSummary> ChainState::GetHeaderSummaryByHeight(const uint64_t height, const EChainType chainType) const
+{
+	std::shared_lock<std::shared_mutex> readLock(m_chainMutex);
+
+	return GetHeaderSummary_Locked(height, chainType);
+}
+
 std::unique_ptr<FullBlock> ChainState::GetBlockByHash(const Hash& hash) const
 {
 	std::shared_lock<std::shared_mutex> readLock(m_chainMutex);
@@ -234,9 +259,33 @@ const Hash& ChainState::GetHeadHash_Locked(const EChainType chainType) const
 	return m_chainStore.GetChain(chainType).GetTip()->GetHash();
 }
 
+// Uses the candidate chain's summaries when the chain matches the candidate chain at that height. Otherwise, loads the header.
+std::optional<HeaderSummary> ChainState::GetHeaderSummary_Locked(const uint64_t height, const EChainType chainType) const
+{
+	const BlockIndex* pBlockIndex = m_chainStore.GetChain(chainType).GetByHeight(height);
+	if (pBlockIndex == nullptr)
+	{
+		return std::nullopt;
+	}
+
+	std::optional<HeaderSummary> summaryOpt = m_headerSummaries.GetByHeight(height);
+	if (summaryOpt.has_value() && summaryOpt.value().GetHash() == pBlockIndex->GetHash())
+	{
+		return summaryOpt;
+	}
+
+	std::unique_ptr<BlockHeader> pHeader = m_blockStore.GetBlockHeaderByHash(pBlockIndex->GetHash());
+	if (pHeader != nullptr)
+	{
+		return std::make_optional<HeaderSummary>(HeaderSummary::FromHeader(*pHeader));
+	}
+
+	return std::nullopt;
+}
+
 LockedChainState ChainState::GetLocked()
 {
-	return LockedChainState(m_chainMutex, m_chainStore, m_blockStore, m_headerMMR, m_orphanPool, m_transactionPool, m_txHashSetManager);
+	return LockedChainState(m_chainMutex, m_chainStore, m_blockStore, m_headerSummaries, m_headerMMR, m_orphanPool, m_transactionPool, m_txHashSetManager);
 }
 
 void ChainState::FlushAll()
@@ -244,6 +293,10 @@ void ChainState::FlushAll()
 	std::unique_lock<std::shared_mutex> writeLock(m_chainMutex);
 
 	m_headerMMR.Commit();
-	m_chainStore.Flush();
-	m_txHashSetManager.Flush();
+
+	// The chain is only flushed once the TxHashSet is, since a TxHashSet ahead of the chain can be rewound on startup.
+	if (m_txHashSetManager.Flush())
+	{
+		m_chainStore.Flush();
+	}
 }
\ No newline at end of file
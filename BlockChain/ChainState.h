@@ -3,6 +3,7 @@
 #include "Chain.h"
 #include "ChainStore.h"
 #include "BlockStore.h"
+#include "HeaderSummaryStore.h"
 #include "LockedChainState.h"
 #include "OrphanPool/OrphanPool.h"
 
@@ -34,6 +35,7 @@ public:
 	std::unique_ptr<BlockHeader> GetBlockHeaderByHash(const Hash& hash) const;
 	std::unique_ptr<BlockHeader> GetBlockHeaderByHeight(const uint64_t height, const EChainType chainType) const;
 	std::unique_ptr<BlockHeader> GetBlockHeaderByCommitment(const Commitment& outputCommitment) const;
+	std::optional<HeaderSummary> GetHeaderSummaryByHeight(const uint64_t height, const EChainType chainType) const;
 
 	std::unique_ptr<FullBlock> GetBlockByHash(const Hash& hash) const;
 	std::unique_ptr<FullBlock> GetBlockByHeight(const uint64_t height) const;
@@ -43,18 +45,23 @@ public:
 
 	std::vector<std::pair<uint64_t, Hash>> GetBlocksNeeded(const uint64_t maxNumBlocks) const;
 
+	// The BlockDB synchronizes itself, so it can be used without locking the chain state.
+	inline const IBlockDB& GetBlockDB() const { return m_blockStore.GetBlockDB(); }
+
 	LockedChainState GetLocked();
 	void FlushAll();
 
 private:
 	std::unique_ptr<BlockHeader> GetHead_Locked(const EChainType chainType) const;
 	const Hash& GetHeadHash_Locked(const EChainType chainType) const;
+	std::optional<HeaderSummary> GetHeaderSummary_Locked(const uint64_t height, const EChainType chainType) const;
 
 	mutable std::shared_mutex m_chainMutex;
 
 	const Config& m_config;
 	ChainStore& m_chainStore;
 	BlockStore& m_blockStore;
+	HeaderSummaryStore m_headerSummaries;
 	OrphanPool m_orphanPool;
 	IHeaderMMR& m_headerMMR;
 	ITransactionPool& m_transactionPool;
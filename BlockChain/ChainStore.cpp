@@ -5,12 +5,13 @@
 #include <vector>
 #include <map>
 
-ChainStore::ChainStore(const Config& config, BlockIndex* pGenesisIndex)
-	: m_config(config),
-	m_confirmedChain(EChainType::CONFIRMED, config.GetChainDirectory() + "confirmed.chain", pGenesisIndex),
-	m_candidateChain(EChainType::CANDIDATE, config.GetChainDirectory() + "candidate.chain", pGenesisIndex),
-	m_syncChain(EChainType::SYNC, config.GetChainDirectory() + "sync.chain", pGenesisIndex),
-	m_loaded(false)
+ChainStore::ChainStore(const Config& config, const Hash& genesisHash)
+	: m_pGenesisIndex(m_indexArena.Create(genesisHash, 0, nullptr)),
+	m_loaded(false),
+	m_confirmedChain(EChainType::CONFIRMED, config.GetChainDirectory() + "confirmed.chain", m_indexArena, m_pGenesisIndex),
+	m_candidateChain(EChainType::CANDIDATE, config.GetChainDirectory() + "candidate.chain", m_indexArena, m_pGenesisIndex),
+	m_syncChain(EChainType::SYNC, config.GetChainDirectory() + "sync.chain", m_indexArena, m_pGenesisIndex),
+	m_config(config)
 {
 
 }
@@ -68,7 +69,15 @@ BlockIndex* ChainStore::GetOrCreateIndex(const Hash& hash, const uint64_t height
 		return pConfirmedIndex;
 	}
 
-	return new BlockIndex(hash, height, pPreviousIndex);
+	return m_indexArena.Create(hash, height, pPreviousIndex);
+}
+
+BlockIndex* ChainStore::GetOrCreateIndex(const BlockHeader& header, BlockIndex* pPreviousIndex)
+{
+	BlockIndex* pBlockIndex = GetOrCreateIndex(header.GetHash(), header.GetHeight(), pPreviousIndex);
+	pBlockIndex->SetMMRSizes(header.GetOutputMMRSize(), header.GetKernelMMRSize());
+
+	return pBlockIndex;
 }
 
 BlockIndex* ChainStore::FindCommonIndex(const EChainType chainType1, const EChainType chainType2)
@@ -8,13 +8,14 @@
 class ChainStore
 {
 public:
-	ChainStore(const Config& config, BlockIndex* pGenesisIndex);
+	ChainStore(const Config& config, const Hash& genesisHash);
 	bool Load();
 	bool Flush();
 
 	Chain& GetChain(const EChainType chainType);
 	const Chain& GetChain(const EChainType chainType) const;
 	BlockIndex* GetOrCreateIndex(const Hash& hash, const uint64_t height, BlockIndex* pPreviousIndex);
+	BlockIndex* GetOrCreateIndex(const BlockHeader& header, BlockIndex* pPreviousIndex);
 	BlockIndex* FindCommonIndex(const EChainType chainType1, const EChainType chainType2);
 
 	//
@@ -29,6 +30,10 @@ public:
 	inline Chain& GetSyncChain() { return m_syncChain; }
 
 private:
+	// Must be declared before the chains, since they're initialized with indexes it creates.
+	BlockIndexArena m_indexArena;
+	BlockIndex* m_pGenesisIndex;
+
 	bool m_loaded;
 	Chain m_confirmedChain;
 	Chain m_candidateChain;
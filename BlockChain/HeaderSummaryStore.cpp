@@ -0,0 +1,68 @@
+#include "HeaderSummaryStore.h"
+
+#include <Infrastructure/Logger.h>
+
+HeaderSummaryStore::HeaderSummaryStore(const std::string& path)
+	: m_dataFile(path)
+{
+
+}
+
+bool HeaderSummaryStore::Load()
+{
+	return m_dataFile.Load();
+}
+
+std::optional<HeaderSummary> HeaderSummaryStore::GetByHeight(const uint64_t height) const
+{
+	const ByteView view = m_dataFile.GetDataViewAt(height);
+	if (view.size() != HeaderSummary::SIZE)
+	{
+		return std::nullopt;
+	}
+
+	ByteBuffer byteBuffer(view);
+	return std::make_optional<HeaderSummary>(HeaderSummary::Deserialize(height, byteBuffer));
+}
+
+bool HeaderSummaryStore::Sync(const Chain& chain, const BlockStore& blockStore)
+{
+	const uint64_t tipHeight = chain.GetTip()->GetHeight();
+
+	// Find the highest summary that still matches the chain. Reorgs are short, so this rarely looks at more than a few summaries.
+	uint64_t numMatching = (std::min)(m_dataFile.GetSize(), tipHeight + 1);
+	while (numMatching > 0)
+	{
+		const ByteView hashView = m_dataFile.GetDataViewAt(numMatching - 1);
+		if (hashView.size() == HeaderSummary::SIZE && Hash(hashView.data()) == chain.GetByHeight(numMatching - 1)->GetHash())
+		{
+			break;
+		}
+
+		--numMatching;
+	}
+
+	if (numMatching == m_dataFile.GetSize() && numMatching == tipHeight + 1)
+	{
+		return true;
+	}
+
+	m_dataFile.Rewind(numMatching);
+
+	for (uint64_t height = numMatching; height <= tipHeight; height++)
+	{
+		std::unique_ptr<BlockHeader> pHeader = blockStore.GetBlockHeaderByHash(chain.GetByHeight(height)->GetHash());
+		if (pHeader == nullptr)
+		{
+			LoggerAPI::LogError("HeaderSummaryStore::Sync - Header not found at height " + std::to_string(height));
+			m_dataFile.Flush();
+			return false;
+		}
+
+		Serializer serializer;
+		HeaderSummary::FromHeader(*pHeader).Serialize(serializer);
+		m_dataFile.AddData(serializer.GetBytes());
+	}
+
+	return m_dataFile.Flush();
+}
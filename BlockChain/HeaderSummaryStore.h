@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Chain.h"
+#include "BlockStore.h"
+
+#include <Core/DataFile.h>
+#include <Core/Models/HeaderSummary.h>
+#include <optional>
+
+//
+// Memory-mapped file of HeaderSummary records for the candidate chain, indexed by height,
+// so walking the chain by height is an array read instead of a hash lookup and a header deserialization.
+//
+// The summaries are kept in sync with the candidate chain by calling Sync after it changes.
+// Since each summary includes the header's hash, a summary is only trusted if its hash matches the chain's block index.
+// This also makes the file safe to use for the confirmed and sync chains wherever they match the candidate chain.
+//
+class HeaderSummaryStore
+{
+public:
+	HeaderSummaryStore(const std::string& path);
+
+	bool Load();
+
+	std::optional<HeaderSummary> GetByHeight(const uint64_t height) const;
+
+	//
+	// Rewinds the summaries to the last height matching the chain, and then appends the summaries of the chain's remaining headers.
+	//
+	bool Sync(const Chain& chain, const BlockStore& blockStore);
+
+private:
+	DataFile<HeaderSummary::SIZE> m_dataFile;
+};
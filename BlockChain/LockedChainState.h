@@ -2,6 +2,7 @@
 
 #include "BlockStore.h"
 #include "ChainStore.h"
+#include "HeaderSummaryStore.h"
 #include "OrphanPool/OrphanPool.h"
 
 #include <PMMR/HeaderMMR.h>
@@ -16,11 +17,12 @@
 class LockedChainState
 {
 public:
-	LockedChainState(std::shared_mutex& mutex, ChainStore& chainStore, BlockStore& blockStore, IHeaderMMR& headerMMR, OrphanPool& orphanPool, ITransactionPool& transactionPool, TxHashSetManager& txHashSetManager)
+	LockedChainState(std::shared_mutex& mutex, ChainStore& chainStore, BlockStore& blockStore, HeaderSummaryStore& headerSummaries, IHeaderMMR& headerMMR, OrphanPool& orphanPool, ITransactionPool& transactionPool, TxHashSetManager& txHashSetManager)
 		: m_pReferences(new int(1)), 
 		m_mutex(mutex), 
 		m_chainStore(chainStore), 
 		m_blockStore(blockStore), 
+		m_headerSummaries(headerSummaries), 
 		m_headerMMR(headerMMR), 
 		m_orphanPool(orphanPool),
 		m_transactionPool(transactionPool),
@@ -45,6 +47,7 @@ public:
 		m_mutex(other.m_mutex),
 		m_chainStore(other.m_chainStore),
 		m_blockStore(other.m_blockStore),
+		m_headerSummaries(other.m_headerSummaries),
 		m_headerMMR(other.m_headerMMR),
 		m_orphanPool(other.m_orphanPool),
 		m_transactionPool(other.m_transactionPool),
@@ -58,6 +61,7 @@ public:
 	std::shared_mutex& m_mutex;
 	ChainStore& m_chainStore;
 	BlockStore& m_blockStore;
+	HeaderSummaryStore& m_headerSummaries;
 	IHeaderMMR& m_headerMMR;
 	OrphanPool& m_orphanPool;
 	ITransactionPool& m_transactionPool;
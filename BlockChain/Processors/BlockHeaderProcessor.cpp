@@ -3,8 +3,10 @@
 
 #include <Infrastructure/Logger.h>
 #include <PMMR/HeaderMMR.h>
+#include <PoW/PoWManager.h>
 #include <Common/Util/HexUtil.h>
 #include <Common/Util/StringUtil.h>
+#include <async++.h>
 
 BlockHeaderProcessor::BlockHeaderProcessor(const Config& config, ChainState& chainState)
 	: m_config(config), m_chainState(chainState)
@@ -44,7 +46,10 @@ EBlockChainStatus BlockHeaderProcessor::ProcessSingleHeader(const BlockHeader& h
 				{
 					// All headers exist. Reorg.
 					std::reverse(headers.begin(), headers.end());
-					return ProcessChunkedSyncHeaders(lockedState, headers);
+					const EBlockChainStatus status = ProcessChunkedSyncHeaders(lockedState, headers, false);
+					lockedState.m_chainStore.Flush();
+					lockedState.m_headerSummaries.Sync(candidateChain, lockedState.m_blockStore);
+					return status;
 				}
 
 				const Hash previousHash = pHeader->GetPreviousBlockHash();
@@ -75,10 +80,11 @@ EBlockChainStatus BlockHeaderProcessor::ProcessSingleHeader(const BlockHeader& h
 	lockedState.m_headerMMR.AddHeader(header);
 	lockedState.m_headerMMR.Commit();
 
-	BlockIndex* pBlockIndex = lockedState.m_chainStore.GetOrCreateIndex(header.GetHash(), header.GetHeight(), pLastIndex);
+	BlockIndex* pBlockIndex = lockedState.m_chainStore.GetOrCreateIndex(header, pLastIndex);
 	lockedState.m_chainStore.GetSyncChain().AddBlock(pBlockIndex);
 	candidateChain.AddBlock(pBlockIndex);
 	lockedState.m_chainStore.Flush();
+	lockedState.m_headerSummaries.Sync(candidateChain, lockedState.m_blockStore);
 
 	LoggerAPI::LogDebug("BlockHeaderProcessor::ProcessSingleHeader - Successfully validated " + header.FormatHash());
 
@@ -99,37 +105,73 @@ EBlockChainStatus BlockHeaderProcessor::ProcessSyncHeaders(const std::vector<Blo
 		return EBlockChainStatus::INVALID;
 	}
 
+	// Verify the proofs of work in parallel before locking the chain state, since they don't depend on the chain.
+	if (!VerifyProofs(headers))
+	{
+		LoggerAPI::LogWarning("BlockHeaderProcessor::ProcessSyncHeaders - Invalid proof of work found.");
+		return EBlockChainStatus::INVALID;
+	}
+
+	// The whole message is processed under a single lock. By default, it's also a single chunk,
+	// so the header MMR is rewound and committed once, the headers are written in one batch, and the chains are flushed once.
 	const size_t size = headers.size();
-	size_t index = 0;
+	const size_t chunkSize = m_config.GetNodeConfig().GetHeaderChunkSize();
 
-	std::vector<BlockHeader> chunkedHeaders;
-	chunkedHeaders.reserve(32);
-	while (index < size)
+	LockedChainState lockedState = m_chainState.GetLocked();
+
+	EBlockChainStatus status = EBlockChainStatus::SUCCESS;
+	for (size_t first = 0; first < size; first += chunkSize)
 	{
-		chunkedHeaders.push_back(headers[index++]);
-		if (index % 32 == 0)
+		if (chunkSize >= size)
 		{
-			LockedChainState lockedState = m_chainState.GetLocked();
-			const EBlockChainStatus processChunkStatus = ProcessChunkedSyncHeaders(lockedState, chunkedHeaders);
-			if (processChunkStatus != EBlockChainStatus::SUCCESS && processChunkStatus != EBlockChainStatus::ALREADY_EXISTS)
-			{
-				return processChunkStatus;
-			}
+			status = ProcessChunkedSyncHeaders(lockedState, headers, true);
+		}
+		else
+		{
+			const std::vector<BlockHeader> chunkedHeaders(headers.cbegin() + first, headers.cbegin() + (std::min)(size, first + chunkSize));
+			status = ProcessChunkedSyncHeaders(lockedState, chunkedHeaders, true);
+		}
 
-			chunkedHeaders.clear();
+		if (status != EBlockChainStatus::SUCCESS && status != EBlockChainStatus::ALREADY_EXISTS)
+		{
+			break;
 		}
 	}
 
-	if (!chunkedHeaders.empty())
+	lockedState.m_chainStore.Flush();
+	lockedState.m_headerSummaries.Sync(lockedState.m_chainStore.GetCandidateChain(), lockedState.m_blockStore);
+
+	return status;
+}
+
+// Verifies the cuckoo cycles in parallel. Also calculates the header hashes, which are cached in the headers.
+bool BlockHeaderProcessor::VerifyProofs(const std::vector<BlockHeader>& headers) const
+{
+	const PoWManager powManager(m_config, m_chainState.GetBlockDB());
+
+	std::vector<async::task<bool>> tasks;
+	tasks.reserve(headers.size());
+	for (const BlockHeader& header : headers)
+	{
+		tasks.push_back(async::spawn([&powManager, &header] {
+			header.GetHash();
+			return powManager.IsProofValid(header);
+		}));
+	}
+
+	bool valid = true;
+	for (auto& task : tasks)
 	{
-		LockedChainState lockedState = m_chainState.GetLocked();
-		return ProcessChunkedSyncHeaders(lockedState, chunkedHeaders);
+		if (!task.get())
+		{
+			valid = false;
+		}
 	}
 
-	return EBlockChainStatus::SUCCESS;
+	return valid;
 }
 
-EBlockChainStatus BlockHeaderProcessor::ProcessChunkedSyncHeaders(LockedChainState& lockedState, const std::vector<BlockHeader>& headers)
+EBlockChainStatus BlockHeaderProcessor::ProcessChunkedSyncHeaders(LockedChainState& lockedState, const std::vector<BlockHeader>& headers, const bool proofsVerified)
 {
 	Chain& syncChain = lockedState.m_chainStore.GetSyncChain();
 	Chain& candidateChain = lockedState.m_chainStore.GetCandidateChain();
@@ -167,21 +209,23 @@ EBlockChainStatus BlockHeaderProcessor::ProcessChunkedSyncHeaders(LockedChainSta
 	headerMMR.Rewind(newHeaders.front().GetHeight());
 
 	// Validate the headers.
+	// They're only stored after the whole chunk is valid, so the difficulty window of each header reads its predecessors from newHeaders.
 	std::unique_ptr<BlockHeader> pPreviousHeaderPtr = lockedState.m_blockStore.GetBlockHeaderByHash(pPrevIndex->GetHash());
 	const BlockHeader* pPreviousHeader = pPreviousHeaderPtr.get();
 	for (auto& header : newHeaders)
 	{
-		if (!BlockHeaderValidator(m_config, lockedState.m_blockStore.GetBlockDB(), headerMMR).IsValidHeader(header, *pPreviousHeader))
+		if (!BlockHeaderValidator(m_config, lockedState.m_blockStore.GetBlockDB(), headerMMR).IsValidHeader(header, *pPreviousHeader, proofsVerified, &newHeaders))
 		{
 			headerMMR.Rollback();
 			return EBlockChainStatus::INVALID;
 		}
 
 		headerMMR.AddHeader(header);
-		lockedState.m_blockStore.AddHeader(header);
 		pPreviousHeader = &header;
 	}
 
+	lockedState.m_blockStore.AddHeaders(newHeaders);
+
 	// Add the headers to the chain state.
 	const EBlockChainStatus addSyncHeadersStatus = AddSyncHeaders(lockedState, newHeaders);
 	if (addSyncHeadersStatus != EBlockChainStatus::SUCCESS)
@@ -194,7 +238,7 @@ EBlockChainStatus BlockHeaderProcessor::ProcessChunkedSyncHeaders(LockedChainSta
 	}
 
 	// If total difficulty increases, accept sync chain as new candidate chain.
-	if (CheckAndAcceptSyncChain(lockedState))
+	if (CheckAndAcceptSyncChain(lockedState, newHeaders.back()))
 	{
 		headerMMR.Commit();
 	}
@@ -231,7 +275,7 @@ EBlockChainStatus BlockHeaderProcessor::AddSyncHeaders(LockedChainState& lockedS
 	for (auto& header : headers)
 	{
 		// Add to chain
-		BlockIndex* pBlockIndex = lockedState.m_chainStore.GetOrCreateIndex(header.GetHash(), header.GetHeight(), pPrevious);
+		BlockIndex* pBlockIndex = lockedState.m_chainStore.GetOrCreateIndex(header, pPrevious);
 		syncChain.AddBlock(pBlockIndex);
 		pPrevious = pBlockIndex;
 	}
@@ -239,22 +283,31 @@ EBlockChainStatus BlockHeaderProcessor::AddSyncHeaders(LockedChainState& lockedS
 	return EBlockChainStatus::SUCCESS;
 }
 
-bool BlockHeaderProcessor::CheckAndAcceptSyncChain(LockedChainState& lockedState) const
+bool BlockHeaderProcessor::CheckAndAcceptSyncChain(LockedChainState& lockedState, const BlockHeader& syncHead) const
 {
-	BlockIndex* pSyncTip = lockedState.m_chainStore.GetSyncChain().GetTip();
-	std::unique_ptr<BlockHeader> pSyncHead = lockedState.m_blockStore.GetBlockHeaderByHash(pSyncTip->GetHash());
-
-	BlockIndex* pCandidateTip = lockedState.m_chainStore.GetCandidateChain().GetTip();
-	std::unique_ptr<BlockHeader> pCandidateHead = lockedState.m_blockStore.GetBlockHeaderByHash(pCandidateTip->GetHash());
+	const uint64_t candidateHeight = lockedState.m_chainStore.GetCandidateChain().GetTip()->GetHeight();
+	const Hash& candidateHash = lockedState.m_chainStore.GetCandidateChain().GetTip()->GetHash();
 
-	if (pSyncHead == nullptr || pCandidateHead == nullptr)
+	uint64_t candidateDifficulty = 0;
+	std::optional<HeaderSummary> candidateSummaryOpt = lockedState.m_headerSummaries.GetByHeight(candidateHeight);
+	if (candidateSummaryOpt.has_value() && candidateSummaryOpt.value().GetHash() == candidateHash)
+	{
+		candidateDifficulty = candidateSummaryOpt.value().GetTotalDifficulty();
+	}
+	else
 	{
-		return false;
+		std::unique_ptr<BlockHeader> pCandidateHead = lockedState.m_blockStore.GetBlockHeaderByHash(candidateHash);
+		if (pCandidateHead == nullptr)
+		{
+			return false;
+		}
+
+		candidateDifficulty = pCandidateHead->GetTotalDifficulty();
 	}
 
-	if (pSyncHead->GetTotalDifficulty() > pCandidateHead->GetTotalDifficulty())
+	if (syncHead.GetTotalDifficulty() > candidateDifficulty)
 	{
-		return lockedState.m_chainStore.ReorgChain(EChainType::SYNC, EChainType::CANDIDATE, pSyncTip->GetHeight());
+		return lockedState.m_chainStore.ReorgChain(EChainType::SYNC, EChainType::CANDIDATE, syncHead.GetHeight());
 	}
 
 	return false;
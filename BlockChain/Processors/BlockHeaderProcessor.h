@@ -15,9 +15,10 @@ public:
 	EBlockChainStatus ProcessSingleHeader(const BlockHeader& header);
 
 private:
-	EBlockChainStatus ProcessChunkedSyncHeaders(LockedChainState& lockedState, const std::vector<BlockHeader>& headers);
+	bool VerifyProofs(const std::vector<BlockHeader>& headers) const;
+	EBlockChainStatus ProcessChunkedSyncHeaders(LockedChainState& lockedState, const std::vector<BlockHeader>& headers, const bool proofsVerified);
 	EBlockChainStatus AddSyncHeaders(LockedChainState& lockedState, const std::vector<BlockHeader>& headers) const;
-	bool CheckAndAcceptSyncChain(LockedChainState& lockedState) const;
+	bool CheckAndAcceptSyncChain(LockedChainState& lockedState, const BlockHeader& syncHead) const;
 
 	const Config& m_config;
 	ChainState& m_chainState;
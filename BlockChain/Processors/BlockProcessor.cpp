@@ -86,16 +86,36 @@ EBlockChainStatus BlockProcessor::ProcessBlockInternal(const FullBlock& block)
 
 EBlockChainStatus BlockProcessor::ProcessNextBlock(const FullBlock& block, LockedChainState& lockedState)
 {
+	ITxHashSet* pTxHashSet = lockedState.m_txHashSetManager.GetTxHashSet();
+
+	// All of the block's database changes are written at once, and only if the block is valid.
+	ScopedBlockDBBatch batch(lockedState.m_blockStore.GetBlockDB());
+
 	const EBlockChainStatus added = ValidateAndAddBlock(block, lockedState);
 	if (added != EBlockChainStatus::SUCCESS)
 	{
-		lockedState.m_txHashSetManager.GetTxHashSet()->Discard();
+		batch.Rollback();
+		pTxHashSet->Discard();
 		return added;
 	}
 
-	lockedState.m_txHashSetManager.GetTxHashSet()->Commit();
+	// The database is committed before the TxHashSet, since the block's input bitmap is needed to rewind it.
+	if (!batch.Commit())
+	{
+		pTxHashSet->Discard();
+		return EBlockChainStatus::STORE_ERROR;
+	}
+
+	if (!pTxHashSet->Commit())
+	{
+		LoggerAPI::LogError("BlockProcessor::ProcessNextBlock - Failed to commit TxHashSet for block " + block.GetBlockHeader().FormatHash());
+		pTxHashSet->Discard();
+		return EBlockChainStatus::STORE_ERROR;
+	}
+
 	lockedState.m_chainStore.AddBlock(EChainType::CANDIDATE, EChainType::CONFIRMED, block.GetBlockHeader().GetHeight());
 	lockedState.m_chainStore.Flush();
+	RemoveFromPools(block, lockedState);
 
 	return EBlockChainStatus::SUCCESS;
 }
@@ -189,6 +209,11 @@ EBlockChainStatus BlockProcessor::HandleReorg(const FullBlock& block, LockedChai
 		return EBlockChainStatus::UNKNOWN_ERROR;
 	}
 
+	ScopedBlockDBBatch batch(lockedState.m_blockStore.GetBlockDB());
+
+	// The blocks are only removed from the orphan and transaction pools once the whole reorg is committed,
+	// so they aren't lost if a later block turns out to be invalid.
+	std::vector<std::unique_ptr<FullBlock>> reorgBlocks;
 	for (uint64_t i = commonHeight + 1; i < block.GetBlockHeader().GetHeight(); i++)
 	{
 		BlockIndex* pIndex = candidateChain.GetByHeight(i);
@@ -200,6 +225,7 @@ EBlockChainStatus BlockProcessor::HandleReorg(const FullBlock& block, LockedChai
 
 		if (pBlock == nullptr)
 		{
+			batch.Rollback();
 			pTxHashSet->Discard();
 			return EBlockChainStatus::INVALID;
 		}
@@ -207,21 +233,45 @@ EBlockChainStatus BlockProcessor::HandleReorg(const FullBlock& block, LockedChai
 		const EBlockChainStatus added = ValidateAndAddBlock(*pBlock, lockedState);
 		if (added != EBlockChainStatus::SUCCESS)
 		{
+			batch.Rollback();
 			pTxHashSet->Discard();
 			return EBlockChainStatus::INVALID;
 		}
+
+		reorgBlocks.emplace_back(std::move(pBlock));
 	}
 
 	const EBlockChainStatus added = ValidateAndAddBlock(block, lockedState);
 	if (added != EBlockChainStatus::SUCCESS)
 	{
+		batch.Rollback();
 		pTxHashSet->Discard();
 		return EBlockChainStatus::INVALID;
 	}
 
+	if (!batch.Commit())
+	{
+		pTxHashSet->Discard();
+		return EBlockChainStatus::STORE_ERROR;
+	}
+
+	// Commit the TxHashSet before the chain, like ProcessNextBlock, so after a crash the TxHashSet can always be rewound to the confirmed tip.
+	if (!pTxHashSet->Commit())
+	{
+		LoggerAPI::LogError("BlockProcessor::HandleReorg - Failed to commit TxHashSet for block " + block.GetBlockHeader().FormatHash());
+		pTxHashSet->Discard();
+		return EBlockChainStatus::STORE_ERROR;
+	}
+
 	lockedState.m_chainStore.ReorgChain(EChainType::CANDIDATE, EChainType::CONFIRMED, block.GetBlockHeader().GetHeight());
 	lockedState.m_chainStore.Flush();
-	pTxHashSet->Commit();
+
+	for (const std::unique_ptr<FullBlock>& pReorgBlock : reorgBlocks)
+	{
+		RemoveFromPools(*pReorgBlock, lockedState);
+	}
+
+	RemoveFromPools(block, lockedState);
 	return EBlockChainStatus::SUCCESS;
 }
 
@@ -248,8 +298,15 @@ EBlockChainStatus BlockProcessor::ValidateAndAddBlock(const FullBlock& block, Lo
 
 	lockedState.m_blockStore.GetBlockDB().AddBlockSums(block.GetHash(), *pBlockSums);
 	lockedState.m_blockStore.AddBlock(block);
-	lockedState.m_orphanPool.RemoveOrphan(block.GetBlockHeader().GetHeight(), block.GetHash());
-	lockedState.m_transactionPool.ReconcileBlock(block);
 
 	return EBlockChainStatus::SUCCESS;
+}
+
+//
+// Must only be called once the block is committed, since the block can't be recovered from the pools afterwards.
+//
+void BlockProcessor::RemoveFromPools(const FullBlock& block, LockedChainState& lockedState)
+{
+	lockedState.m_orphanPool.RemoveOrphan(block.GetBlockHeader().GetHeight(), block.GetHash());
+	lockedState.m_transactionPool.ReconcileBlock(block);
 }
\ No newline at end of file
@@ -26,6 +26,7 @@ private:
 	EBlockChainStatus ProcessOrphanBlock(const FullBlock& block, LockedChainState& lockedState);
 	EBlockChainStatus HandleReorg(const FullBlock& block, LockedChainState& lockedState);
 	EBlockChainStatus ValidateAndAddBlock(const FullBlock& block, LockedChainState& lockedState);
+	void RemoveFromPools(const FullBlock& block, LockedChainState& lockedState);
 
 	EBlockStatus DetermineBlockStatus(const FullBlock& block, LockedChainState& lockedState);
 
@@ -34,7 +34,7 @@ bool TxHashSetProcessor::ProcessTxHashSet(const Hash& blockHash, const std::stri
 	}
 
 	// 3. Validate entire TxHashSet
-	std::unique_ptr<BlockSums> pBlockSums = pTxHashSet->ValidateTxHashSet(*pHeader, m_blockChainServer);
+	std::unique_ptr<BlockSums> pBlockSums = pTxHashSet->ValidateTxHashSet(m_config, *pHeader, m_blockChainServer);
 	if (pBlockSums == nullptr)
 	{
 		LoggerAPI::LogError(StringUtil::Format("TxHashSetProcessor::ProcessTxHashSet - Validation of %s failed.", path.c_str()));
@@ -57,7 +57,13 @@ bool TxHashSetProcessor::ProcessTxHashSet(const Hash& blockHash, const std::stri
 			std::unique_ptr<BlockHeader> pNextHeader = lockedState.m_blockStore.GetBlockHeaderByHash(pIndex->GetHash());
 			if (pNextHeader != nullptr)
 			{
-				pTxHashSet->SaveOutputPositions(*pNextHeader, firstOutput);
+				if (!pTxHashSet->SaveOutputPositions(*pNextHeader, firstOutput))
+				{
+					LoggerAPI::LogError("TxHashSetProcessor::ProcessTxHashSet - Failed to save output positions for " + pNextHeader->FormatHash());
+					TxHashSetManager::DestroyTxHashSet(pTxHashSet);
+					return false;
+				}
+
 				firstOutput = pNextHeader->GetOutputMMRSize();
 			}
 		}
@@ -17,7 +17,7 @@ BlockHeaderValidator::BlockHeaderValidator(const Config& config, const IBlockDB&
 
 // TODO: Return status enum with error type instead of just true/false
 // TODO: Look up previous header instead of taking it in
-bool BlockHeaderValidator::IsValidHeader(const BlockHeader& header, const BlockHeader& previousHeader) const
+bool BlockHeaderValidator::IsValidHeader(const BlockHeader& header, const BlockHeader& previousHeader, const bool proofVerified, const std::vector<BlockHeader>* pPendingHeaders) const
 {
 	// Validate Height
 	if (header.GetHeight() != (previousHeader.GetHeight() + 1))
@@ -50,7 +50,8 @@ bool BlockHeaderValidator::IsValidHeader(const BlockHeader& header, const BlockH
 	}
 
 	// Validate Proof Of Work
-	const bool validPoW = PoWManager(m_config, m_blockDB).IsPoWValid(header, previousHeader);
+	const PoWManager powManager(m_config, m_blockDB);
+	const bool validPoW = powManager.IsDifficultyValid(header, previousHeader, pPendingHeaders) && (proofVerified || powManager.IsProofValid(header));
 	if (!validPoW)
 	{
 		LoggerAPI::LogWarning("BlockHeaderValidator::IsValidHeader - Invalid Proof of Work for header " + HexUtil::ConvertHash(header.GetHash()));
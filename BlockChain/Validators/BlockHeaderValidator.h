@@ -12,7 +12,11 @@ class BlockHeaderValidator
 public:
 	BlockHeaderValidator(const Config& config, const IBlockDB& blockDB, const IHeaderMMR& headerMMR);
 
-	bool IsValidHeader(const BlockHeader& header, const BlockHeader& previousHeader) const;
+	//
+	// When proofVerified is true, the caller already validated the header's cuckoo cycle with PoWManager::IsProofValid.
+	// pPendingHeaders are validated headers that aren't in the BlockDB yet, which the difficulty window may include.
+	//
+	bool IsValidHeader(const BlockHeader& header, const BlockHeader& previousHeader, const bool proofVerified = false, const std::vector<BlockHeader>* pPendingHeaders = nullptr) const;
 
 	const Config& m_config;
 	const IBlockDB& m_blockDB;
@@ -28,11 +28,11 @@ std::unique_ptr<BlockSums> BlockValidator::ValidateBlock(const FullBlock& block)
 	{
 		if (input.GetFeatures() == EOutputFeatures::COINBASE_OUTPUT)
 		{
-			const std::optional<OutputLocation> outputPosOpt = m_blockDB.GetOutputPosition(input.GetCommitment());
+			const std::optional<OutputLocation> outputPosOpt = m_pTxHashSet->GetOutputPosition(input.GetCommitment());
 			if (!outputPosOpt.has_value() || outputPosOpt.value().GetBlockHeight() > maximumBlockHeight)
 			{
 				LoggerAPI::LogInfo("BlockValidator::ValidateBlock - Coinbase not mature: " + HexUtil::ConvertHash(block.GetHash()));
-				return false;
+				return std::unique_ptr<BlockSums>(nullptr);
 			}
 		}
 	}
@@ -14,6 +14,7 @@ namespace ConfigProps
 
 		static const std::string MIN_PEERS = "MIN_PEERS";
 		static const std::string MAX_PEERS = "MAX_PEERS";
+		static const std::string IO_THREADS = "IO_THREADS";
 	}
 
 	namespace Dandelion
@@ -33,6 +34,30 @@ namespace ConfigProps
 		static const std::string REST_API_PORT = "REST_API_PORT";
 	}
 
+	namespace Node
+	{
+		static const std::string NODE = "NODE";
+
+		static const std::string RANGEPROOF_CACHE_SIZE = "RANGEPROOF_CACHE_SIZE";
+		static const std::string KERNEL_SIGNATURE_CACHE_SIZE = "KERNEL_SIGNATURE_CACHE_SIZE";
+		static const std::string HEADER_CHUNK_SIZE = "HEADER_CHUNK_SIZE";
+		static const std::string RANGEPROOF_BATCH_SIZE = "RANGEPROOF_BATCH_SIZE";
+	}
+
+	namespace Database
+	{
+		static const std::string DATABASE = "DATABASE";
+
+		static const std::string BLOCK_CACHE_SIZE_MB = "BLOCK_CACHE_SIZE_MB";
+		static const std::string BLOOM_FILTER_BITS = "BLOOM_FILTER_BITS";
+		static const std::string WRITE_BUFFER_SIZE_MB = "WRITE_BUFFER_SIZE_MB";
+		static const std::string BLOCK_WRITE_BUFFER_SIZE_MB = "BLOCK_WRITE_BUFFER_SIZE_MB";
+		static const std::string COMPRESS_BLOCKS = "COMPRESS_BLOCKS";
+		static const std::string MAX_WRITE_MB_PER_SEC = "MAX_WRITE_MB_PER_SEC";
+		static const std::string STATS_DUMP_PERIOD_SECS = "STATS_DUMP_PERIOD_SECS";
+		static const std::string HEADER_CACHE_SIZE = "HEADER_CACHE_SIZE";
+	}
+
 	namespace Logger
 	{
 		static const std::string LOGGER = "LOGGER";
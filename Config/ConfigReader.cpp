@@ -5,6 +5,8 @@
 #include <Config/Genesis.h>
 #include <Common/Util/BitUtil.h>
 #include <Common/Util/FileUtil.h>
+#include <Crypto/VerifiedCache.h>
+#include <algorithm>
 #include <filesystem>
 
 Config ConfigReader::ReadConfig(const Json::Value& root, const EEnvironmentType environmentType) const
@@ -30,11 +32,17 @@ Config ConfigReader::ReadConfig(const Json::Value& root, const EEnvironmentType
 	// Read Server Config
 	const ServerConfig serverConfig = ReadServerConfig(root, environmentType);
 
+	// Read Node Config
+	const NodeConfig nodeConfig = ReadNodeConfig(root);
+
+	// Read Database Config
+	const DatabaseConfig databaseConfig = ReadDatabaseConfig(root);
+
 	// Read LogLevel
 	const std::string logLevel = ReadLogLevel(root);
 
 	// TODO: Mempool, mining, and logger settings
-	return Config(clientMode, environment, dataPath, dandelionConfig, p2pConfig, walletConfig, serverConfig, logLevel);
+	return Config(clientMode, environment, dataPath, dandelionConfig, p2pConfig, walletConfig, serverConfig, nodeConfig, databaseConfig, logLevel);
 }
 
 EClientMode ConfigReader::ReadClientMode(const Json::Value& root) const
@@ -93,6 +101,7 @@ P2PConfig ConfigReader::ReadP2P(const Json::Value& root) const
 {
 	int maxPeers = 30;
 	int minPeers = 20;
+	int ioThreads = 4;
 
 	if (root.isMember(ConfigProps::P2P::P2P))
 	{
@@ -107,9 +116,14 @@ P2PConfig ConfigReader::ReadP2P(const Json::Value& root) const
 		{
 			minPeers = p2pRoot.get(ConfigProps::P2P::MIN_PEERS, 20).asInt();
 		}
+
+		if (p2pRoot.isMember(ConfigProps::P2P::IO_THREADS))
+		{
+			ioThreads = (std::max)(p2pRoot.get(ConfigProps::P2P::IO_THREADS, 4).asInt(), 1);
+		}
 	}
 
-	return P2PConfig(maxPeers, minPeers);
+	return P2PConfig(maxPeers, minPeers, ioThreads);
 }
 
 DandelionConfig ConfigReader::ReadDandelion(const Json::Value& root) const
@@ -193,6 +207,100 @@ ServerConfig ConfigReader::ReadServerConfig(const Json::Value& root, const EEnvi
 	return ServerConfig(restAPIPort);
 }
 
+NodeConfig ConfigReader::ReadNodeConfig(const Json::Value& root) const
+{
+	uint32_t rangeProofCacheSize = (uint32_t)VerifiedCache::DEFAULT_CAPACITY;
+	uint32_t kernelSignatureCacheSize = (uint32_t)VerifiedCache::DEFAULT_CAPACITY;
+	uint32_t headerChunkSize = 512;
+	uint32_t rangeProofBatchSize = 1000;
+
+	if (root.isMember(ConfigProps::Node::NODE))
+	{
+		const Json::Value& nodeRoot = root[ConfigProps::Node::NODE];
+
+		if (nodeRoot.isMember(ConfigProps::Node::RANGEPROOF_CACHE_SIZE))
+		{
+			rangeProofCacheSize = nodeRoot.get(ConfigProps::Node::RANGEPROOF_CACHE_SIZE, rangeProofCacheSize).asUInt();
+		}
+
+		if (nodeRoot.isMember(ConfigProps::Node::KERNEL_SIGNATURE_CACHE_SIZE))
+		{
+			kernelSignatureCacheSize = nodeRoot.get(ConfigProps::Node::KERNEL_SIGNATURE_CACHE_SIZE, kernelSignatureCacheSize).asUInt();
+		}
+
+		if (nodeRoot.isMember(ConfigProps::Node::HEADER_CHUNK_SIZE))
+		{
+			headerChunkSize = (std::max)(nodeRoot.get(ConfigProps::Node::HEADER_CHUNK_SIZE, headerChunkSize).asUInt(), 1u);
+		}
+
+		if (nodeRoot.isMember(ConfigProps::Node::RANGEPROOF_BATCH_SIZE))
+		{
+			rangeProofBatchSize = (std::max)(nodeRoot.get(ConfigProps::Node::RANGEPROOF_BATCH_SIZE, rangeProofBatchSize).asUInt(), 1u);
+		}
+	}
+
+	return NodeConfig(rangeProofCacheSize, kernelSignatureCacheSize, headerChunkSize, rangeProofBatchSize);
+}
+
+DatabaseConfig ConfigReader::ReadDatabaseConfig(const Json::Value& root) const
+{
+	uint32_t blockCacheSizeMB = 128;
+	uint32_t bloomFilterBits = 10;
+	uint32_t writeBufferSizeMB = 16;
+	uint32_t blockWriteBufferSizeMB = 64;
+	bool compressBlocks = true;
+	uint32_t maxWriteMBPerSec = 0;
+	uint32_t statsDumpPeriodSecs = 600;
+	uint32_t headerCacheSize = 20000;
+
+	if (root.isMember(ConfigProps::Database::DATABASE))
+	{
+		const Json::Value& databaseRoot = root[ConfigProps::Database::DATABASE];
+
+		if (databaseRoot.isMember(ConfigProps::Database::BLOCK_CACHE_SIZE_MB))
+		{
+			blockCacheSizeMB = databaseRoot.get(ConfigProps::Database::BLOCK_CACHE_SIZE_MB, blockCacheSizeMB).asUInt();
+		}
+
+		if (databaseRoot.isMember(ConfigProps::Database::BLOOM_FILTER_BITS))
+		{
+			bloomFilterBits = databaseRoot.get(ConfigProps::Database::BLOOM_FILTER_BITS, bloomFilterBits).asUInt();
+		}
+
+		if (databaseRoot.isMember(ConfigProps::Database::WRITE_BUFFER_SIZE_MB))
+		{
+			writeBufferSizeMB = databaseRoot.get(ConfigProps::Database::WRITE_BUFFER_SIZE_MB, writeBufferSizeMB).asUInt();
+		}
+
+		if (databaseRoot.isMember(ConfigProps::Database::BLOCK_WRITE_BUFFER_SIZE_MB))
+		{
+			blockWriteBufferSizeMB = databaseRoot.get(ConfigProps::Database::BLOCK_WRITE_BUFFER_SIZE_MB, blockWriteBufferSizeMB).asUInt();
+		}
+
+		if (databaseRoot.isMember(ConfigProps::Database::COMPRESS_BLOCKS))
+		{
+			compressBlocks = databaseRoot.get(ConfigProps::Database::COMPRESS_BLOCKS, compressBlocks).asBool();
+		}
+
+		if (databaseRoot.isMember(ConfigProps::Database::MAX_WRITE_MB_PER_SEC))
+		{
+			maxWriteMBPerSec = databaseRoot.get(ConfigProps::Database::MAX_WRITE_MB_PER_SEC, maxWriteMBPerSec).asUInt();
+		}
+
+		if (databaseRoot.isMember(ConfigProps::Database::STATS_DUMP_PERIOD_SECS))
+		{
+			statsDumpPeriodSecs = databaseRoot.get(ConfigProps::Database::STATS_DUMP_PERIOD_SECS, statsDumpPeriodSecs).asUInt();
+		}
+
+		if (databaseRoot.isMember(ConfigProps::Database::HEADER_CACHE_SIZE))
+		{
+			headerCacheSize = databaseRoot.get(ConfigProps::Database::HEADER_CACHE_SIZE, headerCacheSize).asUInt();
+		}
+	}
+
+	return DatabaseConfig(blockCacheSizeMB, bloomFilterBits, writeBufferSizeMB, blockWriteBufferSizeMB, compressBlocks, maxWriteMBPerSec, statsDumpPeriodSecs, headerCacheSize);
+}
+
 std::string ConfigReader::ReadLogLevel(const Json::Value& root) const
 {
 	if (root.isMember(ConfigProps::Logger::LOGGER))
@@ -16,5 +16,7 @@ private:
 	DandelionConfig ReadDandelion(const Json::Value& root) const;
 	WalletConfig ReadWalletConfig(const Json::Value& root, const EEnvironmentType environmentType, const std::string& dataPath) const;
 	ServerConfig ReadServerConfig(const Json::Value& root, const EEnvironmentType environmentType) const;
+	NodeConfig ReadNodeConfig(const Json::Value& root) const;
+	DatabaseConfig ReadDatabaseConfig(const Json::Value& root) const;
 	std::string ReadLogLevel(const Json::Value& root) const;
 };
\ No newline at end of file
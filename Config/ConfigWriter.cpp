@@ -13,6 +13,8 @@ bool ConfigWriter::SaveConfig(const Config& config, const std::string& configPat
 	WriteP2P(root, config.GetP2PConfig());
 	WriteDandelion(root, config.GetDandelionConfig());
 	WriteServer(root, config.GetServerConfig());
+	WriteNode(root, config.GetNodeConfig());
+	WriteDatabase(root, config.GetDatabaseConfig());
 	WriteLogLevel(root, config.GetLogLevel());
 
 	std::ofstream file(configPath, std::ios::out | std::ios::binary | std::ios::ate);
@@ -72,6 +74,11 @@ void ConfigWriter::WriteP2P(Json::Value& root, const P2PConfig& p2pConfig) const
 	minPeersValue.setComment(minPeersComment, Json::commentBefore);
 	p2pJSON[ConfigProps::P2P::MIN_PEERS] = minPeersValue;
 
+	Json::Value ioThreadsValue = Json::Value(p2pConfig.GetNumIOThreads());
+	const std::string ioThreadsComment = "/* The number of threads used to send and receive on peer connections. Each connection is assigned to one of these threads. */";
+	ioThreadsValue.setComment(ioThreadsComment, Json::commentBefore);
+	p2pJSON[ConfigProps::P2P::IO_THREADS] = ioThreadsValue;
+
 	root[ConfigProps::P2P::P2P] = p2pJSON;
 }
 
@@ -114,6 +121,80 @@ void ConfigWriter::WriteServer(Json::Value& root, const ServerConfig& serverConf
 	root[ConfigProps::Server::SERVER] = serverJSON;
 }
 
+void ConfigWriter::WriteNode(Json::Value& root, const NodeConfig& nodeConfig) const
+{
+	Json::Value nodeJSON;
+
+	Json::Value rangeProofCacheSizeValue = Json::Value(nodeConfig.GetRangeProofCacheSize());
+	const std::string rangeProofCacheSizeComment = "/* Number of verified rangeproofs to remember, so they aren't verified again. */";
+	rangeProofCacheSizeValue.setComment(rangeProofCacheSizeComment, Json::commentBefore);
+	nodeJSON[ConfigProps::Node::RANGEPROOF_CACHE_SIZE] = rangeProofCacheSizeValue;
+
+	Json::Value kernelSignatureCacheSizeValue = Json::Value(nodeConfig.GetKernelSignatureCacheSize());
+	const std::string kernelSignatureCacheSizeComment = "/* Number of verified kernel signatures to remember, so they aren't verified again. */";
+	kernelSignatureCacheSizeValue.setComment(kernelSignatureCacheSizeComment, Json::commentBefore);
+	nodeJSON[ConfigProps::Node::KERNEL_SIGNATURE_CACHE_SIZE] = kernelSignatureCacheSizeValue;
+
+	Json::Value headerChunkSizeValue = Json::Value(nodeConfig.GetHeaderChunkSize());
+	const std::string headerChunkSizeComment = "/* Maximum number of sync headers to validate and commit at a time. */";
+	headerChunkSizeValue.setComment(headerChunkSizeComment, Json::commentBefore);
+	nodeJSON[ConfigProps::Node::HEADER_CHUNK_SIZE] = headerChunkSizeValue;
+
+	Json::Value rangeProofBatchSizeValue = Json::Value(nodeConfig.GetRangeProofBatchSize());
+	const std::string rangeProofBatchSizeComment = "/* Number of rangeproofs verified together when validating a downloaded TxHashSet. */";
+	rangeProofBatchSizeValue.setComment(rangeProofBatchSizeComment, Json::commentBefore);
+	nodeJSON[ConfigProps::Node::RANGEPROOF_BATCH_SIZE] = rangeProofBatchSizeValue;
+
+	root[ConfigProps::Node::NODE] = nodeJSON;
+}
+
+void ConfigWriter::WriteDatabase(Json::Value& root, const DatabaseConfig& databaseConfig) const
+{
+	Json::Value databaseJSON;
+
+	Json::Value blockCacheSizeValue = Json::Value(databaseConfig.GetBlockCacheSizeMB());
+	const std::string blockCacheSizeComment = "/* Size (in MB) of the block cache shared by all column families. */";
+	blockCacheSizeValue.setComment(blockCacheSizeComment, Json::commentBefore);
+	databaseJSON[ConfigProps::Database::BLOCK_CACHE_SIZE_MB] = blockCacheSizeValue;
+
+	Json::Value bloomFilterBitsValue = Json::Value(databaseConfig.GetBloomFilterBitsPerKey());
+	const std::string bloomFilterBitsComment = "/* Bits per key of the bloom filters used for header and output lookups. 0 disables them. */";
+	bloomFilterBitsValue.setComment(bloomFilterBitsComment, Json::commentBefore);
+	databaseJSON[ConfigProps::Database::BLOOM_FILTER_BITS] = bloomFilterBitsValue;
+
+	Json::Value writeBufferSizeValue = Json::Value(databaseConfig.GetWriteBufferSizeMB());
+	const std::string writeBufferSizeComment = "/* Size (in MB) of the write buffers for headers, block sums, output positions, and input bitmaps. */";
+	writeBufferSizeValue.setComment(writeBufferSizeComment, Json::commentBefore);
+	databaseJSON[ConfigProps::Database::WRITE_BUFFER_SIZE_MB] = writeBufferSizeValue;
+
+	Json::Value blockWriteBufferSizeValue = Json::Value(databaseConfig.GetBlockWriteBufferSizeMB());
+	const std::string blockWriteBufferSizeComment = "/* Size (in MB) of the write buffers for full blocks. */";
+	blockWriteBufferSizeValue.setComment(blockWriteBufferSizeComment, Json::commentBefore);
+	databaseJSON[ConfigProps::Database::BLOCK_WRITE_BUFFER_SIZE_MB] = blockWriteBufferSizeValue;
+
+	Json::Value compressBlocksValue = Json::Value(databaseConfig.ShouldCompressBlocks());
+	const std::string compressBlocksComment = "/* Compress full blocks once they've been compacted out of the top levels. */";
+	compressBlocksValue.setComment(compressBlocksComment, Json::commentBefore);
+	databaseJSON[ConfigProps::Database::COMPRESS_BLOCKS] = compressBlocksValue;
+
+	Json::Value maxWriteRateValue = Json::Value(databaseConfig.GetMaxWriteMBPerSec());
+	const std::string maxWriteRateComment = "/* Maximum rate (in MB/s) of flush and compaction writes. 0 means unlimited. */";
+	maxWriteRateValue.setComment(maxWriteRateComment, Json::commentBefore);
+	databaseJSON[ConfigProps::Database::MAX_WRITE_MB_PER_SEC] = maxWriteRateValue;
+
+	Json::Value statsDumpPeriodValue = Json::Value(databaseConfig.GetStatsDumpPeriodSecs());
+	const std::string statsDumpPeriodComment = "/* How often (in seconds) database statistics are logged. 0 disables them. */";
+	statsDumpPeriodValue.setComment(statsDumpPeriodComment, Json::commentBefore);
+	databaseJSON[ConfigProps::Database::STATS_DUMP_PERIOD_SECS] = statsDumpPeriodValue;
+
+	Json::Value headerCacheSizeValue = Json::Value(databaseConfig.GetHeaderCacheSize());
+	const std::string headerCacheSizeComment = "/* Number of deserialized block headers to keep in memory. */";
+	headerCacheSizeValue.setComment(headerCacheSizeComment, Json::commentBefore);
+	databaseJSON[ConfigProps::Database::HEADER_CACHE_SIZE] = headerCacheSizeValue;
+
+	root[ConfigProps::Database::DATABASE] = databaseJSON;
+}
+
 void ConfigWriter::WriteLogLevel(Json::Value& root, const std::string& logLevel) const
 {
 	Json::Value loggerJSON;
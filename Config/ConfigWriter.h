@@ -15,5 +15,7 @@ private:
 	void WriteP2P(Json::Value& root, const P2PConfig& p2pConfig) const;
 	void WriteDandelion(Json::Value& root, const DandelionConfig& dandelionConfig) const;
 	void WriteServer(Json::Value& root, const ServerConfig& serverConfig) const;
+	void WriteNode(Json::Value& root, const NodeConfig& nodeConfig) const;
+	void WriteDatabase(Json::Value& root, const DatabaseConfig& databaseConfig) const;
 	void WriteLogLevel(Json::Value& root, const std::string& logLevel) const;
 };
\ No newline at end of file
@@ -1,9 +1,21 @@
 #include <Core/File.h>
 
 #include <Common/Util/FileUtil.h>
+#include <Infrastructure/Logger.h>
 #include <fstream>
-#include <Windows.h>
 
+#ifdef _WIN32
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+	#include <cerrno>
+	#include <cstring>
+#endif
+
+#ifdef _WIN32
 static bool TruncateFile(const std::string& filePath, const uint64_t size)
 {
 	HANDLE hFile = CreateFile(filePath.c_str(), GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
@@ -25,6 +37,11 @@ File::File(const std::string& path)
 
 }
 
+File::~File()
+{
+
+}
+
 bool File::Load()
 {
 	std::ifstream file(m_path, std::ios::in | std::ifstream::ate | std::ifstream::binary);
@@ -101,32 +118,230 @@ bool File::Flush()
 	return true;
 }
 
-void File::Append(const std::vector<unsigned char>& data)
+const unsigned char* File::GetMappedData() const
 {
-	m_buffer.insert(m_buffer.end(), data.cbegin(), data.cend());
+	return (const unsigned char*)m_mmap.data();
+}
+#else
+File::File(const std::string& path)
+	: m_path(path),
+	m_bufferIndex(0),
+	m_fileSize(0),
+	m_fd(-1),
+	m_pMapped(nullptr),
+	m_mappedSize(0)
+{
+
 }
 
-bool File::Rewind(const uint64_t nextPosition)
+File::~File()
+{
+	Close();
+}
+
+bool File::Open(const bool create)
 {
-	if (!Flush())
+	if (m_fd >= 0)
+	{
+		return true;
+	}
+
+	m_fd = open(m_path.c_str(), create ? (O_RDWR | O_CREAT) : O_RDWR, 0644);
+
+	return m_fd >= 0;
+}
+
+void File::Close()
+{
+	if (m_pMapped != nullptr)
+	{
+		munmap(m_pMapped, m_mappedSize);
+		m_pMapped = nullptr;
+		m_mappedSize = 0;
+	}
+
+	if (m_fd >= 0)
+	{
+		close(m_fd);
+		m_fd = -1;
+	}
+}
+
+// Returns true if the path no longer refers to the open file, because it was deleted or replaced by a rename.
+bool File::IsReplaced() const
+{
+	struct stat pathStat;
+	struct stat fileStat;
+	if (stat(m_path.c_str(), &pathStat) != 0 || fstat(m_fd, &fileStat) != 0)
+	{
+		return true;
+	}
+
+	return pathStat.st_dev != fileStat.st_dev || pathStat.st_ino != fileStat.st_ino;
+}
+
+bool File::Load()
+{
+	// The open descriptor keeps reading the old inode after a rename-replace, so switch to the file now at the path.
+	// A size change on the same inode doesn't need a reopen, since the mapping is resized below.
+	if (m_fd >= 0 && IsReplaced())
+	{
+		Close();
+	}
+
+	if (!Open(false))
 	{
 		return false;
 	}
 
-	if (nextPosition > m_fileSize)
+	struct stat fileStat;
+	if (fstat(m_fd, &fileStat) != 0)
 	{
 		return false;
 	}
 
-	m_bufferIndex = nextPosition;
-	if (nextPosition <= m_bufferIndex)
+	m_fileSize = (uint64_t)fileStat.st_size;
+	m_bufferIndex = m_fileSize;
+
+	return Remap();
+}
+
+bool File::Flush()
+{
+	if (m_fileSize == m_bufferIndex && m_buffer.empty())
 	{
-		m_buffer.clear();
+		return true;
+	}
+
+	if (m_fileSize < m_bufferIndex)
+	{
+		return false;
+	}
+
+	if (!Open(true))
+	{
+		LoggerAPI::LogError("File::Flush - Failed to open " + m_path + ": " + std::string(strerror(errno)));
+		return false;
+	}
+
+	if (m_fileSize > m_bufferIndex)
+	{
+		if (ftruncate(m_fd, (off_t)m_bufferIndex) != 0)
+		{
+			LoggerAPI::LogError("File::Flush - Failed to truncate " + m_path + ": " + std::string(strerror(errno)));
+			return false;
+		}
+	}
+
+	// Only the appended bytes are written. Everything before m_bufferIndex is already on disk.
+	size_t bytesWritten = 0;
+	while (bytesWritten < m_buffer.size())
+	{
+		const ssize_t result = pwrite(m_fd, m_buffer.data() + bytesWritten, m_buffer.size() - bytesWritten, (off_t)(m_bufferIndex + bytesWritten));
+		if (result < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			LoggerAPI::LogError("File::Flush - Failed to write " + m_path + ": " + std::string(strerror(errno)));
+			return false;
+		}
+
+		bytesWritten += (size_t)result;
+	}
+
+	if (fdatasync(m_fd) != 0)
+	{
+		LoggerAPI::LogError("File::Flush - Failed to sync " + m_path + ": " + std::string(strerror(errno)));
+		return false;
+	}
+
+	m_fileSize = m_bufferIndex + m_buffer.size();
+
+	m_bufferIndex = m_fileSize;
+	m_buffer.clear();
+
+	return Remap();
+}
+
+// Resizes the read-only mapping to match the file size, growing or shrinking it in place when possible.
+bool File::Remap()
+{
+	if (m_mappedSize == m_fileSize)
+	{
+		return true;
+	}
+
+	if (m_fileSize == 0)
+	{
+		munmap(m_pMapped, m_mappedSize);
+		m_pMapped = nullptr;
+		m_mappedSize = 0;
+		return true;
+	}
+
+	void* pMapped = MAP_FAILED;
+#ifdef __linux__
+	if (m_pMapped != nullptr)
+	{
+		pMapped = mremap(m_pMapped, m_mappedSize, m_fileSize, MREMAP_MAYMOVE);
+	}
+	else
+	{
+		pMapped = mmap(nullptr, m_fileSize, PROT_READ, MAP_SHARED, m_fd, 0);
+	}
+#else
+	if (m_pMapped != nullptr)
+	{
+		munmap(m_pMapped, m_mappedSize);
+	}
+
+	pMapped = mmap(nullptr, m_fileSize, PROT_READ, MAP_SHARED, m_fd, 0);
+#endif
+
+	if (pMapped == MAP_FAILED)
+	{
+		LoggerAPI::LogError("File::Remap - Failed to map " + m_path + ": " + std::string(strerror(errno)));
+		m_pMapped = nullptr;
+		m_mappedSize = 0;
+		return false;
+	}
+
+	m_pMapped = pMapped;
+	m_mappedSize = m_fileSize;
+
+	return true;
+}
+
+const unsigned char* File::GetMappedData() const
+{
+	return (const unsigned char*)m_pMapped;
+}
+#endif
+
+void File::Append(const std::vector<unsigned char>& data)
+{
+	m_buffer.insert(m_buffer.end(), data.cbegin(), data.cend());
+}
+
+bool File::Rewind(const uint64_t nextPosition)
+{
+	if (nextPosition > GetSize())
+	{
+		return false;
+	}
+
+	if (nextPosition < m_bufferIndex)
+	{
+		// Flushed bytes after nextPosition are ignored by reads, and will be truncated by the next Flush.
 		m_bufferIndex = nextPosition;
+		m_buffer.clear();
 	}
 	else
 	{
-		m_buffer.erase(m_buffer.begin() + nextPosition - m_bufferIndex, m_buffer.end());
+		m_buffer.erase(m_buffer.begin() + (nextPosition - m_bufferIndex), m_buffer.end());
 	}
 
 	return true;
@@ -140,6 +355,21 @@ bool File::Discard()
 	return true;
 }
 
+File::PendingFlush File::GetPendingFlush() const
+{
+	PendingFlush pendingFlush;
+	pendingFlush.position = m_bufferIndex;
+	pendingFlush.flushedSize = m_fileSize;
+	pendingFlush.newSize = m_bufferIndex + m_buffer.size();
+
+	if (m_fileSize > m_bufferIndex)
+	{
+		pendingFlush.overwrittenBytes.assign(GetMappedData() + m_bufferIndex, GetMappedData() + m_fileSize);
+	}
+
+	return pendingFlush;
+}
+
 uint64_t File::GetSize() const
 {
 	return m_bufferIndex + m_buffer.size();
@@ -149,7 +379,7 @@ bool File::Read(const uint64_t position, const uint64_t numBytes, std::vector<un
 {
 	if (position < m_bufferIndex)
 	{
-		data = std::vector<unsigned char>(m_mmap.cbegin() + position, m_mmap.cbegin() + position + numBytes);
+		data = std::vector<unsigned char>(GetMappedData() + position, GetMappedData() + position + numBytes);
 	}
 	else
 	{
@@ -159,4 +389,26 @@ bool File::Read(const uint64_t position, const uint64_t numBytes, std::vector<un
 	}
 
 	return true;
+}
+
+ByteView File::ReadView(const uint64_t position, const uint64_t numBytes) const
+{
+	if (position + numBytes > GetSize())
+	{
+		return ByteView();
+	}
+
+	if (position < m_bufferIndex)
+	{
+		if (position + numBytes > m_bufferIndex)
+		{
+			return ByteView();
+		}
+
+		return ByteView(GetMappedData() + position, numBytes);
+	}
+
+	const uint64_t firstBufferIndex = position - m_bufferIndex;
+
+	return ByteView(m_buffer.data() + firstBufferIndex, numBytes);
 }
\ No newline at end of file
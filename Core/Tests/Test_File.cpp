@@ -0,0 +1,88 @@
+#include <ThirdParty/Catch2/catch.hpp>
+
+#include <Core/File.h>
+#include <filesystem>
+#include <fstream>
+
+TEST_CASE("File - Append, Flush, Rewind, and Reload")
+{
+	const std::string path = std::filesystem::temp_directory_path().string() + "/FileTest.bin";
+	std::filesystem::remove(path);
+
+	{
+		File file(path);
+		REQUIRE_FALSE(file.Load());
+
+		file.Append({ 1, 2, 3, 4 });
+		REQUIRE(file.GetSize() == 4);
+		REQUIRE(file.ReadView(0, 4).ToVector() == std::vector<unsigned char>({ 1, 2, 3, 4 }));
+		REQUIRE(file.Flush());
+		REQUIRE(std::filesystem::file_size(path) == 4);
+
+		// Reads span the mapped file and the pending buffer
+		file.Append({ 5, 6 });
+		REQUIRE(file.ReadView(2, 2).ToVector() == std::vector<unsigned char>({ 3, 4 }));
+		REQUIRE(file.ReadView(4, 2).ToVector() == std::vector<unsigned char>({ 5, 6 }));
+		REQUIRE(file.ReadView(3, 2).empty());
+		REQUIRE(file.ReadView(5, 2).empty());
+		REQUIRE(file.Flush());
+
+		// Growing the mapping
+		std::vector<unsigned char> data;
+		REQUIRE(file.Read(0, 6, data));
+		REQUIRE(data == std::vector<unsigned char>({ 1, 2, 3, 4, 5, 6 }));
+
+		// Shrinking the file
+		REQUIRE(file.Rewind(3));
+		file.Append({ 7 });
+		REQUIRE(file.Flush());
+		REQUIRE(std::filesystem::file_size(path) == 4);
+		REQUIRE(file.ReadView(0, 4).ToVector() == std::vector<unsigned char>({ 1, 2, 3, 7 }));
+
+		// Discarding pending changes
+		file.Append({ 8, 9 });
+		REQUIRE(file.Discard());
+		REQUIRE(file.GetSize() == 4);
+	}
+
+	{
+		File file(path);
+		REQUIRE(file.Load());
+		REQUIRE(file.GetSize() == 4);
+		REQUIRE(file.ReadView(0, 4).ToVector() == std::vector<unsigned char>({ 1, 2, 3, 7 }));
+	}
+
+	std::filesystem::remove(path);
+}
+
+
+#ifndef _WIN32
+TEST_CASE("File - Reload after the file is replaced")
+{
+	const std::string path = std::filesystem::temp_directory_path().string() + "/FileReplaceTest.bin";
+	const std::string replacementPath = path + ".new";
+	std::filesystem::remove(path);
+
+	File file(path);
+	file.Append({ 1, 2, 3, 4 });
+	REQUIRE(file.Flush());
+
+	{
+		std::ofstream replacement(replacementPath, std::ios::out | std::ios::binary | std::ios::trunc);
+		replacement.write("\x09\x08\x07", 3);
+	}
+
+	std::filesystem::rename(replacementPath, path);
+
+	REQUIRE(file.Load());
+	REQUIRE(file.GetSize() == 3);
+	REQUIRE(file.ReadView(0, 3).ToVector() == std::vector<unsigned char>({ 9, 8, 7 }));
+
+	// Flushes go to the replacement, not the old inode.
+	file.Append({ 6 });
+	REQUIRE(file.Flush());
+	REQUIRE(std::filesystem::file_size(path) == 4);
+
+	std::filesystem::remove(path);
+}
+#endif
\ No newline at end of file
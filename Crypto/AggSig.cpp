@@ -3,10 +3,15 @@
 #include "secp256k1-zkp/include/secp256k1_generator.h"
 #include "secp256k1-zkp/include/secp256k1_aggsig.h"
 #include "secp256k1-zkp/include/secp256k1_commitment.h"
+#include "secp256k1-zkp/include/secp256k1_schnorrsig.h"
 #include "Pedersen.h"
 
 #include <Infrastructure/Logger.h>
 #include <Crypto/RandomNumberGenerator.h>
+#include <Crypto/Crypto.h>
+
+// Enough for the multi-scalar multiplication of a few thousand signatures at once. Larger batches are split up by secp256k1.
+const size_t BATCH_SCRATCH_SPACE_SIZE = 16 * 1024 * 1024;
 
 AggSig& AggSig::GetInstance()
 {
@@ -15,6 +20,7 @@ AggSig& AggSig::GetInstance()
 }
 
 AggSig::AggSig()
+	: m_cache(VerifiedCache::DEFAULT_CAPACITY)
 {
 	m_pContext = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
 }
@@ -213,6 +219,12 @@ std::unique_ptr<Signature> AggSig::AggregateSignatures(const std::vector<Signatu
 
 bool AggSig::VerifyAggregateSignature(const Signature& signature, const Commitment& commitment, const Hash& message) const
 {
+	const Hash fingerprint = CalculateFingerprint(signature, commitment, message);
+	if (m_cache.Contains(fingerprint))
+	{
+		return true;
+	}
+
 	std::shared_lock<std::shared_mutex> readLock(m_mutex);
 
 	secp256k1_pedersen_commitment parsedCommitment;
@@ -226,6 +238,7 @@ bool AggSig::VerifyAggregateSignature(const Signature& signature, const Commitme
 			const int verifyResult = secp256k1_aggsig_verify_single(m_pContext, signature.GetSignatureBytes().data(), message.data(), nullptr, &pubkey, &pubkey, nullptr, false);
 			if (verifyResult == 1)
 			{
+				m_cache.Add(fingerprint);
 				return true;
 			}
 		}
@@ -257,6 +270,91 @@ bool AggSig::VerifyAggregateSignature(const Signature& signature, const PublicKe
 	return false;
 }
 
+bool AggSig::VerifyAggregateSignatures(const std::vector<const Signature*>& signatures, const std::vector<const Commitment*>& commitments, const std::vector<const Hash*>& messages) const
+{
+	if (signatures.size() != commitments.size() || signatures.size() != messages.size())
+	{
+		return false;
+	}
+
+	// Skip signatures that were already verified.
+	std::vector<size_t> indices;
+	std::vector<Hash> fingerprints;
+	for (size_t i = 0; i < signatures.size(); i++)
+	{
+		Hash fingerprint = CalculateFingerprint(*signatures[i], *commitments[i], *messages[i]);
+		if (!m_cache.Contains(fingerprint))
+		{
+			indices.push_back(i);
+			fingerprints.emplace_back(std::move(fingerprint));
+		}
+	}
+
+	if (indices.empty())
+	{
+		return true;
+	}
+
+	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+
+	std::vector<secp256k1_schnorrsig> parsedSignatures(indices.size());
+	std::vector<secp256k1_pubkey> pubkeys(indices.size());
+	std::vector<const unsigned char*> messageData(indices.size());
+	for (size_t i = 0; i < indices.size(); i++)
+	{
+		const size_t index = indices[i];
+
+		secp256k1_pedersen_commitment parsedCommitment;
+		if (secp256k1_pedersen_commitment_parse(m_pContext, &parsedCommitment, commitments[index]->GetCommitmentBytes().data()) != 1)
+		{
+			return false;
+		}
+
+		if (secp256k1_pedersen_commitment_to_pubkey(m_pContext, &pubkeys[i], &parsedCommitment) != 1)
+		{
+			return false;
+		}
+
+		memcpy(parsedSignatures[i].data, signatures[index]->GetSignatureBytes().data(), 64);
+		messageData[i] = messages[index]->data();
+	}
+
+	std::vector<const secp256k1_schnorrsig*> signaturePointers;
+	std::vector<const secp256k1_pubkey*> pubkeyPointers;
+	for (size_t i = 0; i < indices.size(); i++)
+	{
+		signaturePointers.push_back(&parsedSignatures[i]);
+		pubkeyPointers.push_back(&pubkeys[i]);
+	}
+
+	secp256k1_scratch_space* pScratchSpace = secp256k1_scratch_space_create(m_pContext, BATCH_SCRATCH_SPACE_SIZE);
+	const int verifyResult = secp256k1_schnorrsig_verify_batch(m_pContext, pScratchSpace, signaturePointers.data(), messageData.data(), pubkeyPointers.data(), indices.size());
+	secp256k1_scratch_space_destroy(pScratchSpace);
+
+	if (verifyResult == 1)
+	{
+		for (const Hash& fingerprint : fingerprints)
+		{
+			m_cache.Add(fingerprint);
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+Hash AggSig::CalculateFingerprint(const Signature& signature, const Commitment& commitment, const Hash& message)
+{
+	std::vector<unsigned char> input;
+	input.reserve(64 + 33 + 32);
+	input.insert(input.end(), signature.GetSignatureBytes().cbegin(), signature.GetSignatureBytes().cend());
+	input.insert(input.end(), commitment.GetCommitmentBytes().cbegin(), commitment.GetCommitmentBytes().cend());
+	input.insert(input.end(), message.cbegin(), message.cend());
+
+	return Crypto::Blake2b(input);
+}
+
 std::vector<secp256k1_ecdsa_signature> AggSig::ParseSignatures(const std::vector<Signature>& signatures) const
 {
 	std::vector<secp256k1_ecdsa_signature> parsed;
@@ -7,6 +7,7 @@
 #include <Crypto/Signature.h>
 #include <Crypto/PublicKey.h>
 #include <Crypto/Hash.h>
+#include <Crypto/VerifiedCache.h>
 #include <vector>
 #include <memory>
 #include <shared_mutex>
@@ -30,14 +31,23 @@ public:
 	std::unique_ptr<Signature> AggregateSignatures(const std::vector<Signature>& signatures, const PublicKey& sumPubNonces) const;
 	bool VerifyAggregateSignature(const Signature& signature, const Commitment& commitment, const Hash& message) const;
 	bool VerifyAggregateSignature(const Signature& signature, const PublicKey& sumPubKeys, const Hash& message) const;
+	bool VerifyAggregateSignatures(const std::vector<const Signature*>& signatures, const std::vector<const Commitment*>& commitments, const std::vector<const Hash*>& messages) const;
+
+	void SetCacheCapacity(const size_t capacity) { m_cache.SetCapacity(capacity); }
+	VerifiedCache::Stats GetCacheStats() const { return m_cache.GetStats(); }
 
 private:
 	AggSig();
 	~AggSig();
 
+	static Hash CalculateFingerprint(const Signature& signature, const Commitment& commitment, const Hash& message);
+
 	std::vector<secp256k1_ecdsa_signature> ParseSignatures(const std::vector<Signature>& signatures) const;
 	std::unique_ptr<Signature> SerializeSignature(const secp256k1_ecdsa_signature& signature) const;
 
 	mutable std::shared_mutex m_mutex;
 	secp256k1_context* m_pContext;
+
+	// Kernel signatures (signature, commitment, and message) that were already verified.
+	mutable VerifiedCache m_cache;
 };
\ No newline at end of file
@@ -0,0 +1,206 @@
+#include "Blake2bMulti.h"
+#include "Blake2.h"
+
+#include <string.h>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define BLAKE2B_MULTI_X64
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define BLAKE2B_AVX2_TARGET
+#else
+#define BLAKE2B_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+#ifdef BLAKE2B_MULTI_X64
+
+static const uint64_t blake2b_multi_IV[8] =
+{
+	0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL,
+	0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+	0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+	0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+static const uint8_t blake2b_multi_sigma[12][16] =
+{
+	{ 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 } ,
+	{ 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 } ,
+	{ 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 } ,
+	{ 7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 } ,
+	{ 9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 } ,
+	{ 2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 } ,
+	{ 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 } ,
+	{ 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 } ,
+	{ 6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 } ,
+	{ 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13 , 0 } ,
+	{ 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 } ,
+	{ 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 }
+};
+
+static int blake2b_multi_has_avx2()
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+	{
+		return 0;
+	}
+
+	// The OS must save the YMM registers (OSXSAVE and AVX, then XCR0 bits 1 and 2).
+	__cpuid(info, 1);
+	if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6)
+	{
+		return 0;
+	}
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#define ROTR32_AVX2(x) _mm256_shuffle_epi32((x), _MM_SHUFFLE(2, 3, 0, 1))
+#define ROTR24_AVX2(x) _mm256_shuffle_epi8((x), r24)
+#define ROTR16_AVX2(x) _mm256_shuffle_epi8((x), r16)
+#define ROTR63_AVX2(x) _mm256_xor_si256(_mm256_srli_epi64((x), 63), _mm256_add_epi64((x), (x)))
+
+#define G_AVX2(r,i,a,b,c,d)                                                          \
+  do {                                                                               \
+    a = _mm256_add_epi64(_mm256_add_epi64(a, b), m[blake2b_multi_sigma[r][2*i+0]]);  \
+    d = ROTR32_AVX2(_mm256_xor_si256(d, a));                                         \
+    c = _mm256_add_epi64(c, d);                                                      \
+    b = ROTR24_AVX2(_mm256_xor_si256(b, c));                                         \
+    a = _mm256_add_epi64(_mm256_add_epi64(a, b), m[blake2b_multi_sigma[r][2*i+1]]);  \
+    d = ROTR16_AVX2(_mm256_xor_si256(d, a));                                         \
+    c = _mm256_add_epi64(c, d);                                                      \
+    b = ROTR63_AVX2(_mm256_xor_si256(b, c));                                         \
+  } while(0)
+
+#define ROUND_AVX2(r)                    \
+  do {                                   \
+    G_AVX2(r,0,v[ 0],v[ 4],v[ 8],v[12]); \
+    G_AVX2(r,1,v[ 1],v[ 5],v[ 9],v[13]); \
+    G_AVX2(r,2,v[ 2],v[ 6],v[10],v[14]); \
+    G_AVX2(r,3,v[ 3],v[ 7],v[11],v[15]); \
+    G_AVX2(r,4,v[ 0],v[ 5],v[10],v[15]); \
+    G_AVX2(r,5,v[ 1],v[ 6],v[11],v[12]); \
+    G_AVX2(r,6,v[ 2],v[ 7],v[ 8],v[13]); \
+    G_AVX2(r,7,v[ 3],v[ 4],v[ 9],v[14]); \
+  } while(0)
+
+//
+// Hashes 4 messages of inlen bytes, one per 64-bit lane.
+// Since the messages have the same length, every lane has the same counter and finalization flag for each block.
+//
+BLAKE2B_AVX2_TARGET
+static void blake2b_256_x4_avx2(uint8_t* out, const uint8_t* in, const size_t inlen)
+{
+	const __m256i r24 = _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10, 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+	const __m256i r16 = _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9, 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+
+	// Parameter block for an unkeyed, 32 byte digest: digest_length = 32, fanout = 1, depth = 1.
+	__m256i h[8];
+	h[0] = _mm256_set1_epi64x((long long)(blake2b_multi_IV[0] ^ 0x01010020ULL));
+	for (size_t i = 1; i < 8; i++)
+	{
+		h[i] = _mm256_set1_epi64x((long long)blake2b_multi_IV[i]);
+	}
+
+	const size_t numBlocks = inlen == 0 ? 1 : (inlen + BLAKE2B_BLOCKBYTES - 1) / BLAKE2B_BLOCKBYTES;
+	for (size_t block = 0; block < numBlocks; block++)
+	{
+		const size_t offset = block * BLAKE2B_BLOCKBYTES;
+		const size_t blockLength = (inlen - offset) < BLAKE2B_BLOCKBYTES ? (inlen - offset) : BLAKE2B_BLOCKBYTES;
+		const int lastBlock = (block + 1 == numBlocks);
+
+		// The last block is zero-padded.
+		uint64_t words[4][16];
+		for (size_t lane = 0; lane < 4; lane++)
+		{
+			memset(words[lane], 0, sizeof(words[lane]));
+			memcpy(words[lane], in + (lane * inlen) + offset, blockLength);
+		}
+
+		__m256i m[16];
+		for (size_t i = 0; i < 16; i++)
+		{
+			m[i] = _mm256_set_epi64x((long long)words[3][i], (long long)words[2][i], (long long)words[1][i], (long long)words[0][i]);
+		}
+
+		const uint64_t counter = offset + blockLength;
+
+		__m256i v[16];
+		for (size_t i = 0; i < 8; i++)
+		{
+			v[i] = h[i];
+			v[i + 8] = _mm256_set1_epi64x((long long)blake2b_multi_IV[i]);
+		}
+
+		v[12] = _mm256_xor_si256(v[12], _mm256_set1_epi64x((long long)counter));
+		if (lastBlock)
+		{
+			v[14] = _mm256_xor_si256(v[14], _mm256_set1_epi64x(-1));
+		}
+
+		ROUND_AVX2(0);
+		ROUND_AVX2(1);
+		ROUND_AVX2(2);
+		ROUND_AVX2(3);
+		ROUND_AVX2(4);
+		ROUND_AVX2(5);
+		ROUND_AVX2(6);
+		ROUND_AVX2(7);
+		ROUND_AVX2(8);
+		ROUND_AVX2(9);
+		ROUND_AVX2(10);
+		ROUND_AVX2(11);
+
+		for (size_t i = 0; i < 8; i++)
+		{
+			h[i] = _mm256_xor_si256(h[i], _mm256_xor_si256(v[i], v[i + 8]));
+		}
+	}
+
+	// The digest is the first 4 words of each lane's state, little-endian.
+	uint64_t digest[4][4];
+	for (size_t i = 0; i < 4; i++)
+	{
+		_mm256_storeu_si256((__m256i*)digest[i], h[i]);
+	}
+
+	for (size_t lane = 0; lane < 4; lane++)
+	{
+		for (size_t i = 0; i < 4; i++)
+		{
+			memcpy(out + (lane * 32) + (i * 8), &digest[i][lane], 8);
+		}
+	}
+}
+
+#endif
+
+void blake2b_256_multi(uint8_t* out, const uint8_t* in, const size_t inlen, const size_t count)
+{
+	size_t hashed = 0;
+
+#ifdef BLAKE2B_MULTI_X64
+	static const int hasAVX2 = blake2b_multi_has_avx2();
+	if (hasAVX2)
+	{
+		for (; hashed + 4 <= count; hashed += 4)
+		{
+			blake2b_256_x4_avx2(out + (hashed * 32), in + (hashed * inlen), inlen);
+		}
+	}
+#endif
+
+	for (; hashed < count; hashed++)
+	{
+		blake2b(out + (hashed * 32), 32, in + (hashed * inlen), inlen, NULL, 0);
+	}
+}
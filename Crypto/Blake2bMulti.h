@@ -0,0 +1,10 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+//
+// Hashes count messages of inlen bytes each, stored back to back in "in", into 32 byte Blake2b hashes stored back to back in "out".
+// On CPUs that support AVX2, 4 messages are hashed at once, one per 64-bit lane. Otherwise, each message is hashed with blake2b.
+//
+void blake2b_256_multi(uint8_t* out, const uint8_t* in, const size_t inlen, const size_t count);
@@ -4,6 +4,8 @@
 
 #include <Common/Util/FunctionalUtil.h>
 #include <Crypto/RandomNumberGenerator.h>
+#include <Crypto/Crypto.h>
+#include <thread>
 
 const uint64_t MAX_WIDTH = 1 << 20;
 const size_t SCRATCH_SPACE_SIZE = 256 * MAX_WIDTH;
@@ -16,6 +18,7 @@ Bulletproofs& Bulletproofs::GetInstance()
 }
 
 Bulletproofs::Bulletproofs()
+	: m_cache(VerifiedCache::DEFAULT_CAPACITY)
 {
 	m_pContext = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
 	m_pGenerators = secp256k1_bulletproof_generators_create(m_pContext, &secp256k1_generator_const_g, MAX_GENERATORS);
@@ -23,10 +26,58 @@ Bulletproofs::Bulletproofs()
 
 Bulletproofs::~Bulletproofs()
 {
+	for (secp256k1_scratch_space* pScratchSpace : m_scratchSpaces)
+	{
+		secp256k1_scratch_space_destroy(pScratchSpace);
+	}
+
 	secp256k1_bulletproof_generators_destroy(m_pContext, m_pGenerators);
 	secp256k1_context_destroy(m_pContext);
 }
 
+secp256k1_scratch_space* Bulletproofs::AcquireScratchSpace() const
+{
+	{
+		std::unique_lock<std::mutex> lock(m_scratchMutex);
+		if (!m_scratchSpaces.empty())
+		{
+			secp256k1_scratch_space* pScratchSpace = m_scratchSpaces.back();
+			m_scratchSpaces.pop_back();
+			return pScratchSpace;
+		}
+	}
+
+	return secp256k1_scratch_space_create(m_pContext, SCRATCH_SPACE_SIZE);
+}
+
+void Bulletproofs::ReleaseScratchSpace(secp256k1_scratch_space* pScratchSpace) const
+{
+	// Keep at most one scratch space per hardware thread. Any extras are freed.
+	const size_t maxScratchSpaces = (std::max)(std::thread::hardware_concurrency(), 1u);
+
+	std::unique_lock<std::mutex> lock(m_scratchMutex);
+	if (m_scratchSpaces.size() < maxScratchSpaces)
+	{
+		m_scratchSpaces.push_back(pScratchSpace);
+	}
+	else
+	{
+		secp256k1_scratch_space_destroy(pScratchSpace);
+	}
+}
+
+Hash Bulletproofs::CalculateFingerprint(const Commitment& commitment, const RangeProof& rangeProof)
+{
+	const std::vector<unsigned char>& proofBytes = rangeProof.GetProofBytes();
+
+	std::vector<unsigned char> input;
+	input.reserve(commitment.GetCommitmentBytes().size() + proofBytes.size());
+	input.insert(input.end(), commitment.GetCommitmentBytes().cbegin(), commitment.GetCommitmentBytes().cend());
+	input.insert(input.end(), proofBytes.cbegin(), proofBytes.cend());
+
+	return Crypto::Blake2b(input);
+}
+
 bool Bulletproofs::VerifyBulletproofs(const std::vector<std::pair<Commitment, RangeProof>>& rangeProofs) const
 {
 	std::shared_lock<std::shared_mutex> readLock(m_mutex);
@@ -37,13 +88,18 @@ bool Bulletproofs::VerifyBulletproofs(const std::vector<std::pair<Commitment, Ra
 	std::vector<Commitment> commitments;
 	commitments.reserve(rangeProofs.size());
 
+	std::vector<Hash> fingerprints;
+	fingerprints.reserve(rangeProofs.size());
+
 	std::vector<const unsigned char*> bulletproofPointers;
 	bulletproofPointers.reserve(rangeProofs.size());
 	for (const std::pair<Commitment, RangeProof>& rangeProof : rangeProofs)
 	{
-		if (!m_cache.WasAlreadyVerified(rangeProof.first))
+		Hash fingerprint = CalculateFingerprint(rangeProof.first, rangeProof.second);
+		if (!m_cache.Contains(fingerprint))
 		{
 			commitments.push_back(rangeProof.first);
+			fingerprints.emplace_back(std::move(fingerprint));
 			bulletproofPointers.emplace_back(rangeProof.second.GetProofBytes().data());
 		}
 	}
@@ -62,17 +118,17 @@ bool Bulletproofs::VerifyBulletproofs(const std::vector<std::pair<Commitment, Ra
 
 	std::vector<secp256k1_pedersen_commitment*> commitmentPointers = Pedersen::ConvertCommitments(*m_pContext, commitments);
 
-	secp256k1_scratch_space* pScratchSpace = secp256k1_scratch_space_create(m_pContext, SCRATCH_SPACE_SIZE);
+	secp256k1_scratch_space* pScratchSpace = AcquireScratchSpace();
 	const int result = secp256k1_bulletproof_rangeproof_verify_multi(m_pContext, pScratchSpace, m_pGenerators, bulletproofPointers.data(), commitments.size(), proofLength, NULL, commitmentPointers.data(), 1, numBits, valueGenerators.data(), NULL, NULL);
-	secp256k1_scratch_space_destroy(pScratchSpace);
+	ReleaseScratchSpace(pScratchSpace);
 
 	Pedersen::CleanupCommitments(commitmentPointers);
 
 	if (result == 1)
 	{
-		for (const Commitment& commitment : commitments)
+		for (const Hash& fingerprint : fingerprints)
 		{
-			m_cache.AddToCache(commitment);
+			m_cache.Add(fingerprint);
 		}
 	}
 
@@ -84,7 +140,7 @@ std::unique_ptr<RangeProof> Bulletproofs::GenerateRangeProof(const uint64_t amou
 	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
 
 	const CBigInteger<32> randomSeed = RandomNumberGenerator::GenerateRandom32();
-	secp256k1_context_randomize(m_pContext, &randomSeed.GetData()[0]);
+	secp256k1_context_randomize(m_pContext, randomSeed.data());
 
 	std::vector<unsigned char> proofBytes(MAX_PROOF_SIZE, 0);
 	size_t proofLen = MAX_PROOF_SIZE;
@@ -113,7 +169,7 @@ std::unique_ptr<RangeProof> Bulletproofs::GenerateRangeProof(const uint64_t amou
 	 * extra_commit_len: length of additional data
 	 *          message: optional 16 bytes of message that can be recovered by rewinding with the correct nonce
 	 */
-	secp256k1_scratch_space* pScratchSpace = secp256k1_scratch_space_create(m_pContext, SCRATCH_SPACE_SIZE);
+	secp256k1_scratch_space* pScratchSpace = AcquireScratchSpace();
 
 	std::vector<const unsigned char*> blindingFactors({ key.data() });
 	int result = secp256k1_bulletproof_rangeproof_prove(
@@ -136,9 +192,9 @@ std::unique_ptr<RangeProof> Bulletproofs::GenerateRangeProof(const uint64_t amou
 		NULL,
 		NULL,
 		0,
-		proofMessage.GetBytes().GetData().data()
+		proofMessage.GetBytes().data()
 	);
-	secp256k1_scratch_space_destroy(pScratchSpace);
+	ReleaseScratchSpace(pScratchSpace);
 
 	if (result == 1)
 	{
@@ -1,16 +1,18 @@
 #pragma once
 
-#include "BulletProofsCache.h"
-
 #include <Crypto/Commitment.h>
 #include <Crypto/RangeProof.h>
 #include <Crypto/BlindingFactor.h>
 #include <Crypto/ProofMessage.h>
 #include <Crypto/RewoundProof.h>
+#include <Crypto/VerifiedCache.h>
 #include <shared_mutex>
+#include <mutex>
+#include <vector>
 
 // Forward Declarations
 typedef struct secp256k1_context_struct secp256k1_context;
+typedef struct secp256k1_scratch_space_struct secp256k1_scratch_space;
 struct secp256k1_bulletproof_generators;
 
 class Bulletproofs
@@ -22,12 +24,24 @@ public:
 	std::unique_ptr<RangeProof> GenerateRangeProof(const uint64_t amount, const SecretKey& key, const SecretKey& nonce, const ProofMessage& proofMessage) const;
 	std::unique_ptr<RewoundProof> RewindProof(const Commitment& commitment, const RangeProof& rangeProof, const SecretKey& nonce) const;
 
+	void SetCacheCapacity(const size_t capacity) { m_cache.SetCapacity(capacity); }
+	VerifiedCache::Stats GetCacheStats() const { return m_cache.GetStats(); }
+
 private:
 	Bulletproofs();
 	~Bulletproofs();
 
+	static Hash CalculateFingerprint(const Commitment& commitment, const RangeProof& rangeProof);
+
+	// Scratch spaces are expensive to create, so they're pooled and reused by concurrent verifications.
+	secp256k1_scratch_space* AcquireScratchSpace() const;
+	void ReleaseScratchSpace(secp256k1_scratch_space* pScratchSpace) const;
+
 	mutable std::shared_mutex m_mutex;
 	secp256k1_context* m_pContext;
 	secp256k1_bulletproof_generators* m_pGenerators;
-	mutable BulletProofsCache m_cache;
+	mutable VerifiedCache m_cache;
+
+	mutable std::mutex m_scratchMutex;
+	mutable std::vector<secp256k1_scratch_space*> m_scratchSpaces;
 };
\ No newline at end of file
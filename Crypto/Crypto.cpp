@@ -3,6 +3,7 @@
 #include <Infrastructure/Logger.h>
 
 #include "Blake2.h"
+#include "Blake2bMulti.h"
 #include "sha256.h"
 #include "ripemd160.h"
 #include "hmac_sha256.h"
@@ -25,56 +26,82 @@
 
 CBigInteger<32> Crypto::Blake2b(const std::vector<unsigned char>& input)
 {
-	std::vector<unsigned char> tmp(32, 0);
+	CBigInteger<32> result;
 
-	blake2b(&tmp[0], 32, &input[0], input.size(), nullptr, 0);
+	blake2b(result.data(), 32, input.data(), input.size(), nullptr, 0);
 
-	return CBigInteger<32>(&tmp[0]);
+	return result;
 }
 
-CBigInteger<32> Crypto::Blake2b(const std::vector<unsigned char>& key, const std::vector<unsigned char>& input)
+CBigInteger<32> Crypto::Blake2b(const std::vector<unsigned char>& key, const SecureVector& input)
 {
-	std::vector<unsigned char> tmp(32, 0);
+	CBigInteger<32> result;
 
-	blake2b(&tmp[0], 32, input.data(), input.size(), key.data(), key.size());
+	blake2b(result.data(), 32, input.data(), input.size(), key.data(), key.size());
 
-	return CBigInteger<32>(&tmp[0]);
+	return result;
+}
+
+std::vector<CBigInteger<32>> Crypto::Blake2bBatch(const std::vector<unsigned char>& messages, const size_t messageLength)
+{
+	const size_t numMessages = messageLength == 0 ? 0 : (messages.size() / messageLength);
+
+	std::vector<unsigned char> hashes(numMessages * 32);
+	blake2b_256_multi(hashes.data(), messages.data(), messageLength, numMessages);
+
+	std::vector<CBigInteger<32>> result;
+	result.reserve(numMessages);
+	for (size_t i = 0; i < numMessages; i++)
+	{
+		result.emplace_back(CBigInteger<32>(&hashes[i * 32]));
+	}
+
+	return result;
 }
 
 CBigInteger<32> Crypto::SHA256(const std::vector<unsigned char>& input)
 {
-	std::vector<unsigned char> sha256(32, 0);
+	CBigInteger<32> sha256;
+
+	CSHA256().Write(input.data(), input.size()).Finalize(sha256.data());
+
+	return sha256;
+}
+
+CBigInteger<32> Crypto::SHA256(const SecureVector& input)
+{
+	CBigInteger<32> sha256;
 
 	CSHA256().Write(input.data(), input.size()).Finalize(sha256.data());
 
-	return CBigInteger<32>(sha256);
+	return sha256;
 }
 
 CBigInteger<20> Crypto::RipeMD160(const std::vector<unsigned char>& input)
 {
-	std::vector<unsigned char> ripemd(32, 0);
+	CBigInteger<20> ripemd;
 
 	CRIPEMD160().Write(input.data(), input.size()).Finalize(ripemd.data());
 
-	return CBigInteger<20>(ripemd);
+	return ripemd;
 }
 
-CBigInteger<32> Crypto::HMAC_SHA256(const std::vector<unsigned char>& key, const std::vector<unsigned char>& data)
+CBigInteger<32> Crypto::HMAC_SHA256(const SecureVector& key, const SecureVector& data)
 {
-	std::vector<unsigned char> result(32);
+	CBigInteger<32> result;
 
 	CHMAC_SHA256(key.data(), key.size()).Write(data.data(), data.size()).Finalize(result.data());
 
-	return CBigInteger<32>(result.data());
+	return result;
 }
 
-CBigInteger<64> Crypto::HMAC_SHA512(const std::vector<unsigned char>& key, const std::vector<unsigned char>& data)
+CBigInteger<64> Crypto::HMAC_SHA512(const SecureVector& key, const SecureVector& data)
 {
-	std::vector<unsigned char> result(64);
+	CBigInteger<64> result;
 
 	CHMAC_SHA512(key.data(), key.size()).Write(data.data(), data.size()).Finalize(result.data());
 
-	return CBigInteger<64>(std::move(result));
+	return result;
 }
 
 std::unique_ptr<Commitment> Crypto::CommitTransparent(const uint64_t value)
@@ -179,7 +206,7 @@ std::vector<unsigned char> Crypto::AES256_Encrypt(const SecureVector& input, con
 	// max ciphertext len for a n bytes of plaintext is n + AES_BLOCKSIZE bytes
 	ciphertext.resize(input.size() + AES_BLOCKSIZE);
 
-	AES256CBCEncrypt enc(key.data(), iv.GetData().data(), true);
+	AES256CBCEncrypt enc(key.data(), iv.data(), true);
 	const size_t nLen = enc.Encrypt(&input[0], input.size(), ciphertext.data());
 	if (nLen < input.size())
 	{
@@ -200,7 +227,7 @@ SecureVector Crypto::AES256_Decrypt(const std::vector<unsigned char>& ciphertext
 
 	plaintext.resize(nLen);
 
-	AES256CBCDecrypt dec(key.data(), iv.GetData().data(), true);
+	AES256CBCDecrypt dec(key.data(), iv.data(), true);
 	nLen = dec.Decrypt(ciphertext.data(), ciphertext.size(), plaintext.data());
 	if (nLen == 0)
 	{
@@ -221,11 +248,11 @@ SecretKey Crypto::PBKDF(const SecureString& password, const std::vector<unsigned
 	SecureVector buffer(64);
 	if (crypto_scrypt((const unsigned char*)password.data(), password.size(), salt.data(), salt.size(), N, r, p, buffer.data(), buffer.size()) == 0)
 	{
-		std::vector<unsigned char> tmp(32, 0);
+		CBigInteger<32> passwordHash;
 
-		blake2b(&tmp[0], 32, &buffer[0], buffer.size(), nullptr, 0);
+		blake2b(passwordHash.data(), 32, buffer.data(), buffer.size(), nullptr, 0);
 
-		return SecretKey(CBigInteger<32>(&tmp[0]));
+		return SecretKey(std::move(passwordHash));
 	}
 
 	throw CryptoException();
@@ -281,6 +308,27 @@ bool Crypto::VerifyKernelSignature(const Signature& signature, const Commitment&
 	return AggSig::GetInstance().VerifyAggregateSignature(signature, publicKey, message);
 }
 
+bool Crypto::VerifyKernelSignatures(const std::vector<const Signature*>& signatures, const std::vector<const Commitment*>& publicKeys, const std::vector<const Hash*>& messages)
+{
+	return AggSig::GetInstance().VerifyAggregateSignatures(signatures, publicKeys, messages);
+}
+
+void Crypto::ConfigureVerifiedCaches(const size_t rangeProofCacheSize, const size_t kernelSignatureCacheSize)
+{
+	Bulletproofs::GetInstance().SetCacheCapacity(rangeProofCacheSize);
+	AggSig::GetInstance().SetCacheCapacity(kernelSignatureCacheSize);
+}
+
+VerifiedCache::Stats Crypto::GetRangeProofCacheStats()
+{
+	return Bulletproofs::GetInstance().GetCacheStats();
+}
+
+VerifiedCache::Stats Crypto::GetKernelSignatureCacheStats()
+{
+	return AggSig::GetInstance().GetCacheStats();
+}
+
 std::unique_ptr<SecretKey> Crypto::GenerateSecureNonce()
 {
 	return AggSig::GetInstance().GenerateSecureNonce();
@@ -27,11 +27,11 @@ std::unique_ptr<SecretKey> ECDH::CalculateSharedSecret(const SecretKey& privateK
 		const int parseResult = secp256k1_ec_pubkey_parse(m_pContext, &pubkey, publicKey.GetCompressedBytes().data(), publicKey.GetCompressedBytes().size());
 		if (parseResult == 1)
 		{
-			SecureVector result;
+			SecureVector result(32);
 			const int ecdhResult = secp256k1_ecdh(m_pContext, result.data(), &pubkey, privateKey.data());
 			if (ecdhResult == 1)
 			{
-				return std::make_unique<SecretKey>(SecretKey(CBigInteger<32>((const std::vector<unsigned char>&)result)));
+				return std::make_unique<SecretKey>(SecretKey(CBigInteger<32>(result.data())));
 			}
 		}
 	}
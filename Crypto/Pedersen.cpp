@@ -78,12 +78,12 @@ std::unique_ptr<BlindingFactor> Pedersen::PedersenBlindSum(const std::vector<Bli
 	std::vector<const unsigned char*> blindingFactors;
 	for (const BlindingFactor& positiveFactor : positive)
 	{
-		blindingFactors.push_back(positiveFactor.GetBytes().GetData().data());
+		blindingFactors.push_back(positiveFactor.GetBytes().data());
 	}
 
 	for (const BlindingFactor& negativeFactor : negative)
 	{
-		blindingFactors.push_back(negativeFactor.GetBytes().GetData().data());
+		blindingFactors.push_back(negativeFactor.GetBytes().data());
 	}
 
 	CBigInteger<32> blindingFactorBytes;
@@ -117,7 +117,7 @@ std::vector<secp256k1_pedersen_commitment*> Pedersen::ConvertCommitments(const s
 	std::vector<secp256k1_pedersen_commitment*> convertedCommitments(commitments.size(), NULL);
 	for (int i = 0; i < commitments.size(); i++)
 	{
-		const std::vector<unsigned char>& commitmentBytes = commitments[i].GetCommitmentBytes().GetData();
+		const CBigInteger<33>& commitmentBytes = commitments[i].GetCommitmentBytes();
 
 		secp256k1_pedersen_commitment* pCommitment = new secp256k1_pedersen_commitment();
 		const int parsed = secp256k1_pedersen_commitment_parse(&context, pCommitment, &commitmentBytes[0]);
@@ -0,0 +1,55 @@
+#include <ThirdParty/Catch2/catch.hpp>
+
+#include <Crypto/BigInteger.h>
+#include <Crypto/Hash.h>
+
+TEST_CASE("CBigInteger - Inline Storage")
+{
+	{
+		const CBigInteger<32> hash = CBigInteger<32>::FromHex("0x0102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F20");
+		REQUIRE(hash.size() == 32);
+		REQUIRE(hash[0] == 0x01);
+		REQUIRE(hash[31] == 0x20);
+		REQUIRE(hash.ToHex() == "0102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20");
+
+		const std::vector<unsigned char> data = hash.GetData();
+		REQUIRE(data.size() == 32);
+		REQUIRE(CBigInteger<32>(data) == hash);
+		REQUIRE(CBigInteger<32>(hash.data()) == hash);
+	}
+
+	// Vectors must hold exactly NUM_BYTES
+	{
+		const std::vector<unsigned char> longer(40, 0xFF);
+		REQUIRE_THROWS_AS(CBigInteger<32>(longer), std::invalid_argument);
+
+		const std::vector<unsigned char> shorter(4, 0xFF);
+		REQUIRE_THROWS_AS(CBigInteger<8>(shorter), std::invalid_argument);
+
+		const SecureVector secure = CBigInteger<32>::GetMaximumValue().GetSecureData();
+		REQUIRE(secure.size() == 32);
+		REQUIRE(CBigInteger<32>(secure) == CBigInteger<32>::GetMaximumValue());
+	}
+
+	// Comparisons are big-endian
+	{
+		REQUIRE(CBigInteger<32>::ValueOf(1) < CBigInteger<32>::ValueOf(2));
+		REQUIRE(CBigInteger<32>::ValueOf(2) > CBigInteger<32>::ValueOf(1));
+		REQUIRE(CBigInteger<32>::ValueOf(3) != CBigInteger<32>::ValueOf(4));
+		REQUIRE(ZERO_HASH == Hash());
+	}
+
+	// Arithmetic
+	{
+		REQUIRE(CBigInteger<32>::ValueOf(200) + CBigInteger<32>::ValueOf(100) == CBigInteger<32>::FromHex("0x000000000000000000000000000000000000000000000000000000000000012C"));
+		REQUIRE(CBigInteger<32>::ValueOf(200) - CBigInteger<32>::ValueOf(100) == CBigInteger<32>::ValueOf(100));
+		REQUIRE(CBigInteger<32>::ValueOf(200) / 2 == CBigInteger<32>::ValueOf(100));
+	}
+
+	// erase() wipes the inline bytes
+	{
+		CBigInteger<32> secret = CBigInteger<32>::GetMaximumValue();
+		secret.erase();
+		REQUIRE(secret == CBigInteger<32>::ValueOf(0));
+	}
+}
@@ -0,0 +1,35 @@
+#include <ThirdParty/Catch2/catch.hpp>
+
+#include <Crypto/Crypto.h>
+
+TEST_CASE("Crypto::Blake2bBatch")
+{
+	// Covers empty, single block, exactly one block, and multi-block messages,
+	// with message counts that aren't a multiple of the 4 lanes hashed at once.
+	const std::vector<size_t> messageLengths = { 0, 1, 72, 128, 129, 300 };
+	for (const size_t messageLength : messageLengths)
+	{
+		for (size_t numMessages = 0; numMessages <= 9; numMessages++)
+		{
+			std::vector<unsigned char> messages(numMessages * messageLength);
+			for (size_t i = 0; i < messages.size(); i++)
+			{
+				messages[i] = (unsigned char)((i * 31) + messageLength);
+			}
+
+			const std::vector<CBigInteger<32>> hashes = Crypto::Blake2bBatch(messages, messageLength);
+			if (messageLength == 0)
+			{
+				REQUIRE(hashes.empty());
+				continue;
+			}
+
+			REQUIRE(hashes.size() == numMessages);
+			for (size_t i = 0; i < numMessages; i++)
+			{
+				const std::vector<unsigned char> message(messages.cbegin() + (i * messageLength), messages.cbegin() + ((i + 1) * messageLength));
+				REQUIRE(hashes[i] == Crypto::Blake2b(message));
+			}
+		}
+	}
+}
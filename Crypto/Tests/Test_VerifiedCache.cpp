@@ -0,0 +1,42 @@
+#include <ThirdParty/Catch2/catch.hpp>
+
+#include <Crypto/VerifiedCache.h>
+#include <Crypto/Crypto.h>
+#include <Core/Serialization/Serializer.h>
+
+static Hash CreateFingerprint(const uint64_t value)
+{
+	Serializer serializer;
+	serializer.Append<uint64_t>(value);
+
+	return Crypto::Blake2b(serializer.GetBytes());
+}
+
+TEST_CASE("VerifiedCache")
+{
+	VerifiedCache cache(32);
+
+	REQUIRE_FALSE(cache.Contains(CreateFingerprint(1)));
+	cache.Add(CreateFingerprint(1));
+	REQUIRE(cache.Contains(CreateFingerprint(1)));
+	REQUIRE_FALSE(cache.Contains(CreateFingerprint(2)));
+
+	VerifiedCache::Stats stats = cache.GetStats();
+	REQUIRE(stats.hits == 1);
+	REQUIRE(stats.misses == 2);
+
+	// Oldest entries are evicted once full
+	for (uint64_t i = 0; i < 10000; i++)
+	{
+		cache.Add(CreateFingerprint(i + 100));
+	}
+
+	REQUIRE_FALSE(cache.Contains(CreateFingerprint(1)));
+	REQUIRE(cache.Contains(CreateFingerprint(10099)));
+
+	// A capacity of 0 disables the cache
+	cache.SetCapacity(0);
+	REQUIRE_FALSE(cache.Contains(CreateFingerprint(10099)));
+	cache.Add(CreateFingerprint(3));
+	REQUIRE_FALSE(cache.Contains(CreateFingerprint(3)));
+}
@@ -6,31 +6,148 @@
 #include <utility>
 #include <string>
 #include <filesystem>
-
-static ColumnFamilyDescriptor BLOCK_COLUMN = ColumnFamilyDescriptor("BLOCK", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
-static ColumnFamilyDescriptor HEADER_COLUMN = ColumnFamilyDescriptor("HEADER", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
-static ColumnFamilyDescriptor BLOCK_SUMS_COLUMN = ColumnFamilyDescriptor("BLOCK_SUMS", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
-static ColumnFamilyDescriptor OUTPUT_POS_COLUMN = ColumnFamilyDescriptor("OUTPUT_POS", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
-static ColumnFamilyDescriptor INPUT_BITMAP_COLUMN = ColumnFamilyDescriptor("INPUT_BITMAP", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
+#include <algorithm>
+#include <stdexcept>
+#include <rocksdb/convenience.h>
 
 std::string kDBPath = "/tmp/rocksdb_simple_example";
 
+static const uint64_t MB = 1024 * 1024;
+
+// Returns the first of the preferred compression types that RocksDB was built with, or kNoCompression if none were.
+static CompressionType SelectCompression(const std::vector<CompressionType>& preferredTypes)
+{
+	const std::vector<CompressionType> supportedTypes = GetSupportedCompressions();
+	for (const CompressionType compressionType : preferredTypes)
+	{
+		if (std::find(supportedTypes.cbegin(), supportedTypes.cend(), compressionType) != supportedTypes.cend())
+		{
+			return compressionType;
+		}
+	}
+
+	return kNoCompression;
+}
+
+// The node can't run without its database, so failing to open it is fatal.
+static void VerifyStatus(const Status& status, const std::string& action)
+{
+	if (!status.ok())
+	{
+		const std::string message = "BlockDB::OpenDB - Failed to " + action + ": " + status.ToString();
+		LoggerAPI::LogError(message);
+		throw std::runtime_error(message);
+	}
+}
+
 BlockDB::BlockDB(const Config& config)
-	: m_config(config)
+	: m_config(config), m_batchThreadId(std::thread::id()), m_headerCache(config.GetDatabaseConfig().GetHeaderCacheSize())
 {
 
 }
 
+// HEADER, BLOCK_SUMS, OUTPUT_POS, and INPUT_BITMAP are small values looked up by hash or commitment.
+// Whole-key bloom filters let lookups for missing keys (ie. new outputs) skip reading data blocks entirely.
+ColumnFamilyOptions BlockDB::CreatePointLookupOptions() const
+{
+	const DatabaseConfig& databaseConfig = m_config.GetDatabaseConfig();
+
+	BlockBasedTableOptions tableOptions;
+	tableOptions.block_cache = m_pBlockCache;
+	tableOptions.cache_index_and_filter_blocks = true;
+	tableOptions.pin_l0_filter_and_index_blocks_in_cache = true;
+	tableOptions.data_block_index_type = BlockBasedTableOptions::kDataBlockBinaryAndHash;
+	if (databaseConfig.GetBloomFilterBitsPerKey() > 0)
+	{
+		tableOptions.filter_policy.reset(NewBloomFilterPolicy(databaseConfig.GetBloomFilterBitsPerKey(), false));
+	}
+
+	ColumnFamilyOptions options;
+	options.table_factory.reset(NewBlockBasedTableFactory(tableOptions));
+	options.write_buffer_size = databaseConfig.GetWriteBufferSizeMB() * MB;
+	options.memtable_whole_key_filtering = databaseConfig.GetBloomFilterBitsPerKey() > 0;
+	options.memtable_prefix_bloom_size_ratio = databaseConfig.GetBloomFilterBitsPerKey() > 0 ? 0.02 : 0.0;
+	options.compression = kNoCompression;
+
+	return options;
+}
+
+// BLOCK holds large values that are written once, in order, and rarely read again except to serve peers.
+// They're left uncompressed in the top levels, where they don't stay for long, and compressed below that.
+ColumnFamilyOptions BlockDB::CreateBlockOptions() const
+{
+	const DatabaseConfig& databaseConfig = m_config.GetDatabaseConfig();
+
+	BlockBasedTableOptions tableOptions;
+	tableOptions.block_cache = m_pBlockCache;
+	tableOptions.block_size = 64 * 1024;
+
+	ColumnFamilyOptions options;
+	options.table_factory.reset(NewBlockBasedTableFactory(tableOptions));
+	options.write_buffer_size = databaseConfig.GetBlockWriteBufferSizeMB() * MB;
+	options.target_file_size_base = databaseConfig.GetBlockWriteBufferSizeMB() * MB;
+	options.max_bytes_for_level_base = 4 * databaseConfig.GetBlockWriteBufferSizeMB() * MB;
+	if (databaseConfig.ShouldCompressBlocks())
+	{
+		// LZ4 and ZSTD are only available if RocksDB was built with them, so fall back to Snappy, or to no compression.
+		const CompressionType compression = SelectCompression({ kLZ4Compression, kSnappyCompression });
+		const CompressionType bottommostCompression = SelectCompression({ kZSTD, kLZ4Compression, kSnappyCompression });
+		if (compression != kLZ4Compression || bottommostCompression != kZSTD)
+		{
+			LoggerAPI::LogWarning("BlockDB::CreateBlockOptions - RocksDB was built without LZ4 or ZSTD. Falling back to supported compression types.");
+		}
+
+		options.compression_per_level = std::vector<CompressionType>({
+			kNoCompression,
+			kNoCompression,
+			compression,
+			compression,
+			compression,
+			compression,
+			bottommostCompression
+		});
+		options.bottommost_compression = bottommostCompression;
+	}
+	else
+	{
+		options.compression = kNoCompression;
+	}
+
+	return options;
+}
+
 void BlockDB::OpenDB()
 {
+	const DatabaseConfig& databaseConfig = m_config.GetDatabaseConfig();
+
+	// One cache is shared by every column family, so its size bounds the memory used for reads.
+	m_pBlockCache = NewLRUCache(databaseConfig.GetBlockCacheSizeMB() * MB);
+
 	Options options;
 	// Optimize RocksDB. This is the easiest way to get RocksDB to perform well
 	options.IncreaseParallelism();
-	//options.OptimizeLevelStyleCompaction();
 	// create the DB if it's not already present
 	options.create_if_missing = true;
 	options.compression = kNoCompression;
 
+	if (databaseConfig.GetMaxWriteMBPerSec() > 0)
+	{
+		options.rate_limiter.reset(NewGenericRateLimiter(databaseConfig.GetMaxWriteMBPerSec() * MB));
+	}
+
+	if (databaseConfig.GetStatsDumpPeriodSecs() > 0)
+	{
+		m_pStatistics = CreateDBStatistics();
+		options.statistics = m_pStatistics;
+		options.stats_dump_period_sec = databaseConfig.GetStatsDumpPeriodSecs();
+	}
+
+	const ColumnFamilyDescriptor blockColumn("BLOCK", CreateBlockOptions());
+	const ColumnFamilyDescriptor headerColumn("HEADER", CreatePointLookupOptions());
+	const ColumnFamilyDescriptor blockSumsColumn("BLOCK_SUMS", CreatePointLookupOptions());
+	const ColumnFamilyDescriptor outputPosColumn("OUTPUT_POS", CreatePointLookupOptions());
+	const ColumnFamilyDescriptor inputBitmapColumn("INPUT_BITMAP", CreatePointLookupOptions());
+
 	// open DB
 	const std::string dbPath = m_config.GetDatabaseDirectory() + "CHAIN/";
 	std::filesystem::create_directories(dbPath);
@@ -43,32 +160,32 @@ void BlockDB::OpenDB()
 	{
 		std::vector<ColumnFamilyDescriptor> columnDescriptors({ ColumnFamilyDescriptor() });
 		std::vector<ColumnFamilyHandle*> columnHandles;
-		Status s = DB::Open(options, dbPath, columnDescriptors, &columnHandles, &m_pDatabase);
+		VerifyStatus(DB::Open(options, dbPath, columnDescriptors, &columnHandles, &m_pDatabase), "open database");
 
 		m_pDefaultHandle = columnHandles[0];
-		m_pDatabase->CreateColumnFamily(BLOCK_COLUMN.options, BLOCK_COLUMN.name, &m_pBlockHandle);
-		m_pDatabase->CreateColumnFamily(HEADER_COLUMN.options, HEADER_COLUMN.name, &m_pHeaderHandle);
-		m_pDatabase->CreateColumnFamily(BLOCK_SUMS_COLUMN.options, BLOCK_SUMS_COLUMN.name, &m_pBlockSumsHandle);
-		m_pDatabase->CreateColumnFamily(OUTPUT_POS_COLUMN.options, OUTPUT_POS_COLUMN.name, &m_pOutputPosHandle);
-		m_pDatabase->CreateColumnFamily(INPUT_BITMAP_COLUMN.options, INPUT_BITMAP_COLUMN.name, &m_pInputBitmapHandle);
+		VerifyStatus(m_pDatabase->CreateColumnFamily(blockColumn.options, blockColumn.name, &m_pBlockHandle), "create BLOCK column family");
+		VerifyStatus(m_pDatabase->CreateColumnFamily(headerColumn.options, headerColumn.name, &m_pHeaderHandle), "create HEADER column family");
+		VerifyStatus(m_pDatabase->CreateColumnFamily(blockSumsColumn.options, blockSumsColumn.name, &m_pBlockSumsHandle), "create BLOCK_SUMS column family");
+		VerifyStatus(m_pDatabase->CreateColumnFamily(outputPosColumn.options, outputPosColumn.name, &m_pOutputPosHandle), "create OUTPUT_POS column family");
+		VerifyStatus(m_pDatabase->CreateColumnFamily(inputBitmapColumn.options, inputBitmapColumn.name, &m_pInputBitmapHandle), "create INPUT_BITMAP column family");
 	}
 	else if (columnFamilies.size() == 5)
 	{
-		std::vector<ColumnFamilyDescriptor> columnDescriptors({ ColumnFamilyDescriptor(), BLOCK_COLUMN, HEADER_COLUMN, BLOCK_SUMS_COLUMN, OUTPUT_POS_COLUMN });
+		std::vector<ColumnFamilyDescriptor> columnDescriptors({ ColumnFamilyDescriptor(), blockColumn, headerColumn, blockSumsColumn, outputPosColumn });
 		std::vector<ColumnFamilyHandle*> columnHandles;
-		Status s = DB::Open(options, dbPath, columnDescriptors, &columnHandles, &m_pDatabase);
+		VerifyStatus(DB::Open(options, dbPath, columnDescriptors, &columnHandles, &m_pDatabase), "open database");
 		m_pDefaultHandle = columnHandles[0];
 		m_pBlockHandle = columnHandles[1];
 		m_pHeaderHandle = columnHandles[2];
 		m_pBlockSumsHandle = columnHandles[3];
 		m_pOutputPosHandle = columnHandles[4];
-		m_pDatabase->CreateColumnFamily(INPUT_BITMAP_COLUMN.options, INPUT_BITMAP_COLUMN.name, &m_pInputBitmapHandle);
+		VerifyStatus(m_pDatabase->CreateColumnFamily(inputBitmapColumn.options, inputBitmapColumn.name, &m_pInputBitmapHandle), "create INPUT_BITMAP column family");
 	}
 	else
 	{
-		std::vector<ColumnFamilyDescriptor> columnDescriptors({ ColumnFamilyDescriptor(), BLOCK_COLUMN, HEADER_COLUMN, BLOCK_SUMS_COLUMN, OUTPUT_POS_COLUMN, INPUT_BITMAP_COLUMN });
+		std::vector<ColumnFamilyDescriptor> columnDescriptors({ ColumnFamilyDescriptor(), blockColumn, headerColumn, blockSumsColumn, outputPosColumn, inputBitmapColumn });
 		std::vector<ColumnFamilyHandle*> columnHandles;
-		Status s = DB::Open(options, dbPath, columnDescriptors, &columnHandles, &m_pDatabase);
+		VerifyStatus(DB::Open(options, dbPath, columnDescriptors, &columnHandles, &m_pDatabase), "open database");
 		m_pDefaultHandle = columnHandles[0];
 		m_pBlockHandle = columnHandles[1];
 		m_pHeaderHandle = columnHandles[2];
@@ -80,11 +197,20 @@ void BlockDB::OpenDB()
 
 void BlockDB::CloseDB()
 {
+	if (m_pStatistics != nullptr)
+	{
+		LoggerAPI::LogInfo("BlockDB::CloseDB - Statistics: " + m_pStatistics->ToString());
+	}
+
+	const HeaderCache::Stats headerCacheStats = m_headerCache.GetStats();
+	LoggerAPI::LogInfo("BlockDB::CloseDB - Header cache hits: " + std::to_string(headerCacheStats.hits) + ", misses: " + std::to_string(headerCacheStats.misses));
+
 	delete m_pDefaultHandle;
 	delete m_pBlockHandle;
 	delete m_pHeaderHandle;
 	delete m_pBlockSumsHandle;
 	delete m_pOutputPosHandle;
+	delete m_pInputBitmapHandle;
 	delete m_pDatabase;
 }
 
@@ -92,20 +218,56 @@ std::vector<BlockHeader*> BlockDB::LoadBlockHeaders(const std::vector<Hash>& has
 {
 	LoggerAPI::LogTrace("BlockDB::LoadBlockHeaders - Loading headers - " + std::to_string(hashes.size()));
 
+	std::vector<std::shared_ptr<const BlockHeader>> headersFound(hashes.size());
+
+	// Only read the headers that aren't cached, and read them all at once.
+	std::vector<size_t> missingIndices;
+	std::vector<Slice> missingKeys;
+	for (size_t i = 0; i < hashes.size(); i++)
+	{
+		headersFound[i] = m_headerCache.Get(hashes[i]);
+		if (headersFound[i] == nullptr)
+		{
+			missingIndices.push_back(i);
+			missingKeys.emplace_back(Slice((const char*)hashes[i].data(), hashes[i].size()));
+		}
+	}
+
+	if (!missingKeys.empty())
+	{
+		std::vector<std::string> values(missingKeys.size());
+		std::vector<Status> statuses(missingKeys.size());
+		if (IsBatching())
+		{
+			// MultiGet can't see the current batch's writes.
+			for (size_t i = 0; i < missingKeys.size(); i++)
+			{
+				statuses[i] = Get(m_pHeaderHandle, missingKeys[i], &values[i]);
+			}
+		}
+		else
+		{
+			const std::vector<ColumnFamilyHandle*> handles(missingKeys.size(), m_pHeaderHandle);
+			statuses = m_pDatabase->MultiGet(ReadOptions(), handles, missingKeys, &values);
+		}
+
+		for (size_t i = 0; i < missingKeys.size(); i++)
+		{
+			if (statuses[i].ok())
+			{
+				headersFound[missingIndices[i]] = DeserializeHeader(values[i]);
+			}
+		}
+	}
+
 	std::vector<BlockHeader*> blockHeaders;
 	blockHeaders.reserve(hashes.size());
 
-	for (const Hash& hash : hashes)
+	for (const std::shared_ptr<const BlockHeader>& pHeader : headersFound)
 	{
-		const Slice key((const char*)&hash[0], hash.GetData().size());
-		std::string value;
-		Status s = m_pDatabase->Get(ReadOptions(), m_pHeaderHandle, key, &value);
-		if (s.ok())
+		if (pHeader != nullptr)
 		{
-			std::vector<unsigned char> data(value.data(), value.data() + value.size());
-			ByteBuffer byteBuffer(data);
-			BlockHeader* pBlockHeader = new BlockHeader(BlockHeader::Deserialize(byteBuffer));
-			blockHeaders.push_back(pBlockHeader);
+			blockHeaders.push_back(new BlockHeader(*pHeader));
 		}
 	}
 
@@ -115,16 +277,36 @@ std::vector<BlockHeader*> BlockDB::LoadBlockHeaders(const std::vector<Hash>& has
 
 std::unique_ptr<BlockHeader> BlockDB::GetBlockHeader(const Hash& hash) const
 {
+	std::shared_ptr<const BlockHeader> pCachedHeader = m_headerCache.Get(hash);
+	if (pCachedHeader != nullptr)
+	{
+		return std::make_unique<BlockHeader>(*pCachedHeader);
+	}
+
 	std::unique_ptr<BlockHeader> pHeader = std::unique_ptr<BlockHeader>(nullptr);
 
 	Slice key((const char*)&hash[0], 32);
 	std::string value;
-	Status s = m_pDatabase->Get(ReadOptions(), m_pHeaderHandle, key, &value);
+	Status s = Get(m_pHeaderHandle, key, &value);
 	if (s.ok())
 	{
-		std::vector<unsigned char> data(value.data(), value.data() + value.size());
-		ByteBuffer byteBuffer(data);
-		pHeader = std::make_unique<BlockHeader>(BlockHeader::Deserialize(byteBuffer));
+		std::shared_ptr<const BlockHeader> pDeserializedHeader = DeserializeHeader(value);
+		pHeader = std::make_unique<BlockHeader>(*pDeserializedHeader);
+	}
+
+	return pHeader;
+}
+
+std::shared_ptr<const BlockHeader> BlockDB::DeserializeHeader(const std::string& value) const
+{
+	std::vector<unsigned char> data(value.data(), value.data() + value.size());
+	ByteBuffer byteBuffer(data);
+	std::shared_ptr<const BlockHeader> pHeader = std::make_shared<const BlockHeader>(BlockHeader::Deserialize(byteBuffer));
+
+	// Headers read while batching may only exist in the batch, which could still be rolled back.
+	if (!IsBatching())
+	{
+		m_headerCache.Put(pHeader);
 	}
 
 	return pHeader;
@@ -139,13 +321,18 @@ void BlockDB::AddBlockHeader(const BlockHeader& blockHeader)
 
 	Slice key((const char*)&hash[0], hash.size());
 	Slice value((const char*)&serializer.GetBytes()[0], serializer.GetBytes().size());
-	m_pDatabase->Put(WriteOptions(), m_pHeaderHandle, Slice(key), value);
+	if (Put(m_pHeaderHandle, key, value).ok() && !IsBatching())
+	{
+		m_headerCache.Put(std::make_shared<const BlockHeader>(blockHeader));
+	}
 }
 
 void BlockDB::AddBlockHeaders(const std::vector<BlockHeader>& blockHeaders)
 {
 	LoggerAPI::LogTrace("BlockDB::AddBlockHeaders - Adding headers - " + std::to_string(blockHeaders.size()));
 
+	// Write all of the headers at once, unless they're already part of a batch.
+	WriteBatch headerBatch;
 	for (const BlockHeader& blockHeader : blockHeaders)
 	{
 		const std::vector<unsigned char>& hash = blockHeader.GetHash().GetData();
@@ -155,7 +342,23 @@ void BlockDB::AddBlockHeaders(const std::vector<BlockHeader>& blockHeaders)
 
 		Slice key((const char*)&hash[0], hash.size());
 		Slice value((const char*)&serializer.GetBytes()[0], serializer.GetBytes().size());
-		m_pDatabase->Put(WriteOptions(), m_pHeaderHandle, key, value);
+		if (IsBatching())
+		{
+			Put(m_pHeaderHandle, key, value);
+		}
+		else
+		{
+			headerBatch.Put(m_pHeaderHandle, key, value);
+		}
+	}
+
+	if (headerBatch.Count() > 0 && m_pDatabase->Write(WriteOptions(), &headerBatch).ok())
+	{
+		// Sync almost always reads the headers it just added (ie. for the difficulty window of the next batch).
+		for (const BlockHeader& blockHeader : blockHeaders)
+		{
+			m_headerCache.Put(std::make_shared<const BlockHeader>(blockHeader));
+		}
 	}
 
 	LoggerAPI::LogTrace("BlockDB::AddBlockHeaders - Finished adding headers.");
@@ -170,7 +373,7 @@ void BlockDB::AddBlock(const FullBlock& block)
 
 	Slice key((const char*)&hash[0], hash.size());
 	Slice value((const char*)&serializer.GetBytes()[0], serializer.GetBytes().size());
-	m_pDatabase->Put(WriteOptions(), m_pBlockHandle, Slice(key), value);
+	Put(m_pBlockHandle, key, value);
 }
 
 std::unique_ptr<FullBlock> BlockDB::GetBlock(const Hash& hash) const
@@ -179,7 +382,7 @@ std::unique_ptr<FullBlock> BlockDB::GetBlock(const Hash& hash) const
 
 	Slice key((const char*)&hash[0], 32);
 	std::string value;
-	Status s = m_pDatabase->Get(ReadOptions(), m_pBlockHandle, key, &value);
+	Status s = Get(m_pBlockHandle, key, &value);
 	if (s.ok())
 	{
 		std::vector<unsigned char> data(value.data(), value.data() + value.size());
@@ -202,7 +405,7 @@ void BlockDB::AddBlockSums(const Hash& blockHash, const BlockSums& blockSums)
 	Slice value((const char*)&serializer.GetBytes()[0], serializer.GetBytes().size());
 
 	// Insert BlockSums object
-	m_pDatabase->Put(WriteOptions(), m_pBlockSumsHandle, key, value);
+	Put(m_pBlockSumsHandle, key, value);
 }
 
 std::unique_ptr<BlockSums> BlockDB::GetBlockSums(const Hash& blockHash) const
@@ -212,7 +415,7 @@ std::unique_ptr<BlockSums> BlockDB::GetBlockSums(const Hash& blockHash) const
 	// Read from DB
 	Slice key((const char*)&blockHash[0], 32);
 	std::string value;
-	const Status s = m_pDatabase->Get(ReadOptions(), m_pBlockSumsHandle, key, &value);
+	const Status s = Get(m_pBlockSumsHandle, key, &value);
 	if (s.ok())
 	{
 		// Deserialize result
@@ -237,7 +440,7 @@ void BlockDB::AddOutputPosition(const Commitment& outputCommitment, const Output
 	Slice value((const char*)&serializer.GetBytes()[0], serializer.GetBytes().size());
 
 	// Insert the output position
-	m_pDatabase->Put(WriteOptions(), m_pOutputPosHandle, key, value);
+	Put(m_pOutputPosHandle, key, value);
 }
 
 std::optional<OutputLocation> BlockDB::GetOutputPosition(const Commitment& outputCommitment) const
@@ -248,7 +451,7 @@ std::optional<OutputLocation> BlockDB::GetOutputPosition(const Commitment& outpu
 
 	// Read from DB
 	std::string value;
-	const Status s = m_pDatabase->Get(ReadOptions(), m_pOutputPosHandle, key, &value);
+	const Status s = Get(m_pOutputPosHandle, key, &value);
 	if (s.ok())
 	{
 		// Deserialize result
@@ -272,7 +475,7 @@ void BlockDB::AddBlockInputBitmap(const Hash& blockHash, const Roaring& bitmap)
 	Slice value(serializedBitmap.data(), bitmapSize);
 
 	// Insert the output position
-	m_pDatabase->Put(WriteOptions(), m_pInputBitmapHandle, key, value);
+	Put(m_pInputBitmapHandle, key, value);
 }
 
 std::optional<Roaring> BlockDB::GetBlockInputBitmap(const Hash& blockHash) const
@@ -283,7 +486,7 @@ std::optional<Roaring> BlockDB::GetBlockInputBitmap(const Hash& blockHash) const
 
 	// Read from DB
 	std::string value;
-	const Status s = m_pDatabase->Get(ReadOptions(), m_pInputBitmapHandle, key, &value);
+	const Status s = Get(m_pInputBitmapHandle, key, &value);
 	if (s.ok())
 	{
 		// Deserialize result
@@ -291,4 +494,68 @@ std::optional<Roaring> BlockDB::GetBlockInputBitmap(const Hash& blockHash) const
 	}
 
 	return blockInputBitmap;
+}
+
+void BlockDB::BeginBatch()
+{
+	// Allocated before locking, so a bad_alloc can't leave the mutex locked.
+	std::unique_ptr<WriteBatchWithIndex> pBatch = std::make_unique<WriteBatchWithIndex>();
+
+	m_batchMutex.lock();
+	m_pBatch = std::move(pBatch);
+	m_batchThreadId = std::this_thread::get_id();
+}
+
+bool BlockDB::CommitBatch()
+{
+	if (!IsBatching())
+	{
+		LoggerAPI::LogError("BlockDB::CommitBatch - No batch was started by this thread.");
+		return false;
+	}
+
+	const Status status = m_pDatabase->Write(WriteOptions(), m_pBatch->GetWriteBatch());
+	if (!status.ok())
+	{
+		LoggerAPI::LogError("BlockDB::CommitBatch - Failed to write batch: " + status.ToString());
+	}
+
+	EndBatch();
+	return status.ok();
+}
+
+void BlockDB::RollbackBatch()
+{
+	if (IsBatching())
+	{
+		EndBatch();
+	}
+}
+
+void BlockDB::EndBatch()
+{
+	m_pBatch.reset();
+	m_batchThreadId = std::thread::id();
+	m_batchMutex.unlock();
+}
+
+Status BlockDB::Put(ColumnFamilyHandle* pHandle, const Slice& key, const Slice& value)
+{
+	if (IsBatching())
+	{
+		m_pBatch->Put(pHandle, key, value);
+		return Status::OK();
+	}
+
+	return m_pDatabase->Put(WriteOptions(), pHandle, key, value);
+}
+
+Status BlockDB::Get(ColumnFamilyHandle* pHandle, const Slice& key, std::string* pValue) const
+{
+	if (IsBatching())
+	{
+		return m_pBatch->GetFromBatchAndDB(m_pDatabase, ReadOptions(), pHandle, key, pValue);
+	}
+
+	return m_pDatabase->Get(ReadOptions(), pHandle, key, pValue);
 }
\ No newline at end of file
@@ -3,11 +3,22 @@
 #include <rocksdb/db.h>
 #include <rocksdb/slice.h>
 #include <rocksdb/options.h>
+#include <rocksdb/table.h>
+#include <rocksdb/filter_policy.h>
+#include <rocksdb/cache.h>
+#include <rocksdb/rate_limiter.h>
+#include <rocksdb/statistics.h>
+#include <rocksdb/utilities/write_batch_with_index.h>
+
+#include "HeaderCache.h"
 
 #include <Database/BlockDb.h>
 #include <Config/Config.h>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <set>
+#include <thread>
 
 using namespace rocksdb;
 
@@ -38,10 +49,29 @@ public:
 	virtual void AddBlockInputBitmap(const Hash& blockHash, const Roaring& bitmap) override final;
 	virtual std::optional<Roaring> GetBlockInputBitmap(const Hash& blockHash) const override final;
 
+	virtual void BeginBatch() override final;
+	virtual bool CommitBatch() override final;
+	virtual void RollbackBatch() override final;
+
 private:
+	ColumnFamilyOptions CreatePointLookupOptions() const;
+	ColumnFamilyOptions CreateBlockOptions() const;
+
+	// Deserializes a header read from the HEADER column, and caches it.
+	std::shared_ptr<const BlockHeader> DeserializeHeader(const std::string& value) const;
+
+	bool IsBatching() const { return m_batchThreadId == std::this_thread::get_id(); }
+	void EndBatch();
+
+	// Writes to the current batch when called from the batching thread. Otherwise, writes directly to the DB.
+	Status Put(ColumnFamilyHandle* pHandle, const Slice& key, const Slice& value);
+	Status Get(ColumnFamilyHandle* pHandle, const Slice& key, std::string* pValue) const;
+
 	const Config& m_config;
 
 	DB* m_pDatabase;
+	std::shared_ptr<Cache> m_pBlockCache;
+	std::shared_ptr<Statistics> m_pStatistics;
 
 	ColumnFamilyHandle* m_pDefaultHandle;
 	ColumnFamilyHandle* m_pBlockHandle;
@@ -49,4 +79,11 @@ private:
 	ColumnFamilyHandle* m_pBlockSumsHandle;
 	ColumnFamilyHandle* m_pOutputPosHandle;
 	ColumnFamilyHandle* m_pInputBitmapHandle;
+
+	// Held from BeginBatch until CommitBatch or RollbackBatch, so only one thread batches at a time.
+	std::mutex m_batchMutex;
+	std::atomic<std::thread::id> m_batchThreadId;
+	std::unique_ptr<WriteBatchWithIndex> m_pBatch;
+
+	HeaderCache m_headerCache;
 };
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Core/Models/BlockHeader.h>
+#include <lru/cache.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+//
+// Size-bounded cache of deserialized headers, shared by every reader of the BlockDB.
+// Headers are immutable and keyed by their own hash, so a cached header never goes stale.
+// The only thing that can change is whether the header is in the DB, so only headers read from or written directly to the DB are cached.
+//
+class HeaderCache
+{
+public:
+	struct Stats
+	{
+		uint64_t hits;
+		uint64_t misses;
+	};
+
+	HeaderCache(const size_t capacity)
+		: m_cache(capacity), m_enabled(capacity > 0), m_hits(0), m_misses(0)
+	{
+
+	}
+
+	std::shared_ptr<const BlockHeader> Get(const Hash& hash) const
+	{
+		if (m_enabled)
+		{
+			std::lock_guard<std::mutex> lockGuard(m_mutex);
+
+			auto iter = m_cache.find(hash);
+			if (iter != m_cache.end())
+			{
+				++m_hits;
+				return iter->second;
+			}
+		}
+
+		++m_misses;
+		return std::shared_ptr<const BlockHeader>(nullptr);
+	}
+
+	void Put(const std::shared_ptr<const BlockHeader>& pHeader) const
+	{
+		if (m_enabled)
+		{
+			std::lock_guard<std::mutex> lockGuard(m_mutex);
+			m_cache.insert(pHeader->GetHash(), pHeader);
+		}
+	}
+
+	Stats GetStats() const { return Stats{ m_hits.load(), m_misses.load() }; }
+
+private:
+	mutable std::mutex m_mutex;
+	mutable LRU::Cache<Hash, std::shared_ptr<const BlockHeader>> m_cache;
+	bool m_enabled;
+
+	mutable std::atomic<uint64_t> m_hits;
+	mutable std::atomic<uint64_t> m_misses;
+};
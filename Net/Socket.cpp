@@ -1,8 +1,21 @@
 #include <Net/Socket.h>
 #include <Net/SocketException.h>
+#include <algorithm>
 
+#ifdef _WIN32
 #define _WINSOCK_DEPRECATED_NO_WARNINGS
 #include <WinSock2.h>
+#define poll WSAPoll
+#else
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/ioctl.h>
+#include <sys/time.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#define closesocket close
+#endif
 
 Socket::Socket(const SOCKET& socket, const SocketAddress& address, const bool blocking, const unsigned long receiveTimeout, const unsigned long sendTimeout)
 	: m_socket(socket), m_address(address), m_blocking(blocking), m_receiveTimeout(receiveTimeout), m_sendTimeout(sendTimeout), m_receiveBufferSize(0)
@@ -19,7 +32,12 @@ bool Socket::SetReceiveTimeout(const unsigned long milliseconds)
 {
 	if (m_receiveTimeout != milliseconds)
 	{
+#ifdef _WIN32
 		const int result = setsockopt(m_socket, SOL_SOCKET, SO_RCVTIMEO, (char*)&milliseconds, sizeof(milliseconds));
+#else
+		const timeval timeout = { (time_t)(milliseconds / 1000), (suseconds_t)((milliseconds % 1000) * 1000) };
+		const int result = setsockopt(m_socket, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeout, sizeof(timeout));
+#endif
 		if (result == 0)
 		{
 			m_receiveTimeout = milliseconds;
@@ -48,7 +66,12 @@ bool Socket::SetSendTimeout(const unsigned long milliseconds)
 {
 	if (m_sendTimeout != milliseconds)
 	{
+#ifdef _WIN32
 		const int result = setsockopt(m_socket, SOL_SOCKET, SO_SNDTIMEO, (char*)&milliseconds, sizeof(milliseconds));
+#else
+		const timeval timeout = { (time_t)(milliseconds / 1000), (suseconds_t)((milliseconds % 1000) * 1000) };
+		const int result = setsockopt(m_socket, SOL_SOCKET, SO_SNDTIMEO, (const char*)&timeout, sizeof(timeout));
+#endif
 		if (result == 0)
 		{
 			m_sendTimeout = milliseconds;
@@ -62,8 +85,13 @@ bool Socket::SetBlocking(const bool blocking)
 {
 	if (m_blocking != blocking)
 	{
+#ifdef _WIN32
 		unsigned long blockingValue = (blocking ? 0 : 1);
 		const int result = ioctlsocket(m_socket, FIONBIO, &blockingValue);
+#else
+		int blockingValue = (blocking ? 0 : 1);
+		const int result = ioctl(m_socket, FIONBIO, &blockingValue);
+#endif
 		if (result == 0)
 		{
 			m_blocking = blocking;
@@ -90,6 +118,114 @@ bool Socket::Send(const std::vector<unsigned char>& message)
 	return true;
 }
 
+// Limits the number of buffers per call to what every platform accepts (IOV_MAX is at least 1024 on linux).
+static const size_t MAX_BUFFERS = 1024;
+
+//
+// Makes a single vectored send call, starting bufferOffset bytes into buffers[bufferIndex].
+// When not blocking, a full send buffer isn't an error, and just results in 0 bytes sent.
+// On windows, the socket's own blocking mode is used.
+//
+static bool SendBuffers(const SOCKET socket, const std::vector<ByteView>& buffers, const size_t bufferIndex, const size_t bufferOffset, const bool blocking, size_t& bytesSent)
+{
+	const size_t numBuffers = (std::min)(buffers.size() - bufferIndex, MAX_BUFFERS);
+
+#ifdef _WIN32
+	std::vector<WSABUF> wsaBuffers(numBuffers);
+	for (size_t i = 0; i < numBuffers; i++)
+	{
+		const size_t offset = (i == 0) ? bufferOffset : 0;
+		wsaBuffers[i].buf = (char*)buffers[bufferIndex + i].data() + offset;
+		wsaBuffers[i].len = (ULONG)(buffers[bufferIndex + i].size() - offset);
+	}
+
+	DWORD bytesSentDWORD = 0;
+	if (WSASend(socket, wsaBuffers.data(), (DWORD)numBuffers, &bytesSentDWORD, 0, NULL, NULL) != 0)
+	{
+		bytesSent = 0;
+		return !blocking && WSAGetLastError() == WSAEWOULDBLOCK;
+	}
+
+	bytesSent = bytesSentDWORD;
+	return true;
+#else
+	std::vector<iovec> ioVectors(numBuffers);
+	for (size_t i = 0; i < numBuffers; i++)
+	{
+		const size_t offset = (i == 0) ? bufferOffset : 0;
+		ioVectors[i].iov_base = (void*)(buffers[bufferIndex + i].data() + offset);
+		ioVectors[i].iov_len = buffers[bufferIndex + i].size() - offset;
+	}
+
+	msghdr message = {};
+	message.msg_iov = ioVectors.data();
+	message.msg_iovlen = numBuffers;
+
+	const ssize_t result = sendmsg(socket, &message, MSG_NOSIGNAL | (blocking ? 0 : MSG_DONTWAIT));
+	if (result < 0)
+	{
+		bytesSent = 0;
+		return !blocking && (errno == EAGAIN || errno == EWOULDBLOCK);
+	}
+
+	bytesSent = (size_t)result;
+	return true;
+#endif
+}
+
+bool Socket::SendVectored(const std::vector<ByteView>& buffers)
+{
+	size_t bufferIndex = 0;
+	size_t bufferOffset = 0;
+	while (true)
+	{
+		while (bufferIndex < buffers.size() && buffers[bufferIndex].size() == bufferOffset)
+		{
+			bufferIndex++;
+			bufferOffset = 0;
+		}
+
+		if (bufferIndex == buffers.size())
+		{
+			break;
+		}
+
+		size_t bytesSent = 0;
+		if (!SendBuffers(m_socket, buffers, bufferIndex, bufferOffset, true, bytesSent) || bytesSent == 0)
+		{
+			return false;
+		}
+
+		// Skip past every buffer that was fully sent, and remember how far into the next one the send got.
+		while (bytesSent > 0 && bufferIndex < buffers.size())
+		{
+			const size_t remaining = buffers[bufferIndex].size() - bufferOffset;
+			if (bytesSent < remaining)
+			{
+				bufferOffset += bytesSent;
+				break;
+			}
+
+			bytesSent -= remaining;
+			bufferIndex++;
+			bufferOffset = 0;
+		}
+	}
+
+	return true;
+}
+
+bool Socket::TrySendVectored(const std::vector<ByteView>& buffers, size_t& bytesSent)
+{
+	bytesSent = 0;
+	if (buffers.empty())
+	{
+		return true;
+	}
+
+	return SendBuffers(m_socket, buffers, 0, 0, false, bytesSent);
+}
+
 bool Socket::Receive(const size_t numBytes, std::vector<unsigned char>& data) const
 {
 	if (data.size() < numBytes)
@@ -112,17 +248,41 @@ bool Socket::Receive(const size_t numBytes, std::vector<unsigned char>& data) co
 	return true;
 }
 
-bool Socket::HasReceivedData(const long timeoutMillis) const
+size_t Socket::ReceiveSome(unsigned char* pData, const size_t maxBytes) const
 {
-	fd_set readFDS;
-	readFDS.fd_count = 1;
-	readFDS.fd_array[0] = m_socket;
+	const int bytesReceived = recv(m_socket, (char*)pData, (int)maxBytes, 0);
+	if (bytesReceived <= 0)
+	{
+		return 0;
+	}
 
-	timeval timeout;
-	timeout.tv_sec = 0;
-	timeout.tv_usec = timeoutMillis * 1000;
+	return (size_t)bytesReceived;
+}
+
+size_t Socket::GetNumBytesAvailable() const
+{
+#ifdef _WIN32
+	unsigned long numBytes = 0;
+	if (ioctlsocket(m_socket, FIONREAD, &numBytes) != 0)
+#else
+	int numBytes = 0;
+	if (ioctl(m_socket, FIONREAD, &numBytes) != 0)
+#endif
+	{
+		throw SocketException();
+	}
+
+	return (size_t)numBytes;
+}
+
+bool Socket::HasReceivedData(const long timeoutMillis) const
+{
+	pollfd pollFD;
+	pollFD.fd = m_socket;
+	pollFD.events = POLLRDNORM;
+	pollFD.revents = 0;
 
-	const int result = select(0, &readFDS, nullptr, nullptr, &timeout);
+	const int result = poll(&pollFD, 1, (int)timeoutMillis);
 	if (result > 0)
 	{
 		return true;
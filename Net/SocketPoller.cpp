@@ -0,0 +1,172 @@
+#include "SocketPoller.h"
+
+#include <algorithm>
+#include <thread>
+#include <chrono>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <WinSock2.h>
+#define poll WSAPoll
+#else
+#include <poll.h>
+#endif
+
+#ifdef __linux__
+static const int MAX_EVENTS = 256;
+
+SocketPoller::SocketPoller()
+{
+	m_epollFD = epoll_create1(EPOLL_CLOEXEC);
+	m_wakeFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	epoll_event wakeEvent = {};
+	wakeEvent.events = EPOLLIN;
+	wakeEvent.data.fd = m_wakeFD;
+	epoll_ctl(m_epollFD, EPOLL_CTL_ADD, m_wakeFD, &wakeEvent);
+}
+
+SocketPoller::~SocketPoller()
+{
+	close(m_wakeFD);
+	close(m_epollFD);
+}
+
+bool SocketPoller::Add(const SOCKET socket)
+{
+	epoll_event event = {};
+	event.events = EPOLLIN | EPOLLRDHUP;
+	event.data.fd = socket;
+
+	return epoll_ctl(m_epollFD, EPOLL_CTL_ADD, socket, &event) == 0;
+}
+
+bool SocketPoller::Remove(const SOCKET socket)
+{
+	epoll_event event = {};
+	return epoll_ctl(m_epollFD, EPOLL_CTL_DEL, socket, &event) == 0;
+}
+
+bool SocketPoller::SetInterest(const SOCKET socket, const bool readInterest, const bool writeInterest)
+{
+	epoll_event event = {};
+	event.events = (readInterest ? (EPOLLIN | EPOLLRDHUP) : 0) | (writeInterest ? EPOLLOUT : 0);
+	event.data.fd = socket;
+
+	return epoll_ctl(m_epollFD, EPOLL_CTL_MOD, socket, &event) == 0;
+}
+
+void SocketPoller::Wait(const long timeoutMillis, std::vector<Event>& events)
+{
+	events.clear();
+
+	epoll_event readyEvents[MAX_EVENTS];
+	const int numReady = epoll_wait(m_epollFD, readyEvents, MAX_EVENTS, (int)timeoutMillis);
+	for (int i = 0; i < numReady; i++)
+	{
+		if (readyEvents[i].data.fd == m_wakeFD)
+		{
+			uint64_t value = 0;
+			while (read(m_wakeFD, &value, sizeof(value)) > 0) { }
+			continue;
+		}
+
+		const uint32_t flags = readyEvents[i].events;
+		const bool readable = (flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0;
+		const bool writable = (flags & EPOLLOUT) != 0;
+		events.push_back(Event{ readyEvents[i].data.fd, readable, writable });
+	}
+}
+
+void SocketPoller::Wake()
+{
+	const uint64_t value = 1;
+	const ssize_t result = write(m_wakeFD, &value, sizeof(value));
+	(void)result;
+}
+#else
+//
+// Without a portable way to interrupt poll, Wait is capped at a short interval so changes requested by other threads are applied promptly.
+//
+static const long MAX_WAIT_MILLIS = 10;
+
+SocketPoller::SocketPoller()
+{
+
+}
+
+SocketPoller::~SocketPoller()
+{
+
+}
+
+bool SocketPoller::Add(const SOCKET socket)
+{
+	m_entries.push_back(Entry{ socket, true, false });
+	return true;
+}
+
+bool SocketPoller::Remove(const SOCKET socket)
+{
+	auto iter = std::find_if(m_entries.begin(), m_entries.end(), [socket](const Entry& entry) { return entry.socket == socket; });
+	if (iter == m_entries.end())
+	{
+		return false;
+	}
+
+	m_entries.erase(iter);
+	return true;
+}
+
+bool SocketPoller::SetInterest(const SOCKET socket, const bool readInterest, const bool writeInterest)
+{
+	auto iter = std::find_if(m_entries.begin(), m_entries.end(), [socket](const Entry& entry) { return entry.socket == socket; });
+	if (iter == m_entries.end())
+	{
+		return false;
+	}
+
+	iter->readInterest = readInterest;
+	iter->writeInterest = writeInterest;
+	return true;
+}
+
+void SocketPoller::Wait(const long timeoutMillis, std::vector<Event>& events)
+{
+	events.clear();
+
+	const long waitMillis = (std::min)(timeoutMillis, MAX_WAIT_MILLIS);
+	if (m_entries.empty())
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(waitMillis));
+		return;
+	}
+
+	std::vector<pollfd> pollFDs(m_entries.size());
+	for (size_t i = 0; i < m_entries.size(); i++)
+	{
+		pollFDs[i].fd = m_entries[i].socket;
+		pollFDs[i].events = (m_entries[i].readInterest ? POLLRDNORM : 0) | (m_entries[i].writeInterest ? POLLWRNORM : 0);
+		pollFDs[i].revents = 0;
+	}
+
+	const int numReady = poll(pollFDs.data(), (unsigned long)pollFDs.size(), (int)waitMillis);
+	for (size_t i = 0; numReady > 0 && i < pollFDs.size(); i++)
+	{
+		const bool readable = (pollFDs[i].revents & (POLLRDNORM | POLLHUP | POLLERR)) != 0;
+		const bool writable = (pollFDs[i].revents & POLLWRNORM) != 0;
+		if (readable || writable)
+		{
+			events.push_back(Event{ pollFDs[i].fd, readable, writable });
+		}
+	}
+}
+
+void SocketPoller::Wake()
+{
+
+}
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Net/Socket.h>
+#include <vector>
+#include <stdint.h>
+
+//
+// Thin wrapper around the OS readiness API (epoll on linux, poll/WSAPoll elsewhere).
+// Add, Remove, SetInterest, and Wait must only be called from the thread that owns the poller.
+// Wake may be called from any thread, and causes a blocked Wait to return early.
+//
+class SocketPoller
+{
+public:
+	struct Event
+	{
+		SOCKET socket;
+		bool readable;
+		bool writable;
+	};
+
+	SocketPoller();
+	~SocketPoller();
+
+	//
+	// Sockets are added with read interest only.
+	//
+	bool Add(const SOCKET socket);
+	bool Remove(const SOCKET socket);
+	bool SetInterest(const SOCKET socket, const bool readInterest, const bool writeInterest);
+
+	//
+	// Waits up to timeoutMillis for at least one socket to become ready, and replaces the contents of events with the ready sockets.
+	// Errors and hangups are reported as readable, so the owner finds out about them when it next receives.
+	//
+	void Wait(const long timeoutMillis, std::vector<Event>& events);
+	void Wake();
+
+private:
+#ifdef __linux__
+	int m_epollFD;
+	int m_wakeFD;
+#else
+	struct Entry
+	{
+		SOCKET socket;
+		bool readInterest;
+		bool writeInterest;
+	};
+
+	std::vector<Entry> m_entries;
+#endif
+};
@@ -0,0 +1,332 @@
+#include <Net/SocketReactor.h>
+
+#include "SocketPoller.h"
+
+#include <algorithm>
+
+static const long WAIT_MILLIS = 1000;
+
+SocketReactor::IOThread::IOThread()
+	: pPoller(std::make_unique<SocketPoller>())
+{
+
+}
+
+SocketReactor::IOThread::~IOThread() = default;
+
+SocketReactor::SocketReactor(const size_t numThreads)
+	: m_terminate(true), m_nextThread(0)
+{
+	for (size_t i = 0; i < (std::max)(numThreads, (size_t)1); i++)
+	{
+		m_ioThreads.emplace_back(std::make_unique<IOThread>());
+	}
+}
+
+SocketReactor::~SocketReactor()
+{
+	Stop();
+}
+
+void SocketReactor::Start()
+{
+	if (!m_terminate)
+	{
+		return;
+	}
+
+	m_terminate = false;
+	for (std::unique_ptr<IOThread>& pIOThread : m_ioThreads)
+	{
+		pIOThread->thread = std::thread(Thread_IO, std::ref(*this), std::ref(*pIOThread));
+	}
+}
+
+void SocketReactor::Stop()
+{
+	if (m_terminate)
+	{
+		return;
+	}
+
+	m_terminate = true;
+	for (std::unique_ptr<IOThread>& pIOThread : m_ioThreads)
+	{
+		pIOThread->pPoller->Wake();
+		if (pIOThread->thread.joinable())
+		{
+			pIOThread->thread.join();
+		}
+	}
+
+	// The I/O threads are stopped, so anything still registered can be removed directly.
+	for (std::unique_ptr<IOThread>& pIOThread : m_ioThreads)
+	{
+		ApplyPendingChanges(*pIOThread);
+
+		while (!pIOThread->registrations.empty())
+		{
+			RemoveHandler(*pIOThread, pIOThread->registrations.begin()->first);
+		}
+	}
+}
+
+void SocketReactor::Add(const SOCKET socket, IHandler& handler)
+{
+	std::unique_lock<std::mutex> assignmentLock(m_assignmentMutex);
+	const size_t threadIndex = m_nextThread++ % m_ioThreads.size();
+	m_assignments[&handler] = threadIndex;
+	assignmentLock.unlock();
+
+	IOThread& ioThread = *m_ioThreads[threadIndex];
+	std::unique_lock<std::mutex> lockGuard(ioThread.mutex);
+	ioThread.pendingAdds.emplace_back(std::make_pair(socket, &handler));
+	lockGuard.unlock();
+
+	ioThread.pPoller->Wake();
+}
+
+void SocketReactor::RequestWrite(IHandler& handler)
+{
+	IOThread* pIOThread = GetIOThread(handler);
+	if (pIOThread == nullptr)
+	{
+		return;
+	}
+
+	std::unique_lock<std::mutex> lockGuard(pIOThread->mutex);
+	pIOThread->pendingWrites.push_back(&handler);
+	lockGuard.unlock();
+
+	pIOThread->pPoller->Wake();
+}
+
+void SocketReactor::SetReadInterest(IHandler& handler, const bool readInterest)
+{
+	IOThread* pIOThread = GetIOThread(handler);
+	if (pIOThread == nullptr)
+	{
+		return;
+	}
+
+	std::unique_lock<std::mutex> lockGuard(pIOThread->mutex);
+	pIOThread->pendingReadInterest.emplace_back(std::make_pair(&handler, readInterest));
+	lockGuard.unlock();
+
+	pIOThread->pPoller->Wake();
+}
+
+void SocketReactor::SetSuspended(IHandler& handler, const bool suspended)
+{
+	IOThread* pIOThread = GetIOThread(handler);
+	if (pIOThread == nullptr)
+	{
+		return;
+	}
+
+	std::unique_lock<std::mutex> lockGuard(pIOThread->mutex);
+	pIOThread->pendingSuspensions.emplace_back(std::make_pair(&handler, suspended));
+	lockGuard.unlock();
+
+	pIOThread->pPoller->Wake();
+}
+
+bool SocketReactor::Remove(IHandler& handler)
+{
+	IOThread* pIOThread = GetIOThread(handler);
+	if (pIOThread == nullptr)
+	{
+		return false;
+	}
+
+	IOThread& ioThread = *pIOThread;
+
+	// The handler's own I/O thread can't wait on itself, and stopped I/O threads won't apply the removal, so remove it directly.
+	if (m_terminate || std::this_thread::get_id() == ioThread.thread.get_id())
+	{
+		ApplyPendingChanges(ioThread);
+		return RemoveHandler(ioThread, &handler);
+	}
+
+	std::unique_lock<std::mutex> lockGuard(ioThread.mutex);
+	ioThread.pendingRemoves.insert(&handler);
+	ioThread.pPoller->Wake();
+
+	ioThread.removedCondition.wait(lockGuard, [&ioThread, &handler] { return ioThread.completedRemoves.count(&handler) > 0; });
+
+	// False if one of the handler's callbacks already removed it before the removal was applied.
+	const bool removed = ioThread.completedRemoves[&handler];
+	ioThread.completedRemoves.erase(&handler);
+
+	return removed;
+}
+
+void SocketReactor::Thread_IO(SocketReactor& reactor, IOThread& ioThread)
+{
+	std::vector<SocketPoller::Event> events;
+
+	while (!reactor.m_terminate)
+	{
+		reactor.ApplyPendingChanges(ioThread);
+
+		ioThread.pPoller->Wait(WAIT_MILLIS, events);
+
+		for (const SocketPoller::Event& event : events)
+		{
+			// The handler may have been removed by an earlier event in this batch, so look it up again for each callback.
+			auto iter = ioThread.handlersBySocket.find(event.socket);
+			if (iter == ioThread.handlersBySocket.end())
+			{
+				continue;
+			}
+
+			IHandler* pHandler = iter->second;
+			bool keep = true;
+			if (event.readable)
+			{
+				keep = pHandler->OnReadable();
+			}
+
+			if (keep && event.writable)
+			{
+				auto registrationIter = ioThread.registrations.find(pHandler);
+				if (registrationIter != ioThread.registrations.end())
+				{
+					Registration& registration = registrationIter->second;
+					registration.writeInterest = false;
+					ioThread.pPoller->SetInterest(registration.socket, registration.readInterest, false);
+
+					keep = pHandler->OnWritable();
+				}
+			}
+
+			if (!keep && ioThread.registrations.count(pHandler) > 0)
+			{
+				reactor.RemoveHandler(ioThread, pHandler);
+			}
+		}
+	}
+}
+
+void SocketReactor::ApplyPendingChanges(IOThread& ioThread)
+{
+	std::vector<std::pair<SOCKET, IHandler*>> adds;
+	std::vector<IHandler*> writes;
+	std::vector<std::pair<IHandler*, bool>> readInterests;
+	std::vector<std::pair<IHandler*, bool>> suspensions;
+	std::unordered_set<IHandler*> removes;
+
+	std::unique_lock<std::mutex> lockGuard(ioThread.mutex);
+	adds.swap(ioThread.pendingAdds);
+	writes.swap(ioThread.pendingWrites);
+	readInterests.swap(ioThread.pendingReadInterest);
+	suspensions.swap(ioThread.pendingSuspensions);
+	removes.swap(ioThread.pendingRemoves);
+	lockGuard.unlock();
+
+	for (const std::pair<SOCKET, IHandler*>& add : adds)
+	{
+		ioThread.pPoller->Add(add.first);
+		ioThread.handlersBySocket[add.first] = add.second;
+		ioThread.registrations[add.second] = Registration{ add.first, true, false, false };
+	}
+
+	// Handlers are matched by pointer rather than socket, since a socket handle can be reused once it's closed.
+	for (IHandler* pHandler : writes)
+	{
+		auto iter = ioThread.registrations.find(pHandler);
+		if (iter != ioThread.registrations.end() && !iter->second.writeInterest)
+		{
+			iter->second.writeInterest = true;
+			if (!iter->second.suspended)
+			{
+				ioThread.pPoller->SetInterest(iter->second.socket, iter->second.readInterest, true);
+			}
+		}
+	}
+
+	for (const std::pair<IHandler*, bool>& readInterest : readInterests)
+	{
+		auto iter = ioThread.registrations.find(readInterest.first);
+		if (iter != ioThread.registrations.end() && iter->second.readInterest != readInterest.second)
+		{
+			iter->second.readInterest = readInterest.second;
+			if (!iter->second.suspended)
+			{
+				ioThread.pPoller->SetInterest(iter->second.socket, readInterest.second, iter->second.writeInterest);
+			}
+		}
+	}
+
+	for (const std::pair<IHandler*, bool>& suspension : suspensions)
+	{
+		auto iter = ioThread.registrations.find(suspension.first);
+		if (iter != ioThread.registrations.end() && iter->second.suspended != suspension.second)
+		{
+			Registration& registration = iter->second;
+			registration.suspended = suspension.second;
+			if (registration.suspended)
+			{
+				ioThread.pPoller->Remove(registration.socket);
+			}
+			else
+			{
+				ioThread.pPoller->Add(registration.socket);
+				ioThread.pPoller->SetInterest(registration.socket, registration.readInterest, registration.writeInterest);
+			}
+		}
+	}
+
+	std::unordered_map<IHandler*, bool> completed;
+	for (IHandler* pHandler : removes)
+	{
+		completed[pHandler] = RemoveHandler(ioThread, pHandler);
+	}
+
+	if (!completed.empty())
+	{
+		lockGuard.lock();
+		ioThread.completedRemoves.insert(completed.begin(), completed.end());
+		lockGuard.unlock();
+
+		ioThread.removedCondition.notify_all();
+	}
+}
+
+bool SocketReactor::RemoveHandler(IOThread& ioThread, IHandler* pHandler)
+{
+	auto iter = ioThread.registrations.find(pHandler);
+	if (iter == ioThread.registrations.end())
+	{
+		return false;
+	}
+
+	const SOCKET socket = iter->second.socket;
+	if (!iter->second.suspended)
+	{
+		ioThread.pPoller->Remove(socket);
+	}
+
+	ioThread.handlersBySocket.erase(socket);
+	ioThread.registrations.erase(iter);
+
+	std::unique_lock<std::mutex> assignmentLock(m_assignmentMutex);
+	m_assignments.erase(pHandler);
+	assignmentLock.unlock();
+
+	pHandler->OnRemoved();
+	return true;
+}
+
+SocketReactor::IOThread* SocketReactor::GetIOThread(IHandler& handler) const
+{
+	std::lock_guard<std::mutex> assignmentLock(m_assignmentMutex);
+
+	auto iter = m_assignments.find(&handler);
+	if (iter == m_assignments.end())
+	{
+		return nullptr;
+	}
+
+	return m_ioThreads[iter->second].get();
+}
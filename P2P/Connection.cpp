@@ -1,20 +1,29 @@
 #include "Connection.h"
-#include "MessageRetriever.h"
-#include "MessageProcessor.h"
 #include "MessageSender.h"
 #include "ConnectionManager.h"
 #include "Seed/PeerManager.h"
 
 #include <Net/SocketException.h>
-#include <Common/Util/ThreadUtil.h>
-#include <Infrastructure/ThreadManager.h>
+#include <Core/Serialization/DeserializationException.h>
 #include <Infrastructure/Logger.h>
-#include <thread>
+#include <Infrastructure/ThreadManager.h>
 #include <chrono>
 #include <memory>
+#include <algorithm>
 
 Connection::Connection(const uint64_t connectionId, const Config& config, ConnectionManager& connectionManager, PeerManager& peerManager, IBlockChainServer& blockChainServer, const ConnectedPeer& connectedPeer)
-	: m_connectionId(connectionId), m_config(config), m_connectionManager(connectionManager), m_peerManager(peerManager), m_blockChainServer(blockChainServer), m_connectedPeer(connectedPeer)
+	: m_connectionId(connectionId),
+	m_config(config),
+	m_connectionManager(connectionManager),
+	m_peerManager(peerManager),
+	m_blockChainServer(blockChainServer),
+	m_connectedPeer(connectedPeer),
+	m_messageProcessor(config, connectionManager, peerManager, blockChainServer, *this),
+	m_messageReader(config, connectionManager.GetBufferPool()),
+	m_sendOffset(0),
+	m_sendQueueBytes(0),
+	m_readingPaused(false),
+	m_transferring(false)
 {
 
 }
@@ -26,16 +35,17 @@ bool Connection::Connect()
 		return true;
 	}
 
-	m_terminate = true;
-	if (m_connectionThread.joinable())
-	{
-		m_connectionThread.join();
-	}
+	Disconnect();
 
 	m_terminate = false;
+	m_readingPaused = false;
+	m_peerManager.SetPeerConnected(GetConnectedPeer().GetPeer(), true);
+
+	SocketReactor& socketReactor = m_connectionManager.GetSocketReactor();
+	socketReactor.Add(m_connectedPeer.GetSocket().GetHandle(), *this);
 
-	m_connectionThread = std::thread(Thread_ProcessConnection, std::ref(*this));
-	ThreadManagerAPI::SetThreadName(m_connectionThread.get_id(), "PEER_CONNECTION");
+	// Messages may have been queued before the connection was registered.
+	socketReactor.RequestWrite(*this);
 
 	return true;
 }
@@ -56,85 +66,288 @@ bool Connection::IsConnectionActive() const
 
 void Connection::Disconnect()
 {
+	// Transfers check m_terminate between chunks.
 	m_terminate = true;
-
-	if (m_connectionThread.joinable())
+	if (m_transferThread.joinable())
 	{
-		m_connectionThread.join();
+		m_transferThread.join();
 	}
+
+	// Waits for any callback in progress, so the connection can be deleted once this returns.
+	m_connectionManager.GetSocketReactor().Remove(*this);
 }
 
 void Connection::Send(const IMessage& message)
 {
-	std::lock_guard<std::mutex> lockGuard(m_sendMutex);
-	m_sendQueue.emplace(message.Clone());
+	Send(MessageSender(m_config).Serialize(message));
+}
+
+void Connection::Send(const SerializedMessagePtr& pMessage)
+{
+	std::unique_lock<std::mutex> lockGuard(m_sendMutex);
+	m_sendQueue.push_back(pMessage);
+	m_sendQueueBytes += pMessage->size();
+	lockGuard.unlock();
+
+	m_connectionManager.GetSocketReactor().RequestWrite(*this);
+}
+
+bool Connection::FlushSendQueue()
+{
+	std::unique_lock<std::mutex> lockGuard(m_sendMutex);
+	std::vector<SerializedMessagePtr> messagesToSend(m_sendQueue.cbegin(), m_sendQueue.cend());
+	const size_t sendOffset = m_sendOffset;
+	m_sendQueue.clear();
+	m_sendOffset = 0;
+	lockGuard.unlock();
+
+	if (messagesToSend.empty())
+	{
+		return true;
+	}
+
+	std::vector<ByteView> buffers;
+	buffers.reserve(messagesToSend.size());
+	for (const SerializedMessagePtr& pMessage : messagesToSend)
+	{
+		buffers.emplace_back(ByteView(*pMessage));
+	}
+	buffers.front() = buffers.front().SubView(sendOffset, buffers.front().size() - sendOffset);
+
+	size_t numBytes = 0;
+	for (const ByteView& buffer : buffers)
+	{
+		numBytes += buffer.size();
+	}
+
+	const bool sent = m_connectedPeer.GetSocket().SendVectored(buffers);
+	m_sendQueueBytes -= numBytes;
+	if (sent)
+	{
+		m_connectedPeer.AddBytesSent(numBytes);
+	}
+
+	return sent;
+}
+
+void Connection::StartTransfer(const std::function<bool()>& transfer)
+{
+	// The previous transfer's thread is done with the socket before it's resumed, but may not have exited yet.
+	if (m_transferThread.joinable())
+	{
+		m_transferThread.join();
+	}
+
+	// Reading is paused, so once the socket is resumed, OnWritable resumes reading and processes any messages buffered during the transfer.
+	m_transferring = true;
+	m_readingPaused = true;
+
+	SocketReactor& socketReactor = m_connectionManager.GetSocketReactor();
+	socketReactor.SetReadInterest(*this, false);
+	socketReactor.SetSuspended(*this, true);
+
+	m_transferThread = std::thread(Thread_Transfer, std::ref(*this), transfer);
+}
+
+void Connection::Thread_Transfer(Connection& connection, const std::function<bool()> transfer)
+{
+	ThreadManagerAPI::SetCurrentThreadName("TRANSFER_THREAD");
+	LoggerAPI::LogTrace("Connection::Thread_Transfer() - BEGIN");
+
+	bool success = false;
+	try
+	{
+		success = transfer();
+	}
+	catch (const std::exception& e)
+	{
+		LoggerAPI::LogError("Connection::Thread_Transfer - Exception occurred: " + std::string(e.what()));
+	}
+
+	connection.m_transferring = false;
+
+	SocketReactor& socketReactor = connection.m_connectionManager.GetSocketReactor();
+	if (success && !connection.m_terminate)
+	{
+		socketReactor.SetSuspended(connection, false);
+
+		// Sends anything queued during the transfer.
+		socketReactor.RequestWrite(connection);
+	}
+	else
+	{
+		socketReactor.Remove(connection);
+	}
+
+	LoggerAPI::LogTrace("Connection::Thread_Transfer() - END");
 }
 
 //
-// Continuously checks for messages to send and/or receive until the connection is terminated.
-// This function runs in its own thread.
+// Receives whatever has arrived on the socket, and processes each message as soon as it's complete.
+// Runs on the connection's I/O thread.
 //
-void Connection::Thread_ProcessConnection(Connection& connection)
+bool Connection::OnReadable()
 {
-	connection.m_peerManager.SetPeerConnected(connection.GetConnectedPeer().GetPeer(), true);
-
-	MessageProcessor messageProcessor(connection.m_config, connection.m_connectionManager, connection.m_peerManager, connection.m_blockChainServer);
-	const MessageRetriever messageRetriever(connection.m_config, connection.m_connectionManager);
+	// The transfer thread owns the socket until it's resumed, but the socket may have been reported ready before it was suspended.
+	if (m_transferring)
+	{
+		return true;
+	}
 
-	while (!connection.m_terminate)
+	try
 	{
-		std::unique_lock<std::mutex> lockGuard(connection.m_peerMutex);
+		Socket& socket = m_connectedPeer.GetSocket();
 
-		try
+		size_t bytesAvailable = socket.GetNumBytesAvailable();
+		if (bytesAvailable == 0)
 		{
-			bool messageSentOrReceived = false;
+			// Readable with nothing to receive means the peer closed the connection.
+			return false;
+		}
 
-			// Check for received messages and if there is a new message, process it.
-			std::unique_ptr<RawMessage> pRawMessage = messageRetriever.RetrieveMessage(connection.m_connectedPeer, MessageRetriever::NON_BLOCKING);
-			if (pRawMessage.get() != nullptr)
+		while (bytesAvailable > 0 && !m_terminate && !m_readingPaused)
+		{
+			const size_t bytesReceived = m_messageReader.Receive(socket, bytesAvailable);
+			if (bytesReceived == 0)
 			{
-				const MessageProcessor::EStatus status = messageProcessor.ProcessMessage(connection.m_connectionId, connection.m_connectedPeer, *pRawMessage);
-				messageSentOrReceived = true;
+				return false;
 			}
 
-			// Send the next message in the queue, if one exists.
-			std::unique_lock<std::mutex> sendLockGuard(connection.m_sendMutex);
-			if (!connection.m_sendQueue.empty())
-			{
-				std::unique_ptr<IMessage> pMessageToSend(connection.m_sendQueue.front());
-				connection.m_sendQueue.pop();
+			m_connectedPeer.AddBytesReceived(bytesReceived);
 
-				MessageSender(connection.m_config).Send(connection.m_connectedPeer, *pMessageToSend);
+			ProcessBufferedMessages();
 
-				messageSentOrReceived = true;
-			}
+			bytesAvailable = socket.GetNumBytesAvailable();
+		}
 
-			sendLockGuard.unlock();
-			lockGuard.unlock();
+		return true;
+	}
+	catch (const DeserializationException&)
+	{
+		LoggerAPI::LogError("Connection::OnReadable - Deserialization exception occurred.");
+	}
+	catch (const SocketException&)
+	{
+		LoggerAPI::LogError("Connection::OnReadable - Socket exception occurred.");
+	}
+	catch (const std::exception& e)
+	{
+		LoggerAPI::LogError("Connection::OnReadable - Unknown exception occurred: " + std::string(e.what()));
+	}
 
-			if (!messageSentOrReceived)
-			{
-				ThreadUtil::SleepFor(std::chrono::milliseconds(5), connection.m_terminate);
-			}
+	return false;
+}
+
+//
+// Processes every complete message the reader has buffered, unless the send queue fills up,
+// in which case reading is paused and the rest are processed once the queue drains.
+//
+void Connection::ProcessBufferedMessages()
+{
+	const RawMessage* pRawMessage = m_messageReader.GetNextMessage();
+	while (pRawMessage != nullptr && !m_terminate)
+	{
+		GetPeer().UpdateLastContactTime();
+
+		m_messageProcessor.ProcessMessage(m_connectionId, m_connectedPeer, *pRawMessage, m_messageReader);
+
+		// The rest of the messages are processed once the transfer is done.
+		if (m_transferring)
+		{
+			return;
+		}
+
+		if (IsSendQueueFull())
+		{
+			m_readingPaused = true;
+			m_connectionManager.GetSocketReactor().SetReadInterest(*this, false);
+			return;
+		}
+
+		pRawMessage = m_messageReader.GetNextMessage();
+	}
+}
+
+//
+// Sends as many queued messages as the socket will accept without blocking, using a single vectored send.
+// Runs on the connection's I/O thread.
+//
+bool Connection::OnWritable()
+{
+	if (m_transferring)
+	{
+		return true;
+	}
+
+	std::unique_lock<std::mutex> lockGuard(m_sendMutex);
+	const size_t numMessages = (std::min)(m_sendQueue.size(), (size_t)MAX_MESSAGES_PER_SEND);
+	std::vector<SerializedMessagePtr> messagesToSend(m_sendQueue.cbegin(), m_sendQueue.cbegin() + numMessages);
+	const size_t sendOffset = m_sendOffset;
+	lockGuard.unlock();
+
+	if (!messagesToSend.empty())
+	{
+		std::vector<ByteView> buffers;
+		buffers.reserve(messagesToSend.size());
+		for (const SerializedMessagePtr& pMessage : messagesToSend)
+		{
+			buffers.emplace_back(ByteView(*pMessage));
+		}
+		buffers.front() = buffers.front().SubView(sendOffset, buffers.front().size() - sendOffset);
+
+		size_t bytesSent = 0;
+		if (!m_connectedPeer.GetSocket().TrySendVectored(buffers, bytesSent))
+		{
+			return false;
+		}
+
+		m_connectedPeer.AddBytesSent(bytesSent);
+
+		// Only the I/O thread removes from the queue, so the messages that were sent are still at the front.
+		lockGuard.lock();
+		m_sendQueueBytes -= bytesSent;
+		size_t bytesToRemove = bytesSent + m_sendOffset;
+		while (!m_sendQueue.empty() && bytesToRemove >= m_sendQueue.front()->size())
+		{
+			bytesToRemove -= m_sendQueue.front()->size();
+			m_sendQueue.pop_front();
 		}
-		catch (const DeserializationException&)
+
+		m_sendOffset = bytesToRemove;
+		const bool moreToSend = !m_sendQueue.empty();
+		lockGuard.unlock();
+
+		if (moreToSend)
 		{
-			LoggerAPI::LogError("Connection::Thread_ProcessConnection - Deserialization exception occurred.");
-			break;
+			m_connectionManager.GetSocketReactor().RequestWrite(*this);
 		}
-		catch (const SocketException&)
+	}
+
+	if (m_readingPaused && m_sendQueueBytes <= MAX_SEND_QUEUE_BYTES / 2)
+	{
+		m_readingPaused = false;
+		m_connectionManager.GetSocketReactor().SetReadInterest(*this, true);
+
+		// Messages that were already buffered when reading was paused won't trigger OnReadable.
+		try
 		{
-			LoggerAPI::LogError("Connection::Thread_ProcessConnection - Socket exception occurred.");
-			break;
+			ProcessBufferedMessages();
 		}
 		catch (const std::exception& e)
 		{
-			LoggerAPI::LogError("Connection::Thread_ProcessConnection - Unknown exception occurred: " + std::string(e.what()));
-			break;
+			LoggerAPI::LogError("Connection::OnWritable - Exception occurred: " + std::string(e.what()));
+			return false;
 		}
 	}
 
-	connection.GetConnectedPeer().GetSocket().CloseSocket();
+	return true;
+}
+
+void Connection::OnRemoved()
+{
+	m_terminate = true;
+
+	GetConnectedPeer().GetSocket().CloseSocket();
 
-	connection.m_peerManager.SetPeerConnected(connection.GetConnectedPeer().GetPeer(), false);
+	m_peerManager.SetPeerConnected(GetConnectedPeer().GetPeer(), false);
 }
\ No newline at end of file
@@ -1,12 +1,18 @@
 #pragma once
 
 #include "Messages/Message.h"
+#include "MessageProcessor.h"
+#include "MessageReader.h"
+#include "MessageSender.h"
 
 #include <P2P/ConnectedPeer.h>
 #include <Config/Config.h>
+#include <Net/SocketReactor.h>
 #include <mutex>
 #include <atomic>
-#include <queue>
+#include <deque>
+#include <thread>
+#include <functional>
 
 // Forward Declarations
 class IMessage;
@@ -16,10 +22,17 @@ class PeerManager;
 
 //
 // A Connection will be created for each ConnectedPeer.
-// Each Connection will run on its own thread, and will watch the socket for messages,
-// and will ping the peer when it hasn't been heard from in a while.
+// Each Connection is registered with the ConnectionManager's SocketReactor, which calls back into it
+// on one of the shared I/O threads whenever the socket has data to receive, or can be written to.
 //
-class Connection
+// Outgoing messages are queued, and sent in batches without blocking the I/O thread.
+// Once more than MAX_SEND_QUEUE_BYTES are waiting to be sent, the connection stops reading requests from the peer
+// until the queue has drained to half that, so a peer can't make the node buffer an unbounded number of responses.
+//
+// Long transfers, like streaming a TxHashSet archive, run on their own thread with the socket suspended from the reactor,
+// so they don't hold up the other connections sharing the I/O thread.
+//
+class Connection : public SocketReactor::IHandler
 {
 public:
 	Connection(const uint64_t connectionId, const Config& config, ConnectionManager& connectionManager, PeerManager& peerManager, IBlockChainServer& blockChainServer, const ConnectedPeer& connectedPeer);
@@ -30,28 +43,65 @@ public:
 	void Disconnect();
 
 	void Send(const IMessage& message);
+	void Send(const SerializedMessagePtr& pMessage);
+
+	//
+	// Blocks until every queued message has been sent. Must only be called from the connection's transfer thread.
+	//
+	bool FlushSendQueue();
+
+	//
+	// Suspends the socket from the reactor, and runs the transfer on the connection's transfer thread, which then owns the socket and the MessageReader.
+	// Once the transfer returns, the socket is handed back to the reactor, or removed if the transfer returned false.
+	// Must only be called from the connection's I/O thread.
+	//
+	void StartTransfer(const std::function<bool()>& transfer);
+
+	inline bool IsSendQueueFull() const { return m_sendQueueBytes >= MAX_SEND_QUEUE_BYTES; }
+	inline uint64_t GetBytesSent() const { return m_connectedPeer.GetBytesSent(); }
+	inline uint64_t GetBytesReceived() const { return m_connectedPeer.GetBytesReceived(); }
 
 	inline Peer& GetPeer() { return m_connectedPeer.GetPeer(); }
 	inline const Peer& GetPeer() const { return m_connectedPeer.GetPeer(); }
+	inline ConnectedPeer& GetConnectedPeer() { return m_connectedPeer; }
 	inline const ConnectedPeer& GetConnectedPeer() const { return m_connectedPeer; }
 	inline uint64_t GetTotalDifficulty() const { return m_connectedPeer.GetTotalDifficulty(); }
 	inline uint64_t GetHeight() const { return m_connectedPeer.GetHeight(); }
 	inline Capabilities GetCapabilities() const { return m_connectedPeer.GetPeer().GetCapabilities(); }
 
+	//
+	// SocketReactor::IHandler
+	//
+	bool OnReadable() override final;
+	bool OnWritable() override final;
+	void OnRemoved() override final;
+
 private:
-	static void Thread_ProcessConnection(Connection& connection);
+	static const size_t MAX_SEND_QUEUE_BYTES = 16 * 1024 * 1024;
+	static const size_t MAX_MESSAGES_PER_SEND = 256;
+
+	void ProcessBufferedMessages();
+	static void Thread_Transfer(Connection& connection, const std::function<bool()> transfer);
 
 	const Config& m_config;
 	IBlockChainServer& m_blockChainServer;
 	ConnectionManager& m_connectionManager;
 	PeerManager& m_peerManager;
 	std::atomic<bool> m_terminate = true;
-	std::thread m_connectionThread;
 	const uint64_t m_connectionId;
 
-	mutable std::mutex m_peerMutex;
 	ConnectedPeer m_connectedPeer;
+	MessageProcessor m_messageProcessor;
+	MessageReader m_messageReader;
 
 	mutable std::mutex m_sendMutex;
-	std::queue<IMessage*> m_sendQueue;
+	std::deque<SerializedMessagePtr> m_sendQueue;
+	size_t m_sendOffset;
+	std::atomic<size_t> m_sendQueueBytes;
+
+	// Only accessed by the I/O thread.
+	bool m_readingPaused;
+
+	std::atomic<bool> m_transferring;
+	std::thread m_transferThread;
 };
\ No newline at end of file
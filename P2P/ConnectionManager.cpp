@@ -15,6 +15,8 @@ ConnectionManager::ConnectionManager(const Config& config, PeerManager& peerMana
 	: m_config(config), 
 	m_peerManager(peerManager), 
 	m_blockChainServer(blockChainServer),
+	m_bufferPool(32, 4 * 1024 * 1024),
+	m_socketReactor(config.GetP2PConfig().GetNumIOThreads()),
 	m_syncer(*this, blockChainServer), 
 	m_seeder(config, *this, peerManager, blockChainServer),
 	m_pipeline(config, *this, blockChainServer),
@@ -28,6 +30,7 @@ void ConnectionManager::Start()
 	m_terminate = false;
 
 	m_peerManager.Start();
+	m_socketReactor.Start();
 	m_seeder.Start();
 	m_syncer.Start();
 	m_pipeline.Start();
@@ -56,6 +59,7 @@ void ConnectionManager::Stop()
 	}
 
 	PruneConnections(false);
+	m_socketReactor.Stop();
 	m_peerManager.Stop();
 }
 
@@ -136,6 +140,19 @@ std::vector<uint64_t> ConnectionManager::GetMostWorkPeers() const
 	return mostWorkPeers;
 }
 
+bool ConnectionManager::IsSendQueueFull(const uint64_t connectionId) const
+{
+	std::shared_lock<std::shared_mutex> readLock(m_connectionsMutex);
+
+	Connection* pConnection = GetConnectionById(connectionId);
+	if (pConnection != nullptr)
+	{
+		return pConnection->IsSendQueueFull();
+	}
+
+	return false;
+}
+
 std::vector<ConnectedPeer> ConnectionManager::GetConnectedPeers() const
 {
 	std::shared_lock<std::shared_mutex> readLock(m_connectionsMutex);
@@ -224,8 +241,11 @@ bool ConnectionManager::SendMessageToPeer(const IMessage& message, const uint64_
 
 void ConnectionManager::BroadcastMessage(const IMessage& message, const uint64_t sourceId)
 {
+	// Serialized once here, and the same buffer is queued on every connection.
+	SerializedMessagePtr pSerializedMessage = MessageSender(m_config).Serialize(message);
+
 	std::unique_lock<std::mutex> writeLock(m_broadcastMutex);
-	m_sendQueue.emplace(MessageToBroadcast(sourceId, message.Clone()));
+	m_sendQueue.emplace(MessageToBroadcast(sourceId, pSerializedMessage));
 }
 
 void ConnectionManager::AddConnection(Connection* pConnection)
@@ -239,12 +259,14 @@ void ConnectionManager::PruneConnections(const bool bInactiveOnly)
 {
 	std::unique_lock<std::shared_mutex> writeLock(m_connectionsMutex);
 
-	bool pingConnections = false;
+	SerializedMessagePtr pPingMessage = nullptr;
 	auto now = std::chrono::system_clock::now();
 	if (m_lastPingTime + std::chrono::seconds(10) < now)
 	{
 		m_lastPingTime = now;
-		pingConnections = true;
+
+		const SyncStatus& syncStatus = m_syncer.GetSyncStatus();
+		pPingMessage = MessageSender(m_config).Serialize(PingMessage(syncStatus.GetBlockDifficulty(), syncStatus.GetBlockHeight()));
 	}
 
 	std::unique_lock<std::shared_mutex> disconnectLock(m_disconnectMutex);
@@ -281,10 +303,9 @@ void ConnectionManager::PruneConnections(const bool bInactiveOnly)
 			continue;
 		}
 
-		if (pingConnections)
+		if (pPingMessage != nullptr)
 		{
-			const SyncStatus& syncStatus = m_syncer.GetSyncStatus();
-			pConnection->Send(PingMessage(syncStatus.GetBlockDifficulty(), syncStatus.GetBlockHeight()));
+			pConnection->Send(pPingMessage);
 		}
 	}
 
@@ -386,10 +407,8 @@ void ConnectionManager::Thread_Broadcast(ConnectionManager& connectionManager)
 		{
 			if (pConnection->GetId() != broadcastMessage.m_sourceId)
 			{
-				pConnection->Send(*broadcastMessage.m_pMessage);
+				pConnection->Send(broadcastMessage.m_pMessage);
 			}
 		}
-
-		delete broadcastMessage.m_pMessage;
 	}
 }
\ No newline at end of file
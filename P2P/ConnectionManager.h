@@ -5,11 +5,14 @@
 #include "Seed/Seeder.h"
 #include "Pipeline.h"
 #include "Dandelion.h"
+#include "MessageBufferPool.h"
 
 #include <Config/Config.h>
 #include <BlockChain/BlockChainServer.h>
+#include <Net/SocketReactor.h>
 #include <vector>
 #include <shared_mutex>
+#include <queue>
 #include <thread>
 #include <set>
 
@@ -25,6 +28,8 @@ public:
 	void Stop();
 
 	inline Pipeline& GetPipeline() { return m_pipeline; }
+	inline SocketReactor& GetSocketReactor() { return m_socketReactor; }
+	inline MessageBufferPool& GetBufferPool() { return m_bufferPool; }
 	inline bool IsTerminating() const { return m_terminate; }
 
 	inline SyncStatus& GetSyncStatus() { return m_syncer.GetSyncStatus(); }
@@ -35,6 +40,7 @@ public:
 	std::pair<size_t, size_t> GetNumConnectionsWithDirection() const;
 	bool IsConnected(const IPAddress& address) const;
 	std::vector<uint64_t> GetMostWorkPeers() const;
+	bool IsSendQueueFull(const uint64_t connectionId) const;
 	std::vector<ConnectedPeer> GetConnectedPeers() const;
 	std::optional<std::pair<uint64_t, ConnectedPeer>> GetConnectedPeer(const IPAddress& address, const std::optional<uint16_t>& portOpt) const;
 	uint64_t GetMostWork() const;
@@ -64,13 +70,13 @@ private:
 
 	struct MessageToBroadcast
 	{
-		MessageToBroadcast(uint64_t sourceId, IMessage* pMessage)
+		MessageToBroadcast(uint64_t sourceId, const SerializedMessagePtr& pMessage)
 			: m_sourceId(sourceId), m_pMessage(pMessage)
 		{
 
 		}
 		uint64_t m_sourceId;
-		IMessage* m_pMessage;
+		SerializedMessagePtr m_pMessage;
 	};
 	mutable std::mutex m_broadcastMutex;
 	std::queue<MessageToBroadcast> m_sendQueue;
@@ -80,6 +86,8 @@ private:
 	const Config& m_config;
 	PeerManager& m_peerManager;
 	IBlockChainServer& m_blockChainServer;
+	MessageBufferPool m_bufferPool;
+	SocketReactor m_socketReactor;
 	Syncer m_syncer;
 	Seeder m_seeder;
 	Pipeline m_pipeline;
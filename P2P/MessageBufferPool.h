@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <algorithm>
+
+//
+// Recycles the receive buffers of every connection, so connection churn and large messages
+// don't allocate (and zero) a new buffer each time.
+// At most maxPooledBuffers buffers are kept, and buffers larger than maxPooledCapacity are released instead of pooled.
+//
+class MessageBufferPool
+{
+public:
+	MessageBufferPool(const size_t maxPooledBuffers, const size_t maxPooledCapacity)
+		: m_maxPooledBuffers(maxPooledBuffers), m_maxPooledCapacity(maxPooledCapacity)
+	{
+
+	}
+
+	//
+	// Returns a buffer of the given size, reusing the smallest pooled buffer that's large enough.
+	//
+	std::vector<unsigned char> Take(const size_t size)
+	{
+		std::unique_lock<std::mutex> lockGuard(m_mutex);
+
+		auto bestIter = m_buffers.end();
+		for (auto iter = m_buffers.begin(); iter != m_buffers.end(); iter++)
+		{
+			if (iter->capacity() >= size && (bestIter == m_buffers.end() || iter->capacity() < bestIter->capacity()))
+			{
+				bestIter = iter;
+			}
+		}
+
+		if (bestIter == m_buffers.end())
+		{
+			lockGuard.unlock();
+			return std::vector<unsigned char>(size);
+		}
+
+		std::vector<unsigned char> buffer = std::move(*bestIter);
+		m_buffers.erase(bestIter);
+		lockGuard.unlock();
+
+		buffer.resize(size);
+		return buffer;
+	}
+
+	void Return(std::vector<unsigned char>&& buffer)
+	{
+		if (buffer.capacity() == 0 || buffer.capacity() > m_maxPooledCapacity)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lockGuard(m_mutex);
+		if (m_buffers.size() < m_maxPooledBuffers)
+		{
+			m_buffers.emplace_back(std::move(buffer));
+		}
+	}
+
+private:
+	const size_t m_maxPooledBuffers;
+	const size_t m_maxPooledCapacity;
+
+	std::mutex m_mutex;
+	std::vector<std::vector<unsigned char>> m_buffers;
+};
@@ -1,5 +1,6 @@
 #include "MessageProcessor.h"
-#include "MessageSender.h"
+#include "MessageReader.h"
+#include "Connection.h"
 #include "Seed/PeerManager.h"
 #include "BlockLocator.h"
 #include "ConnectionManager.h"
@@ -43,17 +44,17 @@ static const int BUFFER_SIZE = 256 * 1024;
 
 using namespace MessageTypes;
 
-MessageProcessor::MessageProcessor(const Config& config, ConnectionManager& connectionManager, PeerManager& peerManager, IBlockChainServer& blockChainServer)
-	: m_config(config), m_connectionManager(connectionManager), m_peerManager(peerManager), m_blockChainServer(blockChainServer)
+MessageProcessor::MessageProcessor(const Config& config, ConnectionManager& connectionManager, PeerManager& peerManager, IBlockChainServer& blockChainServer, Connection& connection)
+	: m_config(config), m_connectionManager(connectionManager), m_peerManager(peerManager), m_blockChainServer(blockChainServer), m_connection(connection)
 {
 
 }
 
-MessageProcessor::EStatus MessageProcessor::ProcessMessage(const uint64_t connectionId, ConnectedPeer& connectedPeer, const RawMessage& rawMessage)
+MessageProcessor::EStatus MessageProcessor::ProcessMessage(const uint64_t connectionId, ConnectedPeer& connectedPeer, const RawMessage& rawMessage, MessageReader& messageReader)
 {
 	try
 	{
-		return ProcessMessageInternal(connectionId, connectedPeer, rawMessage);
+		return ProcessMessageInternal(connectionId, connectedPeer, rawMessage, messageReader);
 	}
 	catch (const DeserializationException&)
 	{
@@ -65,7 +66,7 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessage(const uint64_t connec
 	}
 }
 
-MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(const uint64_t connectionId, ConnectedPeer& connectedPeer, const RawMessage& rawMessage)
+MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(const uint64_t connectionId, ConnectedPeer& connectedPeer, const RawMessage& rawMessage, MessageReader& messageReader)
 {
 	const std::string formattedIPAddress = connectedPeer.GetPeer().GetIPAddress().Format();
 	const MessageHeader& header = rawMessage.GetMessageHeader();
@@ -97,7 +98,8 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(const uint64_
 
 				const PongMessage pongMessage(m_blockChainServer.GetTotalDifficulty(EChainType::CONFIRMED), m_blockChainServer.GetHeight(EChainType::CONFIRMED));
 
-				return MessageSender(m_config).Send(connectedPeer, pongMessage) ? EStatus::SUCCESS : EStatus::SOCKET_FAILURE;
+				m_connection.Send(pongMessage);
+				return EStatus::SUCCESS;
 			}
 			case Pong:
 			{
@@ -123,7 +125,8 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(const uint64_
 				LoggerAPI::LogTrace(StringUtil::Format("MessageProcessor::ProcessMessageInternal - Sending %llu addresses to %s.", socketAddresses.size(), formattedIPAddress.c_str()));
 				const PeerAddressesMessage peerAddressesMessage(std::move(socketAddresses));
 
-				return MessageSender(m_config).Send(connectedPeer, peerAddressesMessage) ? EStatus::SUCCESS : EStatus::SOCKET_FAILURE;
+				m_connection.Send(peerAddressesMessage);
+				return EStatus::SUCCESS;
 			}
 			case PeerAddrs:
 			{
@@ -146,7 +149,8 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(const uint64_
 				const HeadersMessage headersMessage(std::move(blockHeaders));
 
 				LoggerAPI::LogDebug(StringUtil::Format("MessageProcessor::ProcessMessageInternal - Sending %llu headers to %s.", blockHeaders.size(), formattedIPAddress.c_str()));
-				return MessageSender(m_config).Send(connectedPeer, headersMessage) ? EStatus::SUCCESS : EStatus::SOCKET_FAILURE;
+				m_connection.Send(headersMessage);
+				return EStatus::SUCCESS;
 			}
 			case Header:
 			{
@@ -162,7 +166,8 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(const uint64_
 					if (m_blockChainServer.GetBlockByHash(blockHeader.GetHash()) == nullptr)
 					{
 						const GetCompactBlockMessage getCompactBlockMessage(blockHeader.GetHash());
-						return MessageSender(m_config).Send(connectedPeer, getCompactBlockMessage) ? EStatus::SUCCESS : EStatus::SOCKET_FAILURE;
+						m_connection.Send(getCompactBlockMessage);
+						return EStatus::SUCCESS;
 					}
 				}
 				else
@@ -174,11 +179,13 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(const uint64_
 			}
 			case Headers:
 			{
+				// The payload is only valid until the next message is read, so it's deserialized before handing the headers off.
+				ByteBuffer byteBuffer(rawMessage.GetPayload());
+				std::shared_ptr<const HeadersMessage> pHeadersMessage = std::make_shared<const HeadersMessage>(HeadersMessage::Deserialize(byteBuffer));
+
 				IBlockChainServer& blockChainServer = m_blockChainServer;
-				async::spawn([&blockChainServer, rawMessage, formattedIPAddress] {
-					ByteBuffer byteBuffer(rawMessage.GetPayload());
-					const HeadersMessage headersMessage = HeadersMessage::Deserialize(byteBuffer);
-					const std::vector<BlockHeader>& blockHeaders = headersMessage.GetHeaders();
+				async::spawn([&blockChainServer, pHeadersMessage, formattedIPAddress] {
+					const std::vector<BlockHeader>& blockHeaders = pHeadersMessage->GetHeaders();
 
 					LoggerAPI::LogDebug(StringUtil::Format("MessageProcessor::ProcessMessageInternal - %lld headers received from %s.", blockHeaders.size(), formattedIPAddress.c_str()));
 
@@ -196,7 +203,8 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(const uint64_
 				if (pBlock != nullptr)
 				{
 					BlockMessage blockMessage(std::move(*pBlock));
-					return MessageSender(m_config).Send(connectedPeer, blockMessage) ? EStatus::SUCCESS : EStatus::SOCKET_FAILURE;
+					m_connection.Send(blockMessage);
+					return EStatus::SUCCESS;
 				}
 
 				return EStatus::RESOURCE_NOT_FOUND;
@@ -211,7 +219,7 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(const uint64_
 
 				if (m_connectionManager.GetSyncStatus().GetStatus() == ESyncStatus::SYNCING_BLOCKS)
 				{
-					m_connectionManager.GetPipeline().AddBlockToProcess(connectionId, block);
+					return m_connectionManager.GetPipeline().AddBlockToProcess(connectionId, block) ? EStatus::SUCCESS : EStatus::UNKNOWN_ERROR;
 				}
 				else
 				{
@@ -227,7 +235,8 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(const uint64_
 						if (block.GetBlockHeader().GetTotalDifficulty() > m_blockChainServer.GetTotalDifficulty(EChainType::CONFIRMED))
 						{
 							const GetCompactBlockMessage getPreviousCompactBlockMessage(block.GetBlockHeader().GetPreviousBlockHash());
-							return MessageSender(m_config).Send(connectedPeer, getPreviousCompactBlockMessage) ? EStatus::SUCCESS : EStatus::SOCKET_FAILURE;
+							m_connection.Send(getPreviousCompactBlockMessage);
+							return EStatus::SUCCESS;
 						}
 					}
 					else if (added == EBlockChainStatus::INVALID)
@@ -246,7 +255,8 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(const uint64_
 				if (pCompactBlock != nullptr)
 				{
 					const CompactBlockMessage compactBlockMessage(*pCompactBlock);
-					return MessageSender(m_config).Send(connectedPeer, compactBlockMessage) ? EStatus::SUCCESS : EStatus::SOCKET_FAILURE;
+					m_connection.Send(compactBlockMessage);
+					return EStatus::SUCCESS;
 				}
 
 				return EStatus::RESOURCE_NOT_FOUND;
@@ -267,7 +277,8 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(const uint64_
 				else if (added == EBlockChainStatus::TRANSACTIONS_MISSING)
 				{
 					const GetBlockMessage getBlockMessage(compactBlock.GetHash());
-					return MessageSender(m_config).Send(connectedPeer, getBlockMessage) ? EStatus::SUCCESS : EStatus::SOCKET_FAILURE;
+					m_connection.Send(getBlockMessage);
+					return EStatus::SUCCESS;
 				}
 				else if (added == EBlockChainStatus::ORPHANED)
 				{
@@ -276,7 +287,8 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(const uint64_
 						if (compactBlock.GetBlockHeader().GetTotalDifficulty() > m_blockChainServer.GetTotalDifficulty(EChainType::CONFIRMED))
 						{
 							const GetCompactBlockMessage getPreviousCompactBlockMessage(compactBlock.GetBlockHeader().GetPreviousBlockHash());
-							return MessageSender(m_config).Send(connectedPeer, getPreviousCompactBlockMessage) ? EStatus::SUCCESS : EStatus::SOCKET_FAILURE;
+							m_connection.Send(getPreviousCompactBlockMessage);
+							return EStatus::SUCCESS;
 						}
 					}
 				}
@@ -314,14 +326,25 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(const uint64_
 				ByteBuffer byteBuffer(rawMessage.GetPayload());
 				const TxHashSetRequestMessage txHashSetRequestMessage = TxHashSetRequestMessage::Deserialize(byteBuffer);
 
-				return SendTxHashSet(connectionId, connectedPeer, txHashSetRequestMessage);
+				// Snapshotting and streaming the archive takes a while, so it's done on the connection's transfer thread.
+				m_connection.StartTransfer([this, connectionId, &connectedPeer, txHashSetRequestMessage]
+				{
+					return IsSocketUsable(SendTxHashSet(connectionId, connectedPeer, txHashSetRequestMessage));
+				});
+
+				return EStatus::SUCCESS;
 			}
 			case TxHashSetArchive:
 			{
 				ByteBuffer byteBuffer(rawMessage.GetPayload());
 				const TxHashSetArchiveMessage txHashSetArchiveMessage = TxHashSetArchiveMessage::Deserialize(byteBuffer);
 
-				return ReceiveTxHashSet(connectionId, connectedPeer, txHashSetArchiveMessage);
+				m_connection.StartTransfer([this, connectionId, &connectedPeer, txHashSetArchiveMessage, &messageReader]
+				{
+					return IsSocketUsable(ReceiveTxHashSet(connectionId, connectedPeer, txHashSetArchiveMessage, messageReader));
+				});
+
+				return EStatus::SUCCESS;
 			}
 			case GetTransactionMsg:
 			{
@@ -333,7 +356,8 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(const uint64_
 				if (pTransaction == nullptr)
 				{
 					const TransactionMessage transactionMessage(*pTransaction);
-					return MessageSender(m_config).Send(connectedPeer, transactionMessage) ? EStatus::SUCCESS : EStatus::SOCKET_FAILURE;
+					m_connection.Send(transactionMessage);
+					return EStatus::SUCCESS;
 				}
 
 				return EStatus::RESOURCE_NOT_FOUND;
@@ -354,7 +378,8 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(const uint64_
 				if (pTransaction == nullptr)
 				{
 					const GetTransactionMessage getTransactionMessage(kernelHash);
-					return MessageSender(m_config).Send(connectedPeer, getTransactionMessage) ? EStatus::SUCCESS : EStatus::SOCKET_FAILURE;
+					m_connection.Send(getTransactionMessage);
+					return EStatus::SUCCESS;
 				}
 
 				return EStatus::RESOURCE_NOT_FOUND;
@@ -369,6 +394,11 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(const uint64_
 	return EStatus::UNKNOWN_MESSAGE;
 }
 
+bool MessageProcessor::IsSocketUsable(const EStatus status)
+{
+	return status != EStatus::SOCKET_FAILURE && status != EStatus::BAN_PEER;
+}
+
 MessageProcessor::EStatus MessageProcessor::SendTxHashSet(const uint64_t connectionId, ConnectedPeer& connectedPeer, const TxHashSetRequestMessage& txHashSetRequestMessage)
 {
 	LoggerAPI::LogInfo(StringUtil::Format("MessageProcessor::SendTxHashSet - Sending TxHashSet snapshot to %s.", connectedPeer.GetPeer().GetIPAddress().Format().c_str()));
@@ -394,9 +424,15 @@ MessageProcessor::EStatus MessageProcessor::SendTxHashSet(const uint64_t connect
 	const uint64_t fileSize = file.tellg();
 	file.seekg(0);
 	TxHashSetArchiveMessage archiveMessage(Hash(pHeader->GetHash()), pHeader->GetHeight(), fileSize);
-	MessageSender(m_config).Send(connectedPeer, archiveMessage);
+	// The archive is streamed straight to the socket after the message, so everything queued before it has to be sent first.
+	m_connection.Send(archiveMessage);
+	if (!m_connection.FlushSendQueue())
+	{
+		file.close();
+		FileUtil::RemoveFile(zipFilePath);
 
-	connectedPeer.GetSocket().SetBlocking(false);
+		return EStatus::SOCKET_FAILURE;
+	}
 
 	std::vector<unsigned char> buffer(BUFFER_SIZE, 0);
 	uint64_t totalBytesRead = 0;
@@ -408,7 +444,7 @@ MessageProcessor::EStatus MessageProcessor::SendTxHashSet(const uint64_t connect
 		const std::vector<unsigned char> bytesToSend(buffer.cbegin(), buffer.cbegin() + bytesRead);
 		const bool sent = connectedPeer.GetSocket().Send(bytesToSend);
 
-		if (!sent || m_connectionManager.IsTerminating())
+		if (!sent || m_connectionManager.IsTerminating() || !m_connection.IsConnectionActive())
 		{
 			LoggerAPI::LogError("MessageProcessor::SendTxHashSet - Transmission ended abruptly.");
 			file.close();
@@ -418,9 +454,11 @@ MessageProcessor::EStatus MessageProcessor::SendTxHashSet(const uint64_t connect
 		}
 
 		totalBytesRead += bytesRead;
-	}
+		connectedPeer.AddBytesSent(bytesRead);
 
-	connectedPeer.GetSocket().SetBlocking(true);
+		// Nothing else is exchanged during the transfer, so progress counts as contact.
+		connectedPeer.GetPeer().UpdateLastContactTime();
+	}
 
 	file.close();
 	FileUtil::RemoveFile(zipFilePath);
@@ -428,7 +466,7 @@ MessageProcessor::EStatus MessageProcessor::SendTxHashSet(const uint64_t connect
 	return EStatus::SUCCESS;
 }
 
-MessageProcessor::EStatus MessageProcessor::ReceiveTxHashSet(const uint64_t connectionId, ConnectedPeer& connectedPeer, const TxHashSetArchiveMessage& txHashSetArchiveMessage)
+MessageProcessor::EStatus MessageProcessor::ReceiveTxHashSet(const uint64_t connectionId, ConnectedPeer& connectedPeer, const TxHashSetArchiveMessage& txHashSetArchiveMessage, MessageReader& messageReader)
 {
 	LoggerAPI::LogInfo(StringUtil::Format("MessageProcessor::ReceiveTxHashSet - Downloading TxHashSet from %s.", connectedPeer.GetPeer().GetIPAddress().Format().c_str()));
 
@@ -449,8 +487,8 @@ MessageProcessor::EStatus MessageProcessor::ReceiveTxHashSet(const uint64_t conn
 	while (bytesReceived < txHashSetArchiveMessage.GetZippedSize())
 	{
 		const int bytesToRead = std::min((int)(txHashSetArchiveMessage.GetZippedSize() - bytesReceived), BUFFER_SIZE);
-		const bool received = connectedPeer.GetSocket().Receive(bytesToRead, buffer);
-		if (!received || m_connectionManager.IsTerminating())
+		const bool received = messageReader.ReadRaw(connectedPeer.GetSocket(), bytesToRead, buffer);
+		if (!received || m_connectionManager.IsTerminating() || !m_connection.IsConnectionActive())
 		{
 			syncStatus.UpdateStatus(ESyncStatus::TXHASHSET_SYNC_FAILED);
 
@@ -463,6 +501,7 @@ MessageProcessor::EStatus MessageProcessor::ReceiveTxHashSet(const uint64_t conn
 
 		fout.write((char*)&buffer[0], bytesToRead);
 		bytesReceived += bytesToRead;
+		connectedPeer.GetPeer().UpdateLastContactTime();
 
 		syncStatus.UpdateDownloaded(bytesReceived);
 	}
@@ -13,6 +13,8 @@ class RawMessage;
 class TxHashSetArchiveMessage;
 class TxHashSetRequestMessage;
 class PeerManager;
+class MessageReader;
+class Connection;
 
 class MessageProcessor
 {
@@ -28,17 +30,29 @@ public:
 		BAN_PEER
 	};
 
-	MessageProcessor(const Config& config, ConnectionManager& connectionManager, PeerManager& peerManager, IBlockChainServer& blockChainServer);
+	//
+	// Responses are queued on the given connection, which must be the one the processed messages are received on.
+	//
+	MessageProcessor(const Config& config, ConnectionManager& connectionManager, PeerManager& peerManager, IBlockChainServer& blockChainServer, Connection& connection);
 
-	EStatus ProcessMessage(const uint64_t connectionId, ConnectedPeer& connectedPeer, const RawMessage& rawMessage);
+	//
+	// Processes a message received by the given MessageReader, which is also used to read any data streamed after the message.
+	//
+	EStatus ProcessMessage(const uint64_t connectionId, ConnectedPeer& connectedPeer, const RawMessage& rawMessage, MessageReader& messageReader);
 
 private:
-	EStatus ProcessMessageInternal(const uint64_t connectionId, ConnectedPeer& connectedPeer, const RawMessage& rawMessage);
+	//
+	// The archive transfers run on the connection's transfer thread, after which the socket is only reused if they ended cleanly.
+	//
+	static bool IsSocketUsable(const EStatus status);
+
+	EStatus ProcessMessageInternal(const uint64_t connectionId, ConnectedPeer& connectedPeer, const RawMessage& rawMessage, MessageReader& messageReader);
 	EStatus SendTxHashSet(const uint64_t connectionId, ConnectedPeer& connectedPeer, const TxHashSetRequestMessage& txHashSetRequestMessage);
-	EStatus ReceiveTxHashSet(const uint64_t connectionId, ConnectedPeer& connectedPeer, const TxHashSetArchiveMessage& txHashSetArchiveMessage);
+	EStatus ReceiveTxHashSet(const uint64_t connectionId, ConnectedPeer& connectedPeer, const TxHashSetArchiveMessage& txHashSetArchiveMessage, MessageReader& messageReader);
 
 	const Config& m_config;
 	ConnectionManager& m_connectionManager;
 	PeerManager& m_peerManager;
 	IBlockChainServer& m_blockChainServer;
+	Connection& m_connection;
 };
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include "MessageReader.h"
+
+#include <Core/Serialization/ByteBuffer.h>
+#include <Core/Serialization/DeserializationException.h>
+#include <algorithm>
+#include <cstring>
+
+MessageReader::MessageReader(const Config& config, MessageBufferPool& bufferPool)
+	: m_config(config),
+	m_bufferPool(bufferPool),
+	m_receiveBuffer(bufferPool.Take(RECEIVE_BUFFER_SIZE)),
+	m_readPos(0),
+	m_writePos(0),
+	m_largePayloadRead(0)
+{
+
+}
+
+MessageReader::~MessageReader()
+{
+	ReleaseMessage();
+
+	m_bufferPool.Return(std::move(m_receiveBuffer));
+	m_bufferPool.Return(std::move(m_largePayload));
+}
+
+size_t MessageReader::Receive(const Socket& socket, const size_t maxBytes)
+{
+	ReleaseMessage();
+
+	// Payloads that don't fit in the receive buffer are received directly into their own buffer.
+	if (m_headerOpt.has_value() && m_headerOpt.value().GetMessageLength() > RECEIVE_BUFFER_SIZE)
+	{
+		const size_t bytesToRead = (std::min)(m_largePayload.size() - m_largePayloadRead, maxBytes);
+		const size_t bytesReceived = socket.ReceiveSome(&m_largePayload[m_largePayloadRead], bytesToRead);
+		m_largePayloadRead += bytesReceived;
+
+		return bytesReceived;
+	}
+
+	Compact();
+
+	const size_t bytesToRead = (std::min)(RECEIVE_BUFFER_SIZE - m_writePos, maxBytes);
+	const size_t bytesReceived = socket.ReceiveSome(&m_receiveBuffer[m_writePos], bytesToRead);
+	m_writePos += bytesReceived;
+
+	return bytesReceived;
+}
+
+const RawMessage* MessageReader::GetNextMessage()
+{
+	ReleaseMessage();
+
+	if (!m_headerOpt.has_value())
+	{
+		if (GetNumBuffered() < HEADER_SIZE)
+		{
+			return nullptr;
+		}
+
+		ByteBuffer byteBuffer(ByteView(&m_receiveBuffer[m_readPos], HEADER_SIZE));
+		MessageHeader header = MessageHeader::Deserialize(byteBuffer);
+		if (!header.IsValid(m_config))
+		{
+			throw DeserializationException();
+		}
+
+		m_readPos += HEADER_SIZE;
+
+		const size_t messageLength = header.GetMessageLength();
+		if (messageLength > RECEIVE_BUFFER_SIZE)
+		{
+			// Move whatever part of the payload has already arrived into the payload's own buffer.
+			m_largePayload = m_bufferPool.Take(messageLength);
+			m_largePayloadRead = (std::min)(GetNumBuffered(), messageLength);
+			memcpy(m_largePayload.data(), &m_receiveBuffer[m_readPos], m_largePayloadRead);
+			m_readPos += m_largePayloadRead;
+		}
+
+		m_headerOpt = std::make_optional<MessageHeader>(std::move(header));
+	}
+
+	const size_t messageLength = m_headerOpt.value().GetMessageLength();
+	if (messageLength > RECEIVE_BUFFER_SIZE)
+	{
+		if (m_largePayloadRead < messageLength)
+		{
+			return nullptr;
+		}
+
+		m_messageOpt.emplace(std::move(m_headerOpt.value()), ByteView(m_largePayload));
+	}
+	else
+	{
+		if (GetNumBuffered() < messageLength)
+		{
+			return nullptr;
+		}
+
+		// The payload stays in the receive buffer, which isn't written to or compacted until the message is released.
+		m_messageOpt.emplace(std::move(m_headerOpt.value()), ByteView(m_receiveBuffer.data() + m_readPos, messageLength));
+		m_readPos += messageLength;
+	}
+
+	m_headerOpt.reset();
+
+	return &m_messageOpt.value();
+}
+
+bool MessageReader::ReadRaw(const Socket& socket, const size_t numBytes, std::vector<unsigned char>& data)
+{
+	if (data.size() < numBytes)
+	{
+		data.resize(numBytes);
+	}
+
+	const size_t numBuffered = (std::min)(GetNumBuffered(), numBytes);
+	if (numBuffered > 0)
+	{
+		memcpy(data.data(), &m_receiveBuffer[m_readPos], numBuffered);
+		m_readPos += numBuffered;
+	}
+
+	size_t totalRead = numBuffered;
+	while (totalRead < numBytes)
+	{
+		const size_t bytesReceived = socket.ReceiveSome(&data[totalRead], numBytes - totalRead);
+		if (bytesReceived == 0)
+		{
+			return false;
+		}
+
+		totalRead += bytesReceived;
+	}
+
+	return true;
+}
+
+void MessageReader::ReleaseMessage()
+{
+	if (m_messageOpt.has_value())
+	{
+		m_messageOpt.reset();
+
+		if (!m_largePayload.empty())
+		{
+			m_bufferPool.Return(std::move(m_largePayload));
+			m_largePayload = std::vector<unsigned char>();
+			m_largePayloadRead = 0;
+		}
+	}
+}
+
+//
+// Moves the unread bytes to the front of the receive buffer when the message being received wouldn't fit in the remaining space.
+//
+void MessageReader::Compact()
+{
+	if (m_readPos == m_writePos)
+	{
+		m_readPos = 0;
+		m_writePos = 0;
+		return;
+	}
+
+	const size_t bytesNeeded = m_headerOpt.has_value() ? m_headerOpt.value().GetMessageLength() : HEADER_SIZE;
+	if (m_readPos > 0 && m_readPos + bytesNeeded > RECEIVE_BUFFER_SIZE)
+	{
+		const size_t numBuffered = GetNumBuffered();
+		memmove(m_receiveBuffer.data(), &m_receiveBuffer[m_readPos], numBuffered);
+		m_readPos = 0;
+		m_writePos = numBuffered;
+	}
+}
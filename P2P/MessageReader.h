@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Messages/RawMessage.h"
+#include "MessageBufferPool.h"
+
+#include <Config/Config.h>
+#include <Net/Socket.h>
+#include <memory>
+#include <optional>
+#include <vector>
+
+//
+// Frames messages from a connection's socket without blocking the I/O thread, and without copying their payloads.
+//
+// Bytes are received in bulk into a per-connection receive buffer, and each message is handed out as a view of its payload in that buffer.
+// The buffer is compacted (rather than wrapped) as it fills, so a buffered message is always contiguous.
+// Payloads too large for the receive buffer are received straight into a buffer taken from the MessageBufferPool.
+//
+class MessageReader
+{
+public:
+	MessageReader(const Config& config, MessageBufferPool& bufferPool);
+	~MessageReader();
+
+	//
+	// Receives up to maxBytes that have already arrived on the socket, and returns the number of bytes received.
+	// Returns 0 if the connection was closed.
+	//
+	size_t Receive(const Socket& socket, const size_t maxBytes);
+
+	//
+	// Returns the next complete message, or nullptr if none have been fully received.
+	// Throws DeserializationException if a message header is invalid.
+	// The message (and its payload) is only valid until the next call to Receive or GetNextMessage.
+	//
+	const RawMessage* GetNextMessage();
+
+	//
+	// Blocks until numBytes following the last message have been read, starting with any that have already been buffered.
+	// Used for data that's streamed after a message, like a TxHashSet archive.
+	//
+	bool ReadRaw(const Socket& socket, const size_t numBytes, std::vector<unsigned char>& data);
+
+private:
+	static const size_t HEADER_SIZE = 11;
+	static const size_t RECEIVE_BUFFER_SIZE = 256 * 1024;
+
+	inline size_t GetNumBuffered() const { return m_writePos - m_readPos; }
+	void ReleaseMessage();
+	void Compact();
+
+	const Config& m_config;
+	MessageBufferPool& m_bufferPool;
+
+	std::vector<unsigned char> m_receiveBuffer;
+	size_t m_readPos;
+	size_t m_writePos;
+
+	std::optional<MessageHeader> m_headerOpt;
+	std::vector<unsigned char> m_largePayload;
+	size_t m_largePayloadRead;
+
+	std::optional<RawMessage> m_messageOpt;
+};
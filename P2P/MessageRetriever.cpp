@@ -59,7 +59,7 @@ std::unique_ptr<RawMessage> MessageRetriever::RetrieveMessage(const ConnectedPee
 					if (bPayloadRetrieved)
 					{
 						connectedPeer.GetPeer().UpdateLastContactTime();
-						return std::make_unique<RawMessage>(std::move(RawMessage(std::move(messageHeader), payload)));
+						return std::make_unique<RawMessage>(std::move(messageHeader), std::move(payload));
 					}
 					else
 					{
@@ -8,14 +8,25 @@ MessageSender::MessageSender(const Config& config)
 
 bool MessageSender::Send(ConnectedPeer& connectedPeer, const IMessage& message) const
 {
-	Serializer serializer;
-	serializer.AppendByteVector(m_config.GetEnvironment().GetMagicBytes());
-	serializer.Append<uint8_t>((uint8_t)message.GetMessageType());
+	return connectedPeer.GetSocket().Send(*Serialize(message));
+}
 
+SerializedMessagePtr MessageSender::Serialize(const IMessage& message) const
+{
 	Serializer bodySerializer;
 	message.SerializeBody(bodySerializer);
-	serializer.Append<uint64_t>(bodySerializer.GetBytes().size());
-	serializer.AppendByteVector(bodySerializer.GetBytes());
+	const std::vector<unsigned char>& body = bodySerializer.GetBytes();
+
+	Serializer headerSerializer;
+	headerSerializer.AppendByteVector(m_config.GetEnvironment().GetMagicBytes());
+	headerSerializer.Append<uint8_t>((uint8_t)message.GetMessageType());
+	headerSerializer.Append<uint64_t>(body.size());
+	const std::vector<unsigned char>& header = headerSerializer.GetBytes();
+
+	std::vector<unsigned char> serialized;
+	serialized.reserve(header.size() + body.size());
+	serialized.insert(serialized.end(), header.cbegin(), header.cend());
+	serialized.insert(serialized.end(), body.cbegin(), body.cend());
 
-	return connectedPeer.GetSocket().Send(serializer.GetBytes());
+	return std::make_shared<const std::vector<unsigned char>>(std::move(serialized));
 }
\ No newline at end of file
@@ -4,6 +4,13 @@
 
 #include <P2P/ConnectedPeer.h>
 #include <Config/Config.h>
+#include <memory>
+#include <vector>
+
+//
+// A fully serialized message (header and body). Immutable, so a single copy can be queued on every connection it's sent to.
+//
+typedef std::shared_ptr<const std::vector<unsigned char>> SerializedMessagePtr;
 
 class MessageSender
 {
@@ -12,6 +19,8 @@ public:
 
 	bool Send(ConnectedPeer& connectedPeer, const IMessage& message) const;
 
+	SerializedMessagePtr Serialize(const IMessage& message) const;
+
 private:
 	const Config& m_config;
-};
\ No newline at end of file
+};
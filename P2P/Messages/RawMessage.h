@@ -2,20 +2,31 @@
 
 #include "MessageHeader.h"
 
+#include <Core/Serialization/ByteView.h>
 #include <vector>
 
+//
+// A message header and its undeserialized payload.
+// The payload is either owned by the message, or is a view of a buffer owned by whoever received the message (see MessageReader),
+// in which case the message must not outlive that buffer.
+//
 class RawMessage
 {
 public:
 	//
 	// Constructors
 	//
-	RawMessage(MessageHeader&& messageHeader, const std::vector<unsigned char>& payload)
-		: m_messageHeader(messageHeader), m_payload(payload)
+	RawMessage(MessageHeader&& messageHeader, std::vector<unsigned char>&& payload)
+		: m_messageHeader(std::move(messageHeader)), m_ownedPayload(std::move(payload)), m_payload(m_ownedPayload)
 	{
 
 	}
-	RawMessage(const RawMessage& other) = default;
+	RawMessage(MessageHeader&& messageHeader, const ByteView& payload)
+		: m_messageHeader(std::move(messageHeader)), m_payload(payload)
+	{
+
+	}
+	RawMessage(const RawMessage& other) = delete;
 	RawMessage(RawMessage&& other) noexcept = default;
 
 	//
@@ -26,16 +37,19 @@ public:
 	//
 	// Operators
 	//
-	RawMessage& operator=(const RawMessage& other) = default;
+	RawMessage& operator=(const RawMessage& other) = delete;
 	RawMessage& operator=(RawMessage&& other) noexcept = default;
 
 	//
 	// Getters
 	//
 	inline const MessageHeader& GetMessageHeader() const { return m_messageHeader; }
-	inline const std::vector<unsigned char>& GetPayload() const { return m_payload; }
+	inline const ByteView& GetPayload() const { return m_payload; }
 
 private:
 	MessageHeader m_messageHeader;
-	std::vector<unsigned char> m_payload;
+
+	// Moving a vector keeps its data pointer, so the view stays valid when the message is moved.
+	std::vector<unsigned char> m_ownedPayload;
+	ByteView m_payload;
 };
\ No newline at end of file
@@ -1,10 +1,11 @@
 #include "Pipeline.h"
 #include "ConnectionManager.h"
 
-#include <Common/Util/ThreadUtil.h>
 #include <Infrastructure/ThreadManager.h>
 #include <Infrastructure/Logger.h>
 #include <async++.h>
+#include <algorithm>
+#include <iterator>
 
 Pipeline::Pipeline(const Config& config, ConnectionManager& connectionManager, IBlockChainServer& blockChainServer)
 	: m_config(config), m_connectionManager(connectionManager), m_blockChainServer(blockChainServer)
@@ -33,7 +34,15 @@ void Pipeline::Start()
 
 void Pipeline::Stop()
 {
+	// Set while holding the queue mutexes, so neither thread can miss the notification between checking m_terminate and waiting.
+	std::unique_lock<std::mutex> blockLock(m_blockMutex);
+	std::unique_lock<std::mutex> transactionLock(m_transactionMutex);
 	m_terminate = true;
+	transactionLock.unlock();
+	blockLock.unlock();
+
+	m_blockCondition.notify_all();
+	m_transactionCondition.notify_all();
 
 	if (m_blockThread.joinable())
 	{
@@ -56,58 +65,69 @@ void Pipeline::Thread_ProcessBlocks(Pipeline& pipeline)
 	ThreadManagerAPI::SetCurrentThreadName("BLOCK_PIPE_THREAD");
 	LoggerAPI::LogTrace("Pipeline::Thread_ProcessBlocks() - BEGIN");
 
+	bool orphanProcessed = false;
 	while (!pipeline.m_terminate)
 	{
-		if (pipeline.m_blocksToProcess.size() > 0)
+		std::unique_lock<std::mutex> lockGuard(pipeline.m_blockMutex);
+
+		// Orphans can become processable when blocks or headers are added outside of the pipeline, so keep checking for them while idle.
+		if (!orphanProcessed)
 		{
-			const size_t blocksToProcess = std::min((size_t)8, pipeline.m_blocksToProcess.size());
-			if (blocksToProcess == 1)
-			{
-				const BlockEntry& blockEntry = pipeline.m_blocksToProcess.front();
+			pipeline.m_blockCondition.wait_for(lockGuard, std::chrono::milliseconds(30), [&pipeline] { return pipeline.m_terminate || !pipeline.m_blocksToProcess.empty(); });
+		}
 
-				const EBlockChainStatus status = pipeline.m_blockChainServer.AddBlock(blockEntry.block);
-				if (status == EBlockChainStatus::INVALID)
-				{
-					pipeline.m_connectionManager.BanConnection(blockEntry.connectionId, EBanReason::BadBlock);
-				}
+		// The hashes stay in m_blocksInPipeline until the blocks have been processed.
+		const size_t blocksToProcess = (std::min)((size_t)8, pipeline.m_blocksToProcess.size());
+		std::vector<BlockEntry> blockEntries(
+			std::make_move_iterator(pipeline.m_blocksToProcess.begin()),
+			std::make_move_iterator(pipeline.m_blocksToProcess.begin() + blocksToProcess)
+		);
+		pipeline.m_blocksToProcess.erase(pipeline.m_blocksToProcess.begin(), pipeline.m_blocksToProcess.begin() + blocksToProcess);
+		lockGuard.unlock();
+
+		if (blockEntries.size() == 1)
+		{
+			const BlockEntry& blockEntry = blockEntries.front();
 
-				std::unique_lock<std::shared_mutex> writeLock(pipeline.m_blockMutex);
-				pipeline.m_blocksToProcess.pop_front();
+			const EBlockChainStatus status = pipeline.m_blockChainServer.AddBlock(blockEntry.block);
+			if (status == EBlockChainStatus::INVALID)
+			{
+				pipeline.m_connectionManager.BanConnection(blockEntry.connectionId, EBanReason::BadBlock);
 			}
-			else
+		}
+		else if (blockEntries.size() > 1)
+		{
+			// Using when_any to find task which finishes first
+			std::vector<async::task<void>> tasks;
+			for (const BlockEntry& blockEntry : blockEntries)
 			{
-				// Using when_any to find task which finishes first
-				std::vector<async::task<void>> tasks;
-				for (size_t i = 0; i < blocksToProcess; i++)
+				tasks.push_back(async::spawn([&pipeline, &blockEntry]
 				{
-					const BlockEntry& blockEntry = pipeline.m_blocksToProcess.at(i);
-					tasks.push_back(async::spawn([&pipeline, blockEntry] 
+					const EBlockChainStatus status = pipeline.m_blockChainServer.AddBlock(blockEntry.block);
+					if (status == EBlockChainStatus::INVALID)
 					{
-						const EBlockChainStatus status = pipeline.m_blockChainServer.AddBlock(blockEntry.block);
-						if (status == EBlockChainStatus::INVALID)
-						{
-							pipeline.m_connectionManager.BanConnection(blockEntry.connectionId, EBanReason::BadBlock);
-						}
-					}));
-				}
-
-				for (auto& task : tasks)
-				{
-					task.wait();
-				}
+						pipeline.m_connectionManager.BanConnection(blockEntry.connectionId, EBanReason::BadBlock);
+					}
+				}));
+			}
 
-				std::unique_lock<std::shared_mutex> writeLock(pipeline.m_blockMutex);
-				for (size_t i = 0; i < blocksToProcess; i++)
-				{
-					pipeline.m_blocksToProcess.pop_front();
-				}
+			for (auto& task : tasks)
+			{
+				task.wait();
 			}
 		}
-		
-		if (!pipeline.m_blockChainServer.ProcessNextOrphanBlock())
+
+		if (!blockEntries.empty())
 		{
-			ThreadUtil::SleepFor(std::chrono::milliseconds(30), pipeline.m_terminate);
+			lockGuard.lock();
+			for (const BlockEntry& blockEntry : blockEntries)
+			{
+				pipeline.m_blocksInPipeline.erase(blockEntry.block.GetHash());
+			}
+			lockGuard.unlock();
 		}
+
+		orphanProcessed = pipeline.m_blockChainServer.ProcessNextOrphanBlock();
 	}
 
 	LoggerAPI::LogTrace("Pipeline::Thread_ProcessBlocks() - END");
@@ -115,29 +135,45 @@ void Pipeline::Thread_ProcessBlocks(Pipeline& pipeline)
 
 bool Pipeline::AddBlockToProcess(const uint64_t connectionId, const FullBlock& block)
 {
-	if (!IsProcessingBlock(block.GetHash()))
+	std::unique_lock<std::mutex> lockGuard(m_blockMutex);
+	if (m_blocksInPipeline.count(block.GetHash()) > 0)
 	{
-		std::unique_lock<std::shared_mutex> writeLock(m_blockMutex);
-		m_blocksToProcess.emplace_back(BlockEntry(connectionId, block));
-		return true;
+		return false;
 	}
 
-	return false;
-}
-
-bool Pipeline::IsProcessingBlock(const Hash& hash) const
-{
-	std::shared_lock<std::shared_mutex> readLock(m_blockMutex);
-
-	for (auto iter = m_blocksToProcess.cbegin(); iter != m_blocksToProcess.cend(); iter++)
+	if (m_blocksToProcess.size() >= MAX_BLOCKS_TO_PROCESS)
 	{
-		if (iter->block.GetHash() == hash)
+		LoggerAPI::LogDebug("Pipeline::AddBlockToProcess - Queue is full. Dropping block " + block.GetBlockHeader().FormatHash());
+
+		// Blocks that are never requested again would otherwise stay in the set forever.
+		if (m_droppedBlocks.size() >= MAX_BLOCKS_TO_PROCESS)
 		{
-			return true;
+			m_droppedBlocks.clear();
 		}
+
+		m_droppedBlocks.insert(block.GetHash());
+		return false;
 	}
 
-	return false;
+	m_droppedBlocks.erase(block.GetHash());
+	m_blocksInPipeline.insert(block.GetHash());
+	m_blocksToProcess.emplace_back(BlockEntry(connectionId, block));
+	lockGuard.unlock();
+
+	m_blockCondition.notify_one();
+	return true;
+}
+
+bool Pipeline::IsProcessingBlock(const Hash& hash) const
+{
+	std::lock_guard<std::mutex> lockGuard(m_blockMutex);
+	return m_blocksInPipeline.count(hash) > 0;
+}
+
+bool Pipeline::TakeDroppedBlock(const Hash& hash)
+{
+	std::lock_guard<std::mutex> lockGuard(m_blockMutex);
+	return m_droppedBlocks.erase(hash) > 0;
 }
 
 void Pipeline::Thread_ProcessTransactions(Pipeline& pipeline)
@@ -145,21 +181,23 @@ void Pipeline::Thread_ProcessTransactions(Pipeline& pipeline)
 	ThreadManagerAPI::SetCurrentThreadName("TXN_PIPE_THREAD");
 	LoggerAPI::LogTrace("Pipeline::Thread_ProcessTransactions() - BEGIN");
 
+	std::unique_lock<std::mutex> lockGuard(pipeline.m_transactionMutex);
 	while (!pipeline.m_terminate)
 	{
-		if (pipeline.m_transactionsToProcess.size() > 0)
+		pipeline.m_transactionCondition.wait(lockGuard, [&pipeline] { return pipeline.m_terminate || !pipeline.m_transactionsToProcess.empty(); });
+		if (pipeline.m_terminate)
 		{
-			const TxEntry& txEntry = pipeline.m_transactionsToProcess.front();
+			break;
+		}
 
-			pipeline.m_blockChainServer.AddTransaction(txEntry.transaction, txEntry.poolType);
+		const TxEntry txEntry = std::move(pipeline.m_transactionsToProcess.front());
+		pipeline.m_transactionsToProcess.pop_front();
+		lockGuard.unlock();
 
-			std::unique_lock<std::shared_mutex> writeLock(pipeline.m_transactionMutex);
-			pipeline.m_transactionsToProcess.pop_front();
-		}
-		else
-		{
-			ThreadUtil::SleepFor(std::chrono::milliseconds(30), pipeline.m_terminate);
-		}
+		pipeline.m_blockChainServer.AddTransaction(txEntry.transaction, txEntry.poolType);
+
+		lockGuard.lock();
+		pipeline.m_transactionsInPipeline.erase(txEntry.transaction.GetHash());
 	}
 
 	LoggerAPI::LogTrace("Pipeline::Thread_ProcessTransactions() - END");
@@ -167,29 +205,30 @@ void Pipeline::Thread_ProcessTransactions(Pipeline& pipeline)
 
 bool Pipeline::AddTransactionToProcess(const uint64_t connectionId, const Transaction& transaction, const EPoolType poolType)
 {
-	if (!IsProcessingTransaction(transaction.GetHash()))
+	std::unique_lock<std::mutex> lockGuard(m_transactionMutex);
+	if (m_transactionsInPipeline.count(transaction.GetHash()) > 0)
+	{
+		return false;
+	}
+
+	if (m_transactionsToProcess.size() >= MAX_TRANSACTIONS_TO_PROCESS)
 	{
-		std::unique_lock<std::shared_mutex> writeLock(m_transactionMutex);
-		m_transactionsToProcess.emplace_back(TxEntry(connectionId, transaction, poolType));
-		return true;
+		LoggerAPI::LogDebug("Pipeline::AddTransactionToProcess - Queue is full. Dropping transaction.");
+		return false;
 	}
 
-	return false;
+	m_transactionsInPipeline.insert(transaction.GetHash());
+	m_transactionsToProcess.emplace_back(TxEntry(connectionId, transaction, poolType));
+	lockGuard.unlock();
+
+	m_transactionCondition.notify_one();
+	return true;
 }
 
 bool Pipeline::IsProcessingTransaction(const Hash& hash) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_transactionMutex);
-
-	for (auto iter = m_transactionsToProcess.cbegin(); iter != m_transactionsToProcess.cend(); iter++)
-	{
-		if (iter->transaction.GetHash() == hash)
-		{
-			return true;
-		}
-	}
-
-	return false;
+	std::lock_guard<std::mutex> lockGuard(m_transactionMutex);
+	return m_transactionsInPipeline.count(hash) > 0;
 }
 
 void Pipeline::Thread_ProcessTxHashSet(Pipeline& pipeline, const uint64_t connectionId, const Hash blockHash, const std::string path)
@@ -4,13 +4,22 @@
 #include <TxPool/PoolType.h>
 #include <Crypto/Hash.h>
 #include <deque>
-#include <shared_mutex>
+#include <unordered_set>
+#include <mutex>
+#include <condition_variable>
 #include <thread>
 #include <atomic>
 
 // Forward Declarations
 class ConnectionManager;
 
+//
+// Processes blocks and transactions received from peers on dedicated threads, so the I/O threads don't wait on validation.
+//
+// Each queue is bounded, and wakes its thread as soon as something is added to it.
+// The hashes of queued blocks and transactions, including those still being processed, are kept in a set,
+// so duplicates can be detected without scanning the queue.
+//
 class Pipeline
 {
 public:
@@ -19,15 +28,30 @@ public:
 	void Start();
 	void Stop();
 
+	//
+	// Returns false if the block is already in the pipeline, or the queue is full.
+	//
 	bool AddBlockToProcess(const uint64_t connectionId, const FullBlock& block);
 	bool IsProcessingBlock(const Hash& hash) const;
 
+	//
+	// Returns true if the block was received, but dropped because the queue was full, and hasn't been added since.
+	// The peer that sent it isn't to blame for the request timing out. Only returns true once per drop.
+	//
+	bool TakeDroppedBlock(const Hash& hash);
+
+	//
+	// Returns false if the transaction is already in the pipeline, or the queue is full.
+	//
 	bool AddTransactionToProcess(const uint64_t connectionId, const Transaction& transaction, const EPoolType poolType);
 	bool IsProcessingTransaction(const Hash& hash) const;
 
 	bool AddTxHashSetToProcess(const uint64_t connectionId, const Hash& blockHash, const std::string& path);
 
 private:
+	static const size_t MAX_BLOCKS_TO_PROCESS = 512;
+	static const size_t MAX_TRANSACTIONS_TO_PROCESS = 4096;
+
 	const Config& m_config;
 	ConnectionManager& m_connectionManager;
 	IBlockChainServer& m_blockChainServer;
@@ -35,7 +59,8 @@ private:
 
 	// Blocks
 	static void Thread_ProcessBlocks(Pipeline& pipeline);
-	mutable std::shared_mutex m_blockMutex;
+	mutable std::mutex m_blockMutex;
+	std::condition_variable m_blockCondition;
 	std::thread m_blockThread;
 	struct BlockEntry
 	{
@@ -49,10 +74,13 @@ private:
 		FullBlock block;
 	};
 	std::deque<BlockEntry> m_blocksToProcess;
+	std::unordered_set<Hash> m_blocksInPipeline;
+	std::unordered_set<Hash> m_droppedBlocks;
 
 	// Transactions
 	static void Thread_ProcessTransactions(Pipeline& pipeline);
-	mutable std::shared_mutex m_transactionMutex;
+	mutable std::mutex m_transactionMutex;
+	std::condition_variable m_transactionCondition;
 	std::thread m_transactionThread;
 	struct TxEntry
 	{
@@ -67,6 +95,7 @@ private:
 		EPoolType poolType;
 	};
 	std::deque<TxEntry> m_transactionsToProcess;
+	std::unordered_set<Hash> m_transactionsInPipeline;
 
 	// TxHashSet
 	static void Thread_ProcessTxHashSet(Pipeline& pipeline, const uint64_t connectionId, const Hash blockHash, const std::string path);
@@ -4,6 +4,7 @@
 
 #include <BlockChain/BlockChainServer.h>
 #include <Infrastructure/Logger.h>
+#include <algorithm>
 #include <Common/Util/StringUtil.h>
 
 BlockSyncer::BlockSyncer(ConnectionManager& connectionManager, IBlockChainServer& blockChainServer)
@@ -98,13 +99,26 @@ bool BlockSyncer::RequestBlocks()
 	LoggerAPI::LogTrace("BlockSyncer::RequestBlocks - Requesting blocks.");
 
 	std::vector<uint64_t> mostWorkPeers = m_connectionManager.GetMostWorkPeers();
-	const uint64_t numPeers = mostWorkPeers.size();
 	if (mostWorkPeers.empty())
 	{
 		LoggerAPI::LogDebug("BlockSyncer::RequestBlocks - No most-work peers found.");
 		return false;
 	}
 
+	// Requests queued behind a full send queue would likely time out, and get the peer banned for being slow.
+	ConnectionManager& connectionManager = m_connectionManager;
+	mostWorkPeers.erase(
+		std::remove_if(mostWorkPeers.begin(), mostWorkPeers.end(), [&connectionManager](const uint64_t connectionId) { return connectionManager.IsSendQueueFull(connectionId); }),
+		mostWorkPeers.end()
+	);
+
+	const uint64_t numPeers = mostWorkPeers.size();
+	if (mostWorkPeers.empty())
+	{
+		LoggerAPI::LogDebug("BlockSyncer::RequestBlocks - Send queues of all most-work peers are full.");
+		return false;
+	}
+
 	const uint64_t numBlocksNeeded = 16 * numPeers;
 	std::vector<std::pair<uint64_t, Hash>> blocksNeeded = m_blockChainServer.GetBlocksNeeded(2 * numBlocksNeeded);
 	if (blocksNeeded.empty())
@@ -131,8 +145,12 @@ bool BlockSyncer::RequestBlocks()
 		{
 			if (m_slowPeers.count(iter->second.PEER_ID) > 0 || iter->second.TIMEOUT < std::chrono::system_clock::now())
 			{
-				m_connectionManager.BanConnection(iter->second.PEER_ID, EBanReason::FraudHeight);
-				m_slowPeers.insert(iter->second.PEER_ID);
+				// The peer may have delivered the block, only for it to be dropped because the pipeline was full.
+				if (!m_connectionManager.GetPipeline().TakeDroppedBlock(blocksNeeded[blockIndex].second))
+				{
+					m_connectionManager.BanConnection(iter->second.PEER_ID, EBanReason::FraudHeight);
+					m_slowPeers.insert(iter->second.PEER_ID);
+				}
 
 				blocksToRequest.emplace_back(blocksNeeded[blockIndex]);
 			}
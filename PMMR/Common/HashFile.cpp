@@ -5,23 +5,26 @@
 #include <Infrastructure/Logger.h>
 
 HashFile::HashFile(const std::string& path)
-	: m_file(path)
+	: m_file(path), m_peaksLoaded(false), m_peaksSize(0)
 {
 
 }
 
 bool HashFile::Load()
 {
+	m_peaksLoaded = false;
 	return m_file.Load();
 }
 
 bool HashFile::Rewind(const uint64_t size)
 {
+	m_peaksLoaded = false;
 	return m_file.Rewind(size * HASH_SIZE);
 }
 
 bool HashFile::Discard()
 {
+	m_peaksLoaded = false;
 	return m_file.Discard();
 }
 
@@ -37,16 +40,63 @@ uint64_t HashFile::GetSize() const
 
 Hash HashFile::GetHashAt(const uint64_t mmrIndex) const
 {
-	std::vector<unsigned char> data;
-	if (m_file.Read(mmrIndex * HASH_SIZE, HASH_SIZE, data))
+	const ByteView hashView = GetHashViewAt(mmrIndex);
+	if (hashView.size() == HASH_SIZE)
 	{
-		return Hash(std::move(data));
+		return Hash(hashView.data());
 	}
 
 	return ZERO_HASH;
 }
 
+ByteView HashFile::GetHashViewAt(const uint64_t mmrIndex) const
+{
+	return m_file.ReadView(mmrIndex * HASH_SIZE, HASH_SIZE);
+}
+
 void HashFile::AddHash(const Hash& hash)
 {
 	m_file.Append(hash.GetData());
+
+	if (m_peaksLoaded)
+	{
+		// A parent's children are always the two rightmost peaks.
+		if (MMRUtil::GetHeight(m_peaksSize) > 0)
+		{
+			m_peaks.pop_back();
+			m_peaks.pop_back();
+		}
+
+		m_peaks.push_back(hash);
+		++m_peaksSize;
+	}
+}
+
+const std::vector<Hash>& HashFile::LoadPeaks(const uint64_t mmrSize, const PruneList* pPruneList)
+{
+	if (!m_peaksLoaded || m_peaksSize != mmrSize)
+	{
+		m_peaks.clear();
+
+		const std::vector<uint64_t> peakIndices = MMRUtil::GetPeakIndices(mmrSize);
+		for (const uint64_t peakIndex : peakIndices)
+		{
+			m_peaks.push_back(MMRHashUtil::GetHashAt(*this, peakIndex, pPruneList));
+		}
+
+		m_peaksSize = mmrSize;
+		m_peaksLoaded = true;
+	}
+
+	return m_peaks;
+}
+
+const std::vector<Hash>* HashFile::GetPeaks(const uint64_t mmrSize) const
+{
+	if (m_peaksLoaded && m_peaksSize == mmrSize)
+	{
+		return &m_peaks;
+	}
+
+	return nullptr;
 }
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include <Core/File.h>
 #include <Crypto/Hash.h>
 #include <string>
+#include <vector>
+
+class PruneList;
 
 class HashFile
 {
@@ -15,11 +18,37 @@ public:
 	bool Discard();
 
 	uint64_t GetSize() const;
+	File::PendingFlush GetPendingFlush() const { return m_file.GetPendingFlush(); }
 	Hash GetHashAt(const uint64_t mmrIndex) const;
+
+	//
+	// Returns a view of the 32 byte hash without copying it out of the file.
+	// The view is invalidated by AddHash, Flush, Rewind, and Discard.
+	//
+	ByteView GetHashViewAt(const uint64_t mmrIndex) const;
 	
+	//
+	// Appends the hash. If the peaks are loaded, the hash becomes the rightmost peak,
+	// replacing its two children if it's a parent.
+	//
 	void AddHash(const Hash& hash);
 
+	//
+	// The peaks of the MMR are kept in memory, so appending and calculating the current root don't read them from the file.
+	// LoadPeaks reads the peaks (left to right) of the MMR with the given size (# of nodes, including pruned ones),
+	// which must be the size of the whole file. It only reads the file if the peaks were invalidated by Load, Rewind, or Discard.
+	//
+	const std::vector<Hash>& LoadPeaks(const uint64_t mmrSize, const PruneList* pPruneList);
+
+	//
+	// Returns the loaded peaks if they belong to an MMR of the given size. Otherwise, returns nullptr.
+	//
+	const std::vector<Hash>* GetPeaks(const uint64_t mmrSize) const;
+
 private:
-	// TODO: Store peaks in memory
 	File m_file;
+
+	bool m_peaksLoaded;
+	uint64_t m_peaksSize;
+	std::vector<Hash> m_peaks;
 };
\ No newline at end of file
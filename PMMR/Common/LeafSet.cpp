@@ -32,6 +32,12 @@ void LeafSet::Rewind(const uint64_t size, const Roaring& positionsToAdd)
 	m_bitmap -= positionsToRemove;
 }
 
+void LeafSet::ApplyChanges(const Roaring& added, const Roaring& removed)
+{
+	m_bitmap |= added;
+	m_bitmap -= removed;
+}
+
 bool LeafSet::Contains(const uint64_t position) const
 {
 	return m_bitmap.contains((uint32_t)position + 1);
@@ -96,24 +102,13 @@ void LeafSet::Discard()
 }
 
 // Calculate the set of pruned positions up to the cutoff size.
-// Uses both the LeafSet and the PruneList to determine prunedness.
+// Uses both the LeafSet (as of the last flush) and the PruneList to determine prunedness.
+// Positions removed after the cutoff (rewindRmPos) are treated as unspent, since a rewind could still add them back.
 Roaring LeafSet::CalculatePrunedPositions(const uint64_t cutoffSize, const Roaring& rewindRmPos, const PruneList& pruneList) const
 {
-	Roaring bitmap = m_bitmap;
-
-	// First remove positions from LeafSet that were added after the point we are rewinding to.
-	Roaring rewindAddedPositions;
-	rewindAddedPositions.addRange(cutoffSize, m_bitmap.maximum());
-	bitmap -= rewindAddedPositions;
-
-	// Then add back output positions to the LeafSet that were removed.
-	bitmap |= rewindRmPos;
+	const Roaring unspent = m_bitmapBackup | rewindRmPos;
 
-	// Invert bitmap for the leaf pos and return the resulting bitmap.
-	const Roaring unpruned = CalculateUnprunedPositions(cutoffSize, pruneList);
-	bitmap.flip(0, cutoffSize);
-	
-	return bitmap & unpruned;
+	return CalculateUnprunedPositions(cutoffSize, pruneList) - unspent;
 }
 
 // Calculate the set of unpruned leaves up to the cutoff size.
@@ -128,5 +123,5 @@ Roaring LeafSet::CalculateUnprunedPositions(const uint64_t cutoffSize, const Pru
 		}
 	}
 
-	return Roaring(unprunedPositions.size(), &unprunedPositions[0]);
+	return Roaring(unprunedPositions.size(), unprunedPositions.data());
 }
\ No newline at end of file
@@ -21,6 +21,17 @@ public:
 	void Discard();
 	bool Snapshot(const Hash& blockHash);
 
+	//
+	// Raw bitmap values added and removed since the last Flush.
+	//
+	Roaring GetAddedSinceFlush() const { return m_bitmap - m_bitmapBackup; }
+	Roaring GetRemovedSinceFlush() const { return m_bitmapBackup - m_bitmap; }
+
+	//
+	// Applies raw bitmap changes, as returned by GetAddedSinceFlush and GetRemovedSinceFlush.
+	//
+	void ApplyChanges(const Roaring& added, const Roaring& removed);
+
 	Roaring CalculatePrunedPositions(const uint64_t cutoffSize, const Roaring& rewindRmPos, const PruneList& pruneList) const;
 
 private:
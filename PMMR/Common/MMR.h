@@ -28,6 +28,12 @@ public:
 	//
 	virtual std::vector<Hash> GetLastLeafHashes(const uint64_t numHashes) const = 0;
 
+	//
+	// Verifies that the hash of every unpruned parent in the range [firstMMRIndex, lastMMRIndex) is the hash of its children.
+	// Disjoint ranges can be validated concurrently, as long as the MMR is not being modified.
+	//
+	virtual bool ValidateHashes(const uint64_t firstMMRIndex, const uint64_t lastMMRIndex) const = 0;
+
 	//
 	// Flushes all working changes to disk.
 	//
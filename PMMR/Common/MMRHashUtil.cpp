@@ -3,6 +3,7 @@
 
 #include <Crypto/Crypto.h>
 #include <Core/Serialization/Serializer.h>
+#include <Infrastructure/Logger.h>
 
 void MMRHashUtil::AddHashes(HashFile& hashFile, const std::vector<unsigned char>& serializedLeaf, const PruneList* pPruneList)
 {
@@ -13,23 +14,25 @@ void MMRHashUtil::AddHashes(HashFile& hashFile, const std::vector<unsigned char>
 		position += pPruneList->GetTotalShift();
 	}
 
+	// The siblings of the new nodes are always peaks, so they're taken from memory instead of the file.
+	const std::vector<Hash>& peaks = hashFile.LoadPeaks(position, pPruneList);
+
 	// Add in the new leaf hash
 	const Hash leafHash = HashLeafWithIndex(serializedLeaf, position);
 	hashFile.AddHash(leafHash);
 
 	// Add parent hashes
-	uint64_t peak = 1;
 	while (MMRUtil::GetHeight(position + 1) > 0)
 	{
-		const uint64_t leftSiblingPosition = (position + 1) - (2 * peak);
-
-		const Hash leftHash = GetHashAt(hashFile, leftSiblingPosition, pPruneList);
-		const Hash rightHash = GetHashAt(hashFile, position, pPruneList);
+		if (peaks.size() < 2)
+		{
+			LoggerAPI::LogError("MMRHashUtil::AddHashes - Missing peaks at position " + std::to_string(position));
+			return;
+		}
 
 		++position;
-		peak *= 2;
 
-		const Hash parentHash = HashParentWithIndex(leftHash, rightHash, position);
+		const Hash parentHash = HashParentWithIndex(peaks[peaks.size() - 2], peaks.back(), position);
 		hashFile.AddHash(parentHash);
 	}
 }
@@ -41,6 +44,12 @@ Hash MMRHashUtil::Root(const HashFile& hashFile, const uint64_t size, const Prun
 		return ZERO_HASH;
 	}
 
+	const std::vector<Hash>* pPeaks = hashFile.GetPeaks(size);
+	if (pPeaks != nullptr)
+	{
+		return BagPeaks(*pPeaks, size);
+	}
+
 	Hash hash = ZERO_HASH;
 	const std::vector<uint64_t> peakIndices = MMRUtil::GetPeakIndices(size);
 	for (auto iter = peakIndices.crbegin(); iter != peakIndices.crend(); iter++)
@@ -63,6 +72,27 @@ Hash MMRHashUtil::Root(const HashFile& hashFile, const uint64_t size, const Prun
 	return hash;
 }
 
+Hash MMRHashUtil::BagPeaks(const std::vector<Hash>& peakHashes, const uint64_t size)
+{
+	Hash hash = ZERO_HASH;
+	for (auto iter = peakHashes.crbegin(); iter != peakHashes.crend(); iter++)
+	{
+		if (*iter != ZERO_HASH)
+		{
+			if (hash == ZERO_HASH)
+			{
+				hash = *iter;
+			}
+			else
+			{
+				hash = HashParentWithIndex(*iter, hash, size);
+			}
+		}
+	}
+
+	return hash;
+}
+
 Hash MMRHashUtil::GetHashAt(const HashFile& hashFile, const uint64_t mmrIndex, const PruneList* pPruneList)
 {
 	if (pPruneList != nullptr)
@@ -83,6 +113,23 @@ Hash MMRHashUtil::GetHashAt(const HashFile& hashFile, const uint64_t mmrIndex, c
 	}
 }
 
+ByteView MMRHashUtil::GetHashViewAt(const HashFile& hashFile, const uint64_t mmrIndex, const PruneList* pPruneList)
+{
+	if (pPruneList != nullptr)
+	{
+		if (pPruneList->IsCompacted(mmrIndex))
+		{
+			return ByteView();
+		}
+
+		return hashFile.GetHashViewAt(mmrIndex - pPruneList->GetShift(mmrIndex));
+	}
+	else
+	{
+		return hashFile.GetHashViewAt(mmrIndex);
+	}
+}
+
 uint64_t MMRHashUtil::GetShiftedIndex(const uint64_t mmrIndex, const PruneList* pPruneList)
 {
 	if (pPruneList != nullptr)
@@ -141,4 +188,69 @@ Hash MMRHashUtil::HashParentWithIndex(const Hash& leftChild, const Hash& rightCh
 	serializer.AppendBigInteger<32>(leftChild);
 	serializer.AppendBigInteger<32>(rightChild);
 	return Crypto::Blake2b(serializer.GetBytes());
+}
+
+bool MMRHashUtil::ValidateParentHashes(const HashFile& hashFile, const PruneList* pPruneList, const uint64_t firstMMRIndex, const uint64_t lastMMRIndex)
+{
+	// Parents are validated in batches, so their hashes can be calculated several at a time.
+	static const size_t BATCH_SIZE = 1024;
+
+	std::vector<uint64_t> parentIndices;
+	parentIndices.reserve(BATCH_SIZE);
+
+	Serializer serializer(BATCH_SIZE * PARENT_MESSAGE_SIZE);
+	for (uint64_t mmrIndex = firstMMRIndex; mmrIndex < lastMMRIndex; mmrIndex++)
+	{
+		const uint64_t height = MMRUtil::GetHeight(mmrIndex);
+		if (height == 0)
+		{
+			continue;
+		}
+
+		// Hashes are read in place from the mmap, so nothing is copied unless both children are present.
+		const ByteView parentHash = GetHashViewAt(hashFile, mmrIndex, pPruneList);
+		if (parentHash.empty())
+		{
+			continue;
+		}
+
+		const ByteView leftHash = GetHashViewAt(hashFile, MMRUtil::GetLeftChildIndex(mmrIndex, height), pPruneList);
+		const ByteView rightHash = GetHashViewAt(hashFile, MMRUtil::GetRightChildIndex(mmrIndex), pPruneList);
+		if (!leftHash.empty() && !rightHash.empty())
+		{
+			serializer.Append<uint64_t>(mmrIndex);
+			serializer.AppendBigInteger<32>(Hash(leftHash.data()));
+			serializer.AppendBigInteger<32>(Hash(rightHash.data()));
+			parentIndices.push_back(mmrIndex);
+
+			if (parentIndices.size() == BATCH_SIZE)
+			{
+				if (!ValidateParentBatch(hashFile, pPruneList, parentIndices, serializer.GetBytes()))
+				{
+					return false;
+				}
+
+				parentIndices.clear();
+				serializer = Serializer(BATCH_SIZE * PARENT_MESSAGE_SIZE);
+			}
+		}
+	}
+
+	return ValidateParentBatch(hashFile, pPruneList, parentIndices, serializer.GetBytes());
+}
+
+bool MMRHashUtil::ValidateParentBatch(const HashFile& hashFile, const PruneList* pPruneList, const std::vector<uint64_t>& parentIndices, const std::vector<unsigned char>& messages)
+{
+	const std::vector<Hash> expectedHashes = Crypto::Blake2bBatch(messages, PARENT_MESSAGE_SIZE);
+	for (size_t i = 0; i < parentIndices.size(); i++)
+	{
+		const ByteView parentHash = GetHashViewAt(hashFile, parentIndices[i], pPruneList);
+		if (memcmp(expectedHashes[i].data(), parentHash.data(), HASH_SIZE) != 0)
+		{
+			LoggerAPI::LogError("MMRHashUtil::ValidateParentHashes - Invalid parent hash at index " + std::to_string(parentIndices[i]));
+			return false;
+		}
+	}
+
+	return true;
 }
\ No newline at end of file
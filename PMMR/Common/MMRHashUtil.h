@@ -11,11 +11,18 @@ class MMRHashUtil
 public:
 	static void AddHashes(HashFile& hashFile, const std::vector<unsigned char>& serializedLeaf, const PruneList* pPruneList);
 	static Hash Root(const HashFile& hashFile, const uint64_t size, const PruneList* pPruneList);
+	static Hash BagPeaks(const std::vector<Hash>& peakHashes, const uint64_t size);
 	static Hash GetHashAt(const HashFile& hashFile, const uint64_t mmrIndex, const PruneList* pPruneList);
 	static std::vector<Hash> GetLastLeafHashes(const HashFile& hashFile, const LeafSet* pLeafSet, const PruneList* pPruneList, const uint64_t numHashes);
 	static Hash HashParentWithIndex(const Hash& leftChild, const Hash& rightChild, const uint64_t parentIndex);
+	static bool ValidateParentHashes(const HashFile& hashFile, const PruneList* pPruneList, const uint64_t firstMMRIndex, const uint64_t lastMMRIndex);
 
 private:
+	// A parent's hash is the hash of its index (8 bytes) and its children's hashes (32 bytes each).
+	static const size_t PARENT_MESSAGE_SIZE = 8 + 32 + 32;
+
+	static bool ValidateParentBatch(const HashFile& hashFile, const PruneList* pPruneList, const std::vector<uint64_t>& parentIndices, const std::vector<unsigned char>& messages);
 	static Hash HashLeafWithIndex(const std::vector<unsigned char>& serializedLeaf, const uint64_t mmrIndex);
 	static uint64_t GetShiftedIndex(const uint64_t mmrIndex, const PruneList* pPruneList);
+	static ByteView GetHashViewAt(const HashFile& hashFile, const uint64_t mmrIndex, const PruneList* pPruneList);
 };
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "MMRPeaks.h"
+#include "MMRUtil.h"
+#include "MMRHashUtil.h"
+
+MMRPeaks::MMRPeaks(const HashFile& hashFile, const uint64_t size, std::vector<Hash>&& peakHashes)
+	: m_hashFile(hashFile), m_size(size), m_peakHashes(std::move(peakHashes))
+{
+
+}
+
+MMRPeaks MMRPeaks::Load(const HashFile& hashFile, const uint64_t size)
+{
+	return MMRPeaks(hashFile, size, LoadPeakHashes(hashFile, size));
+}
+
+std::vector<Hash> MMRPeaks::LoadPeakHashes(const HashFile& hashFile, const uint64_t size)
+{
+	std::vector<Hash> peakHashes;
+
+	const std::vector<uint64_t> peakIndices = MMRUtil::GetPeakIndices(size);
+	for (const uint64_t peakIndex : peakIndices)
+	{
+		peakHashes.push_back(hashFile.GetHashAt(peakIndex));
+	}
+
+	return peakHashes;
+}
+
+bool MMRPeaks::Grow(const uint64_t size)
+{
+	if (size < m_size)
+	{
+		m_peakHashes = LoadPeakHashes(m_hashFile, size);
+		m_size = size;
+		return true;
+	}
+
+	for (uint64_t mmrIndex = m_size; mmrIndex < size; mmrIndex++)
+	{
+		const ByteView hash = m_hashFile.GetHashViewAt(mmrIndex);
+		if (hash.empty())
+		{
+			return false;
+		}
+
+		// A parent's children are always the two rightmost peaks, so they get replaced by the parent.
+		if (MMRUtil::GetHeight(mmrIndex) > 0)
+		{
+			if (m_peakHashes.size() < 2)
+			{
+				return false;
+			}
+
+			m_peakHashes.pop_back();
+			m_peakHashes.pop_back();
+		}
+
+		m_peakHashes.emplace_back(Hash(hash.data()));
+		m_size = mmrIndex + 1;
+	}
+
+	return true;
+}
+
+Hash MMRPeaks::Root() const
+{
+	return MMRHashUtil::BagPeaks(m_peakHashes, m_size);
+}
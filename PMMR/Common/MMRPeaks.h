@@ -0,0 +1,45 @@
+#pragma once
+
+#include "HashFile.h"
+
+#include <Crypto/Hash.h>
+#include <vector>
+#include <stdint.h>
+
+//
+// Tracks the peak hashes of an unpruned MMR as it grows, so roots for increasing sizes
+// can be calculated without looking up the peaks again for every size.
+//
+class MMRPeaks
+{
+public:
+	//
+	// Reads the peaks of the MMR with the given size (# of nodes) from the hash file.
+	//
+	static MMRPeaks Load(const HashFile& hashFile, const uint64_t size);
+
+	//
+	// Grows the peak set to the given size, reading only the nodes added since the last call.
+	// Shrinking reloads the peaks from the hash file.
+	// Returns false if a node's hash is missing from the hash file.
+	//
+	bool Grow(const uint64_t size);
+
+	//
+	// Bags the peaks from right to left, exactly like MMRHashUtil::Root.
+	//
+	Hash Root() const;
+
+	inline uint64_t GetSize() const { return m_size; }
+
+private:
+	MMRPeaks(const HashFile& hashFile, const uint64_t size, std::vector<Hash>&& peakHashes);
+
+	static std::vector<Hash> LoadPeakHashes(const HashFile& hashFile, const uint64_t size);
+
+	const HashFile& m_hashFile;
+	uint64_t m_size;
+
+	// Ordered left to right, so the rightmost peak is at the back.
+	std::vector<Hash> m_peakHashes;
+};
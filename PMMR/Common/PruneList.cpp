@@ -28,6 +28,18 @@ PruneList PruneList::Load(const std::string& filePath)
 }
 
 bool PruneList::Flush()
+{
+	const bool flushed = WriteTo(m_filePath);
+
+	// Rebuild our "shift caches" here as we are flushing changes to disk
+	// and the contents of our prune_list has likely changed.
+	BuildPrunedCache();
+	BuildShiftCaches();
+
+	return flushed;
+}
+
+bool PruneList::WriteTo(const std::string& filePath)
 {
 	// Run the optimization step on the bitmap.
 	m_prunedRoots.runOptimize();
@@ -39,14 +51,7 @@ bool PruneList::Flush()
 		std::vector<unsigned char> buffer(size);
 		m_prunedRoots.write((char*)&buffer[0]);
 
-		const bool flushed = FileUtil::SafeWriteToFile(m_filePath, buffer);
-
-		// Rebuild our "shift caches" here as we are flushing changes to disk
-		// and the contents of our prune_list has likely changed.
-		BuildPrunedCache();
-		BuildShiftCaches();
-		
-		return flushed;
+		return FileUtil::SafeWriteToFile(filePath, buffer);
 	}
 
 	return false;
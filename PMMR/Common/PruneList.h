@@ -13,6 +13,10 @@ public:
 
 	bool Flush();
 
+	// Writes the pruned roots to the given file, without rebuilding any caches.
+	// Used to stage a compacted prune list without replacing the current one.
+	bool WriteTo(const std::string& filePath);
+
 	// Adds the node to the prune list.
 	// Compacts if pruning the node means a parent can get pruned as well.
 	void Add(const uint64_t mmrIndex);
@@ -14,7 +14,13 @@ HeaderMMR::HeaderMMR(const std::string& path)
 
 bool HeaderMMR::Load()
 {
-	return m_hashFile.Load();
+	if (!m_hashFile.Load())
+	{
+		return false;
+	}
+
+	m_hashFile.LoadPeaks(m_hashFile.GetSize(), nullptr);
+	return true;
 }
 
 bool HeaderMMR::Commit()
@@ -30,7 +36,12 @@ bool HeaderMMR::Rewind(const uint64_t size)
 	if (mmrSize != m_hashFile.GetSize())
 	{
 		LoggerAPI::LogDebug("HeaderMMR::Rewind - Rewinding to height " + std::to_string(size) + " Hashes: " + std::to_string(mmrSize));
-		return m_hashFile.Rewind(mmrSize);
+		if (!m_hashFile.Rewind(mmrSize))
+		{
+			return false;
+		}
+
+		m_hashFile.LoadPeaks(mmrSize, nullptr);
 	}
 
 	return true;
@@ -39,7 +50,13 @@ bool HeaderMMR::Rewind(const uint64_t size)
 bool HeaderMMR::Rollback()
 {
 	LoggerAPI::LogDebug("HeaderMMR::Rollback - Discarding changes.");
-	return m_hashFile.Discard();
+	if (!m_hashFile.Discard())
+	{
+		return false;
+	}
+
+	m_hashFile.LoadPeaks(m_hashFile.GetSize(), nullptr);
+	return true;
 }
 
 void HeaderMMR::AddHeader(const BlockHeader& header)
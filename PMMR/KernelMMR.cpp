@@ -43,8 +43,7 @@ std::unique_ptr<TransactionKernel> KernelMMR::GetKernelAt(const uint64_t mmrInde
 	{
 		const uint64_t numLeaves = MMRUtil::GetNumLeaves(mmrIndex);
 
-		std::vector<unsigned char> data;
-		m_pDataFile->GetDataAt(numLeaves - 1, data);
+		const ByteView data = m_pDataFile->GetDataViewAt(numLeaves - 1);
 
 		if (data.size() == KERNEL_SIZE)
 		{
@@ -61,6 +60,11 @@ std::vector<Hash> KernelMMR::GetLastLeafHashes(const uint64_t numHashes) const
 	return MMRHashUtil::GetLastLeafHashes(*m_pHashFile, nullptr, nullptr, numHashes);
 }
 
+bool KernelMMR::ValidateHashes(const uint64_t firstMMRIndex, const uint64_t lastMMRIndex) const
+{
+	return MMRHashUtil::ValidateParentHashes(*m_pHashFile, nullptr, firstMMRIndex, lastMMRIndex);
+}
+
 bool KernelMMR::Rewind(const uint64_t size)
 {
 	const bool hashRewind = m_pHashFile->Rewind(size);
@@ -87,6 +91,12 @@ bool KernelMMR::Discard()
 	return hashDiscard && dataDiscard;
 }
 
+void KernelMMR::AddToJournal(TxHashSetJournal::Entry& entry) const
+{
+	entry.files["kernel/pmmr_hash.bin"] = m_pHashFile->GetPendingFlush();
+	entry.files["kernel/pmmr_data.bin"] = m_pDataFile->GetPendingFlush();
+}
+
 bool KernelMMR::ApplyKernel(const TransactionKernel& kernel)
 {
 	// Add to data file
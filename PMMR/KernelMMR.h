@@ -2,6 +2,8 @@
 
 #include "Common/MMR.h"
 #include "Common/HashFile.h"
+#include "TxHashSetJournal.h"
+#include "Common/MMRPeaks.h"
 
 #include <Core/DataFile.h>
 #include <Core/Models/TransactionKernel.h>
@@ -19,14 +21,26 @@ public:
 	std::unique_ptr<TransactionKernel> GetKernelAt(const uint64_t mmrIndex) const;
 	bool Rewind(const uint64_t size);
 
+	//
+	// Returns the peaks of the MMR with the given size, which can then be grown to calculate the roots of larger sizes.
+	// The peaks reference the MMR's hash file, so they must not outlive it or be used across a Flush, Rewind, or Discard.
+	//
+	MMRPeaks GetPeaks(const uint64_t size) const { return MMRPeaks::Load(*m_pHashFile, size); }
+
 	virtual Hash Root(const uint64_t size) const override final;
 	virtual uint64_t GetSize() const override final { return m_pHashFile->GetSize(); }
 	virtual std::unique_ptr<Hash> GetHashAt(const uint64_t mmrIndex) const override final { return std::make_unique<Hash>(m_pHashFile->GetHashAt(mmrIndex)); }
 	virtual std::vector<Hash> GetLastLeafHashes(const uint64_t numHashes) const override final;
+	virtual bool ValidateHashes(const uint64_t firstMMRIndex, const uint64_t lastMMRIndex) const override final;
 
 	virtual bool Flush() override final;
 	virtual bool Discard() override final;
 
+	//
+	// Adds everything the next Flush will change on disk to the journal entry.
+	//
+	void AddToJournal(TxHashSetJournal::Entry& entry) const;
+
 	bool ApplyKernel(const TransactionKernel& kernel);
 
 private:
@@ -108,6 +108,11 @@ std::vector<Hash> OutputPMMR::GetLastLeafHashes(const uint64_t numHashes) const
 	return MMRHashUtil::GetLastLeafHashes(*m_pHashFile, &m_leafSet, &m_pruneList, numHashes);
 }
 
+bool OutputPMMR::ValidateHashes(const uint64_t firstMMRIndex, const uint64_t lastMMRIndex) const
+{
+	return MMRHashUtil::ValidateParentHashes(*m_pHashFile, &m_pruneList, firstMMRIndex, lastMMRIndex);
+}
+
 bool OutputPMMR::IsUnspent(const uint64_t mmrIndex) const
 {
 	if (MMRUtil::IsLeaf(mmrIndex))
@@ -129,8 +134,7 @@ std::unique_ptr<OutputIdentifier> OutputPMMR::GetOutputAt(const uint64_t mmrInde
 		const uint64_t numLeaves = MMRUtil::GetNumLeaves(mmrIndex);
 		const uint64_t shiftedIndex = ((numLeaves - 1) - shift);
 
-		std::vector<unsigned char> data;
-		m_pDataFile->GetDataAt(shiftedIndex, data);
+		const ByteView data = m_pDataFile->GetDataViewAt(shiftedIndex);
 
 		if (data.size() == OUTPUT_SIZE)
 		{
@@ -184,65 +188,12 @@ bool OutputPMMR::Discard()
 	return hashDiscard && dataDiscard;
 }
 
-Roaring OutputPMMR::DetermineLeavesToRemove(const uint64_t cutoffSize, const Roaring& rewindRmPos) const
-{	
-	return m_leafSet.CalculatePrunedPositions(cutoffSize, rewindRmPos, m_pruneList);
-}
-
-struct IteratorParam
-{
-	IteratorParam(Roaring& expanded, const PruneList& pruneList)
-		: expanded(expanded), pruneList(pruneList)
-	{
-
-	}
-
-	Roaring& expanded;
-	const PruneList& pruneList;
-};
-
-bool Iterator(const uint32_t value, void* param)
-{
-	IteratorParam* pIteratorParam = (IteratorParam*)param;
-	Roaring& expanded = pIteratorParam->expanded;
-	const PruneList& pruneList = pIteratorParam->pruneList;
-
-	expanded.add(value);
-	uint64_t current = value;
-
-	while (true)
-	{
-		const uint64_t siblingIndex = MMRUtil::GetSiblingIndex(current);
-
-		const bool siblingPruned = pruneList.IsPrunedRoot(siblingIndex);
-
-		// if sibling previously pruned, push it back onto list of pos to remove so we can remove it and traverse up to parent
-		if (siblingPruned)
-		{
-			expanded.add(siblingIndex);
-		}
-
-		if (siblingPruned || expanded.contains(siblingIndex))
-		{
-			const uint64_t parentIndex = MMRUtil::GetParentIndex(current);
-			expanded.add(parentIndex);
-			current = parentIndex;
-		}
-		else
-		{
-			break;
-		}
-	}
-
-	return true;
-}
-
-Roaring OutputPMMR::DetermineNodesToRemove(const Roaring& leavesToRemove) const
+void OutputPMMR::AddToJournal(TxHashSetJournal::Entry& entry) const
 {
-	Roaring expanded;
-
-	IteratorParam iteratorParam(expanded, m_pruneList);
-	leavesToRemove.iterate(Iterator, &iteratorParam);
+	entry.files["output/pmmr_hash.bin"] = m_pHashFile->GetPendingFlush();
+	entry.files["output/pmmr_data.bin"] = m_pDataFile->GetPendingFlush();
 
-	return expanded;
+	TxHashSetJournal::LeafSetChanges& leafSetChanges = entry.leafSets["output/pmmr_leaf.bin"];
+	leafSetChanges.added = m_leafSet.GetAddedSinceFlush();
+	leafSetChanges.removed = m_leafSet.GetRemovedSinceFlush();
 }
\ No newline at end of file
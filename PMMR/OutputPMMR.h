@@ -4,6 +4,7 @@
 #include "Common/LeafSet.h"
 #include "Common/PruneList.h"
 #include "Common/HashFile.h"
+#include "TxHashSetJournal.h"
 
 #include <Core/DataFile.h>
 #include <Core/Models/OutputIdentifier.h>
@@ -26,20 +27,26 @@ public:
 	virtual Hash Root(const uint64_t mmrIndex) const override final;
 	virtual std::unique_ptr<Hash> GetHashAt(const uint64_t mmrIndex) const override final;
 	virtual std::vector<Hash> GetLastLeafHashes(const uint64_t numHashes) const override final;
+	virtual bool ValidateHashes(const uint64_t firstMMRIndex, const uint64_t lastMMRIndex) const override final;
 	virtual uint64_t GetSize() const override final;
 
 	virtual bool Flush() override final;
 	virtual bool Discard() override final;
 
+	//
+	// Adds everything the next Flush will change on disk to the journal entry.
+	//
+	void AddToJournal(TxHashSetJournal::Entry& entry) const;
+
+	inline const LeafSet& GetLeafSet() const { return m_leafSet; }
+	inline const PruneList& GetPruneList() const { return m_pruneList; }
+
 	bool IsUnspent(const uint64_t mmrIndex) const;
 	std::unique_ptr<OutputIdentifier> GetOutputAt(const uint64_t mmrIndex) const;
 
 private:
 	OutputPMMR(IBlockDB& blockDB, HashFile* pHashFile, LeafSet&& leafSet, PruneList&& pruneList, DataFile<OUTPUT_SIZE>* pDataFile);
 
-	Roaring DetermineLeavesToRemove(const uint64_t cutoffSize, const Roaring& rewindRmPos) const;
-	Roaring DetermineNodesToRemove(const Roaring& leavesToRemove) const;
-
 	IBlockDB& m_blockDB;
 
 	HashFile* m_pHashFile;
@@ -0,0 +1,254 @@
+#include "PMMRCompactor.h"
+#include "TxHashSetJournal.h"
+#include "Common/MMRUtil.h"
+
+#include <Crypto/Hash.h>
+#include <Common/Util/FileUtil.h>
+#include <Infrastructure/Logger.h>
+
+// Staged files are flushed periodically, so they never need to be buffered in memory all at once.
+static const uint64_t STAGED_FLUSH_INTERVAL = 16 * 1024 * 1024;
+
+PMMRCompactor::PMMRCompactor(
+	const std::string& txHashSetDirectory,
+	const std::string& name,
+	const size_t dataSize,
+	const PruneList& pruneList,
+	PruneList&& compactedPruneList,
+	Roaring&& nodesToRemove,
+	const uint64_t cutoffSize,
+	const uint64_t numLeavesPruned)
+	: m_txHashSetDirectory(txHashSetDirectory),
+	m_name(name),
+	m_dataSize(dataSize),
+	m_pruneList(pruneList),
+	m_compactedPruneList(std::move(compactedPruneList)),
+	m_nodesToRemove(std::move(nodesToRemove)),
+	m_cutoffSize(cutoffSize),
+	m_numLeavesPruned(numLeavesPruned),
+	m_hashCutoff(cutoffSize - pruneList.GetShift(cutoffSize - 1)),
+	m_dataCutoff(MMRUtil::GetNumLeaves(cutoffSize - 1) - pruneList.GetLeafShift(cutoffSize - 1))
+{
+
+}
+
+std::unique_ptr<PMMRCompactor> PMMRCompactor::Create(
+	const std::string& txHashSetDirectory,
+	const std::string& name,
+	const size_t dataSize,
+	const LeafSet& leafSet,
+	const PruneList& pruneList,
+	const uint64_t cutoffSize,
+	const Roaring& rewindRmPos)
+{
+	if (cutoffSize == 0)
+	{
+		return std::unique_ptr<PMMRCompactor>(nullptr);
+	}
+
+	const Roaring leavesToRemove = leafSet.CalculatePrunedPositions(cutoffSize, rewindRmPos, pruneList);
+	if (leavesToRemove.isEmpty())
+	{
+		return std::unique_ptr<PMMRCompactor>(nullptr);
+	}
+
+	// Expand the leaves to every node that gets pruned with them. A parent is pruned once both of its children are,
+	// whether they're pruned now or were already pruned by a previous compaction.
+	PruneList compactedPruneList = pruneList;
+	Roaring expanded;
+	for (const uint32_t position : leavesToRemove)
+	{
+		const uint64_t leafIndex = position - 1;
+		compactedPruneList.Add(leafIndex);
+		expanded.add((uint32_t)leafIndex);
+
+		uint64_t mmrIndex = leafIndex;
+		while (true)
+		{
+			const uint64_t siblingIndex = MMRUtil::GetSiblingIndex(mmrIndex);
+			if (pruneList.IsPrunedRoot(siblingIndex))
+			{
+				expanded.add((uint32_t)siblingIndex);
+			}
+			else if (!expanded.contains((uint32_t)siblingIndex))
+			{
+				break;
+			}
+
+			mmrIndex = MMRUtil::GetParentIndex(mmrIndex);
+			expanded.add((uint32_t)mmrIndex);
+		}
+	}
+
+	// The roots of the pruned subtrees keep their hashes, so only remove nodes whose parent is removed as well.
+	Roaring nodesToRemove;
+	for (const uint32_t mmrIndex : expanded)
+	{
+		if (expanded.contains((uint32_t)MMRUtil::GetParentIndex(mmrIndex)))
+		{
+			nodesToRemove.add(mmrIndex);
+		}
+	}
+
+	return std::unique_ptr<PMMRCompactor>(new PMMRCompactor(
+		txHashSetDirectory,
+		name,
+		dataSize,
+		pruneList,
+		std::move(compactedPruneList),
+		std::move(nodesToRemove),
+		cutoffSize,
+		leavesToRemove.cardinality()
+	));
+}
+
+bool PMMRCompactor::WriteStagedFiles(const std::atomic_bool& terminate) const
+{
+	const std::string directory = m_txHashSetDirectory + m_name + "/";
+
+	File hashFile(directory + "pmmr_hash.bin");
+	File dataFile(directory + "pmmr_data.bin");
+	if (!hashFile.Load() || !dataFile.Load())
+	{
+		LoggerAPI::LogError("PMMRCompactor::WriteStagedFiles - Failed to load " + m_name + " files.");
+		return false;
+	}
+
+	if (hashFile.GetSize() < m_hashCutoff * HASH_SIZE || dataFile.GetSize() < m_dataCutoff * m_dataSize)
+	{
+		LoggerAPI::LogError("PMMRCompactor::WriteStagedFiles - The " + m_name + " files end before the horizon.");
+		return false;
+	}
+
+	// Start from empty staged files, replacing anything left behind by a previous attempt.
+	const std::string stagedHashPath = TxHashSetJournal::GetStagedPath(directory + "pmmr_hash.bin");
+	const std::string stagedDataPath = TxHashSetJournal::GetStagedPath(directory + "pmmr_data.bin");
+	if (!FileUtil::SafeWriteToFile(stagedHashPath, std::vector<unsigned char>()) || !FileUtil::SafeWriteToFile(stagedDataPath, std::vector<unsigned char>()))
+	{
+		LoggerAPI::LogError("PMMRCompactor::WriteStagedFiles - Failed to create staged " + m_name + " files.");
+		return false;
+	}
+
+	File stagedHashFile(stagedHashPath);
+	File stagedDataFile(stagedDataPath);
+	if (!stagedHashFile.Load() || !stagedDataFile.Load())
+	{
+		return false;
+	}
+
+	uint64_t hashIndex = 0;
+	uint64_t dataIndex = 0;
+	uint64_t bytesSinceFlush = 0;
+	for (uint64_t mmrIndex = 0; mmrIndex < m_cutoffSize; mmrIndex++)
+	{
+		// Compacted nodes were already removed from the files.
+		if (m_pruneList.IsCompacted(mmrIndex))
+		{
+			continue;
+		}
+
+		const bool remove = m_nodesToRemove.contains((uint32_t)mmrIndex);
+		if (!remove)
+		{
+			stagedHashFile.Append(hashFile.ReadView(hashIndex * HASH_SIZE, HASH_SIZE).ToVector());
+			bytesSinceFlush += HASH_SIZE;
+		}
+
+		hashIndex++;
+
+		if (MMRUtil::IsLeaf(mmrIndex))
+		{
+			if (!remove)
+			{
+				stagedDataFile.Append(dataFile.ReadView(dataIndex * m_dataSize, m_dataSize).ToVector());
+				bytesSinceFlush += m_dataSize;
+			}
+
+			dataIndex++;
+		}
+
+		if (bytesSinceFlush >= STAGED_FLUSH_INTERVAL)
+		{
+			if (terminate)
+			{
+				return false;
+			}
+
+			if (!stagedHashFile.Flush() || !stagedDataFile.Flush())
+			{
+				LoggerAPI::LogError("PMMRCompactor::WriteStagedFiles - Failed to flush staged " + m_name + " files.");
+				return false;
+			}
+
+			bytesSinceFlush = 0;
+		}
+	}
+
+	if (hashIndex != m_hashCutoff || dataIndex != m_dataCutoff)
+	{
+		LoggerAPI::LogError("PMMRCompactor::WriteStagedFiles - The " + m_name + " files don't match the prune list.");
+		return false;
+	}
+
+	if (!stagedHashFile.Flush() || !stagedDataFile.Flush())
+	{
+		LoggerAPI::LogError("PMMRCompactor::WriteStagedFiles - Failed to flush staged " + m_name + " files.");
+		return false;
+	}
+
+	return true;
+}
+
+bool PMMRCompactor::Finalize()
+{
+	const std::string directory = m_txHashSetDirectory + m_name + "/";
+
+	File hashFile(directory + "pmmr_hash.bin");
+	File dataFile(directory + "pmmr_data.bin");
+	File stagedHashFile(TxHashSetJournal::GetStagedPath(directory + "pmmr_hash.bin"));
+	File stagedDataFile(TxHashSetJournal::GetStagedPath(directory + "pmmr_data.bin"));
+	if (!hashFile.Load() || !dataFile.Load() || !stagedHashFile.Load() || !stagedDataFile.Load())
+	{
+		LoggerAPI::LogError("PMMRCompactor::Finalize - Failed to load " + m_name + " files.");
+		return false;
+	}
+
+	if (!AppendTail(hashFile, m_hashCutoff * HASH_SIZE, stagedHashFile) || !AppendTail(dataFile, m_dataCutoff * m_dataSize, stagedDataFile))
+	{
+		LoggerAPI::LogError("PMMRCompactor::Finalize - Failed to append to staged " + m_name + " files.");
+		return false;
+	}
+
+	return m_compactedPruneList.WriteTo(TxHashSetJournal::GetStagedPath(directory + "pmmr_prun.bin"));
+}
+
+std::vector<std::string> PMMRCompactor::GetRelativePaths() const
+{
+	return std::vector<std::string>({
+		m_name + "/pmmr_hash.bin",
+		m_name + "/pmmr_data.bin",
+		m_name + "/pmmr_prun.bin"
+	});
+}
+
+bool PMMRCompactor::AppendTail(const File& source, const uint64_t position, File& destination)
+{
+	if (source.GetSize() < position)
+	{
+		return false;
+	}
+
+	const uint64_t numBytes = source.GetSize() - position;
+	if (numBytes > 0)
+	{
+		const ByteView tail = source.ReadView(position, numBytes);
+		if (tail.size() != numBytes)
+		{
+			return false;
+		}
+
+		destination.Append(tail.ToVector());
+	}
+
+	return destination.Flush();
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Common/LeafSet.h"
+#include "Common/PruneList.h"
+
+#include <Core/File.h>
+#include <Core/CRoaring/roaring.hh>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+//
+// Compacts an output or rangeproof PMMR by rewriting its hash and data files without the leaves spent before the cut-through horizon,
+// along with any parents that can be pruned with them.
+// Nothing before the horizon changes once it's committed, so the bulk of the work (WriteStagedFiles) can run without holding any locks.
+// Only Finalize, which copies everything added after the horizon and stages the new prune list, requires the PMMR to be left alone.
+// The staged files are then swapped in using TxHashSetJournal::ReplaceFiles.
+//
+class PMMRCompactor
+{
+public:
+	//
+	// Determines what can be pruned from the committed PMMR stored in txHashSetDirectory + name (ie. "output").
+	// cutoffSize is the PMMR size at the horizon, and rewindRmPos contains the leaves spent after the horizon, which must be kept.
+	// Returns nullptr if there's nothing to prune.
+	//
+	static std::unique_ptr<PMMRCompactor> Create(
+		const std::string& txHashSetDirectory,
+		const std::string& name,
+		const size_t dataSize,
+		const LeafSet& leafSet,
+		const PruneList& pruneList,
+		const uint64_t cutoffSize,
+		const Roaring& rewindRmPos
+	);
+
+	//
+	// Writes the compacted hash and data files up to the horizon to their staged paths.
+	// Returns false without finishing if terminate gets set to true.
+	//
+	bool WriteStagedFiles(const std::atomic_bool& terminate) const;
+
+	//
+	// Appends everything after the horizon to the staged files and stages the new prune list.
+	// The PMMR must be fully flushed, and must not be modified until the staged files have replaced the originals.
+	//
+	bool Finalize();
+
+	//
+	// The files to replace with their staged copies, relative to the TxHashSet directory.
+	//
+	std::vector<std::string> GetRelativePaths() const;
+
+	inline uint64_t GetNumLeavesPruned() const { return m_numLeavesPruned; }
+
+private:
+	PMMRCompactor(
+		const std::string& txHashSetDirectory,
+		const std::string& name,
+		const size_t dataSize,
+		const PruneList& pruneList,
+		PruneList&& compactedPruneList,
+		Roaring&& nodesToRemove,
+		const uint64_t cutoffSize,
+		const uint64_t numLeavesPruned
+	);
+
+	static bool AppendTail(const File& source, const uint64_t position, File& destination);
+
+	const std::string m_txHashSetDirectory;
+	const std::string m_name;
+	const size_t m_dataSize;
+
+	// The prune list before and after compacting.
+	const PruneList m_pruneList;
+	PruneList m_compactedPruneList;
+
+	// MMR indices of the nodes to remove from the hash file. Roots of pruned subtrees keep their hashes, so they're not included.
+	const Roaring m_nodesToRemove;
+
+	const uint64_t m_cutoffSize;
+	const uint64_t m_numLeavesPruned;
+
+	// Number of hashes and data entries stored before the horizon in the current files.
+	const uint64_t m_hashCutoff;
+	const uint64_t m_dataCutoff;
+};
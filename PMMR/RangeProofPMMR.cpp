@@ -99,6 +99,11 @@ std::vector<Hash> RangeProofPMMR::GetLastLeafHashes(const uint64_t numHashes) co
 	return MMRHashUtil::GetLastLeafHashes(*m_pHashFile, &m_leafSet, &m_pruneList, numHashes);
 }
 
+bool RangeProofPMMR::ValidateHashes(const uint64_t firstMMRIndex, const uint64_t lastMMRIndex) const
+{
+	return MMRHashUtil::ValidateParentHashes(*m_pHashFile, &m_pruneList, firstMMRIndex, lastMMRIndex);
+}
+
 std::unique_ptr<RangeProof> RangeProofPMMR::GetRangeProofAt(const uint64_t mmrIndex) const
 {
 	if (MMRUtil::IsLeaf(mmrIndex))
@@ -109,8 +114,7 @@ std::unique_ptr<RangeProof> RangeProofPMMR::GetRangeProofAt(const uint64_t mmrIn
 			const uint64_t numLeaves = MMRUtil::GetNumLeaves(mmrIndex);
 			const uint64_t shiftedIndex = ((numLeaves - 1) - shift);
 
-			std::vector<unsigned char> data;
-			m_pDataFile->GetDataAt(shiftedIndex, data);
+			const ByteView data = m_pDataFile->GetDataViewAt(shiftedIndex);
 
 			if (data.size() == RANGE_PROOF_SIZE)
 			{
@@ -163,4 +167,14 @@ bool RangeProofPMMR::Discard()
 	// TODO: const bool pruneDiscard = m_pruneList.Discard();
 
 	return hashDiscard && dataDiscard;
+}
+
+void RangeProofPMMR::AddToJournal(TxHashSetJournal::Entry& entry) const
+{
+	entry.files["rangeproof/pmmr_hash.bin"] = m_pHashFile->GetPendingFlush();
+	entry.files["rangeproof/pmmr_data.bin"] = m_pDataFile->GetPendingFlush();
+
+	TxHashSetJournal::LeafSetChanges& leafSetChanges = entry.leafSets["rangeproof/pmmr_leaf.bin"];
+	leafSetChanges.added = m_leafSet.GetAddedSinceFlush();
+	leafSetChanges.removed = m_leafSet.GetRemovedSinceFlush();
 }
\ No newline at end of file
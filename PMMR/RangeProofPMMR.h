@@ -4,6 +4,7 @@
 #include "Common/LeafSet.h"
 #include "Common/PruneList.h"
 #include "Common/HashFile.h"
+#include "TxHashSetJournal.h"
 
 #include <optional>
 #include <Crypto/Hash.h>
@@ -26,12 +27,21 @@ public:
 	virtual Hash Root(const uint64_t mmrIndex) const override final;
 	virtual std::unique_ptr<Hash> GetHashAt(const uint64_t mmrIndex) const override final;
 	virtual std::vector<Hash> GetLastLeafHashes(const uint64_t numHashes) const override final;
+	virtual bool ValidateHashes(const uint64_t firstMMRIndex, const uint64_t lastMMRIndex) const override final;
 	std::unique_ptr<RangeProof> GetRangeProofAt(const uint64_t mmrIndex) const;
 	virtual uint64_t GetSize() const override final;
 
 	virtual bool Flush() override final;
 	virtual bool Discard() override final;
 
+	//
+	// Adds everything the next Flush will change on disk to the journal entry.
+	//
+	void AddToJournal(TxHashSetJournal::Entry& entry) const;
+
+	inline const LeafSet& GetLeafSet() const { return m_leafSet; }
+	inline const PruneList& GetPruneList() const { return m_pruneList; }
+
 private:
 	RangeProofPMMR(HashFile* pHashFile, LeafSet&& leafSet, PruneList&& pruneList, DataFile<RANGE_PROOF_SIZE>* pDataFile);
 
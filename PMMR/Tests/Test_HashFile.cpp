@@ -0,0 +1,79 @@
+#include <ThirdParty/Catch2/catch.hpp>
+
+#include "../Common/HashFile.h"
+#include "../Common/MMRHashUtil.h"
+#include "../Common/MMRUtil.h"
+
+#include <Core/Serialization/Serializer.h>
+#include <filesystem>
+
+// Reads the peaks straight from the file, bypassing the in-memory peaks.
+static std::vector<Hash> ReadPeaksFromFile(const HashFile& hashFile, const uint64_t size)
+{
+	std::vector<Hash> peaks;
+	for (const uint64_t peakIndex : MMRUtil::GetPeakIndices(size))
+	{
+		peaks.push_back(hashFile.GetHashAt(peakIndex));
+	}
+
+	return peaks;
+}
+
+TEST_CASE("HashFile::LoadPeaks")
+{
+	const std::string path = std::filesystem::temp_directory_path().string() + "/HashFilePeaksTest.bin";
+	std::filesystem::remove(path);
+
+	HashFile hashFile(path);
+	hashFile.Load();
+
+	std::vector<uint64_t> sizes;
+	std::vector<Hash> roots;
+	for (uint64_t i = 0; i < 50; i++)
+	{
+		Serializer serializer;
+		serializer.Append<uint64_t>(i);
+		MMRHashUtil::AddHashes(hashFile, serializer.GetBytes(), nullptr);
+
+		// The in-memory peaks should match the peaks in the file.
+		const uint64_t size = hashFile.GetSize();
+		REQUIRE(hashFile.GetPeaks(size) != nullptr);
+		REQUIRE(*hashFile.GetPeaks(size) == ReadPeaksFromFile(hashFile, size));
+		sizes.push_back(size);
+		roots.push_back(MMRHashUtil::Root(hashFile, size, nullptr));
+	}
+
+	// A freshly loaded file has no peaks in memory, so its roots are calculated from the file.
+	REQUIRE(hashFile.Flush());
+	{
+		HashFile reloaded(path);
+		REQUIRE(reloaded.Load());
+		for (size_t i = 0; i < sizes.size(); i++)
+		{
+			REQUIRE(reloaded.GetPeaks(sizes[i]) == nullptr);
+			REQUIRE(MMRHashUtil::Root(reloaded, sizes[i], nullptr) == roots[i]);
+		}
+	}
+
+	// Rewinding invalidates the peaks
+	const uint64_t rewindSize = MMRUtil::GetNumNodes(MMRUtil::GetPMMRIndex(20));
+	REQUIRE(rewindSize == sizes[20]);
+	REQUIRE(hashFile.Rewind(rewindSize));
+	REQUIRE(hashFile.GetPeaks(rewindSize) == nullptr);
+	REQUIRE(MMRHashUtil::Root(hashFile, rewindSize, nullptr) == roots[20]);
+
+	// Appending after a rewind reloads the peaks, and produces the same hashes as before.
+	for (uint64_t i = 21; i < 50; i++)
+	{
+		Serializer serializer;
+		serializer.Append<uint64_t>(i);
+		MMRHashUtil::AddHashes(hashFile, serializer.GetBytes(), nullptr);
+
+		const uint64_t size = hashFile.GetSize();
+		REQUIRE(size == sizes[i]);
+		REQUIRE(*hashFile.GetPeaks(size) == ReadPeaksFromFile(hashFile, size));
+		REQUIRE(MMRHashUtil::Root(hashFile, size, nullptr) == roots[i]);
+	}
+
+	hashFile.Discard();
+}
@@ -0,0 +1,41 @@
+#include <ThirdParty/Catch2/catch.hpp>
+
+#include "../Common/MMRPeaks.h"
+#include "../Common/MMRHashUtil.h"
+#include "../Common/MMRUtil.h"
+
+#include <Core/Serialization/Serializer.h>
+#include <filesystem>
+
+TEST_CASE("MMRPeaks::Grow")
+{
+	const std::string path = std::filesystem::temp_directory_path().string() + "/MMRPeaksTest.bin";
+	std::filesystem::remove(path);
+
+	HashFile hashFile(path);
+	for (uint64_t i = 0; i < 50; i++)
+	{
+		Serializer serializer;
+		serializer.Append<uint64_t>(i);
+		MMRHashUtil::AddHashes(hashFile, serializer.GetBytes(), nullptr);
+	}
+
+	// Growing one leaf at a time should always match the root calculated from scratch.
+	MMRPeaks peaks = MMRPeaks::Load(hashFile, 0);
+	REQUIRE(peaks.Root() == ZERO_HASH);
+
+	for (uint64_t leafIndex = 0; leafIndex < 50; leafIndex++)
+	{
+		const uint64_t size = MMRUtil::GetNumNodes(MMRUtil::GetPMMRIndex(leafIndex));
+		REQUIRE(peaks.Grow(size));
+		REQUIRE(peaks.GetSize() == size);
+		REQUIRE(peaks.Root() == MMRHashUtil::Root(hashFile, size, nullptr));
+	}
+
+	// Shrinking reloads the peaks
+	REQUIRE(peaks.Grow(11));
+	REQUIRE(peaks.Root() == MMRHashUtil::Root(hashFile, 11, nullptr));
+
+	// Nodes beyond the end of the hash file can't be added
+	REQUIRE_FALSE(peaks.Grow(hashFile.GetSize() + 1));
+}
@@ -0,0 +1,81 @@
+#include <ThirdParty/Catch2/catch.hpp>
+
+#include "../PMMRCompactor.h"
+#include "../TxHashSetJournal.h"
+#include "../Common/LeafSet.h"
+#include "../Common/PruneList.h"
+
+#include <Core/File.h>
+#include <Crypto/Hash.h>
+#include <filesystem>
+#include <memory>
+
+TEST_CASE("PMMRCompactor - Prune spent leaves before horizon")
+{
+	const std::string txHashSetDirectory = std::filesystem::temp_directory_path().string() + "/PMMRCompactorTest/";
+	std::filesystem::remove_all(txHashSetDirectory);
+	std::filesystem::create_directories(txHashSetDirectory + "output");
+
+	const size_t dataSize = 2;
+
+	// 5 leaves: 0, 1, 3, 4, 7. Leaves 0 and 1 are spent, and the horizon is at size 7.
+	{
+		File hashFile(txHashSetDirectory + "output/pmmr_hash.bin");
+		for (unsigned char i = 0; i < 8; i++)
+		{
+			hashFile.Append(std::vector<unsigned char>(HASH_SIZE, i));
+		}
+		REQUIRE(hashFile.Flush());
+
+		File dataFile(txHashSetDirectory + "output/pmmr_data.bin");
+		for (unsigned char i = 0; i < 5; i++)
+		{
+			dataFile.Append(std::vector<unsigned char>(dataSize, i));
+		}
+		REQUIRE(dataFile.Flush());
+	}
+
+	LeafSet leafSet(txHashSetDirectory + "output/pmmr_leaf.bin");
+	leafSet.Add(3);
+	leafSet.Add(4);
+	leafSet.Add(7);
+	REQUIRE(leafSet.Flush());
+
+	const PruneList pruneList = PruneList::Load(txHashSetDirectory + "output/pmmr_prun.bin");
+
+	std::unique_ptr<TxHashSetJournal> pJournal(TxHashSetJournal::Load(txHashSetDirectory));
+	TxHashSetJournal::Entry entry;
+	entry.blockHash = Hash::ValueOf(1);
+	REQUIRE(pJournal->Begin(std::move(entry)));
+	REQUIRE(pJournal->Complete());
+
+	std::unique_ptr<PMMRCompactor> pCompactor = PMMRCompactor::Create(txHashSetDirectory, "output", dataSize, leafSet, pruneList, 7, Roaring());
+	REQUIRE(pCompactor != nullptr);
+	REQUIRE(pCompactor->GetNumLeavesPruned() == 2);
+
+	const std::atomic_bool terminate = false;
+	REQUIRE(pCompactor->WriteStagedFiles(terminate));
+	REQUIRE(pCompactor->Finalize());
+	REQUIRE(pJournal->ReplaceFiles(pCompactor->GetRelativePaths()));
+
+	// Leaves 0 and 1 are removed, but their parent (2) keeps its hash. Leaf 7 is after the horizon, so it's copied as-is.
+	File hashFile(txHashSetDirectory + "output/pmmr_hash.bin");
+	REQUIRE(hashFile.Load());
+	REQUIRE(hashFile.GetSize() == 6 * HASH_SIZE);
+	REQUIRE(hashFile.ReadView(0, 1).ToVector() == std::vector<unsigned char>({ 2 }));
+	REQUIRE(hashFile.ReadView(5 * HASH_SIZE, 1).ToVector() == std::vector<unsigned char>({ 7 }));
+
+	File dataFile(txHashSetDirectory + "output/pmmr_data.bin");
+	REQUIRE(dataFile.Load());
+	REQUIRE(dataFile.ReadView(0, 3 * dataSize).ToVector() == std::vector<unsigned char>({ 2, 2, 3, 3, 4, 4 }));
+
+	const PruneList compactedPruneList = PruneList::Load(txHashSetDirectory + "output/pmmr_prun.bin");
+	REQUIRE(compactedPruneList.IsPrunedRoot(2));
+	REQUIRE(compactedPruneList.IsCompacted(0));
+	REQUIRE(compactedPruneList.GetShift(6) == 2);
+	REQUIRE(compactedPruneList.GetLeafShift(6) == 2);
+
+	REQUIRE_FALSE(std::filesystem::exists(TxHashSetJournal::GetStagedPath(txHashSetDirectory + "output/pmmr_hash.bin")));
+
+	std::filesystem::remove_all(txHashSetDirectory);
+}
@@ -0,0 +1,84 @@
+#include <ThirdParty/Catch2/catch.hpp>
+
+#include "../TxHashSetJournal.h"
+#include "../Common/LeafSet.h"
+
+#include <Core/File.h>
+#include <filesystem>
+#include <memory>
+
+TEST_CASE("TxHashSetJournal - Undo interrupted commit")
+{
+	const std::string txHashSetDirectory = std::filesystem::temp_directory_path().string() + "/TxHashSetJournalTest/";
+	std::filesystem::remove_all(txHashSetDirectory);
+	std::filesystem::create_directories(txHashSetDirectory + "kernel");
+	std::filesystem::create_directories(txHashSetDirectory + "output");
+
+	const Hash block1 = Hash::ValueOf(1);
+	const Hash block2 = Hash::ValueOf(2);
+
+	{
+		std::unique_ptr<TxHashSetJournal> pJournal(TxHashSetJournal::Load(txHashSetDirectory));
+		REQUIRE_FALSE(pJournal->GetCommittedBlockHash().has_value());
+
+		File dataFile(txHashSetDirectory + "kernel/pmmr_data.bin");
+		LeafSet leafSet(txHashSetDirectory + "output/pmmr_leaf.bin");
+
+		// Block 1 is committed completely.
+		dataFile.Append({ 1, 2, 3, 4 });
+		leafSet.Add(0);
+		leafSet.Add(1);
+
+		TxHashSetJournal::Entry entry1;
+		entry1.blockHash = block1;
+		entry1.files["kernel/pmmr_data.bin"] = dataFile.GetPendingFlush();
+		entry1.leafSets["output/pmmr_leaf.bin"] = TxHashSetJournal::LeafSetChanges{ leafSet.GetAddedSinceFlush(), leafSet.GetRemovedSinceFlush() };
+		REQUIRE(pJournal->Begin(std::move(entry1)));
+		REQUIRE(dataFile.Flush());
+		REQUIRE(leafSet.Flush());
+		REQUIRE(pJournal->Complete());
+		REQUIRE(pJournal->GetCommittedBlockHash() == std::make_optional<Hash>(block1));
+
+		// Block 2 overwrites part of block 1's data, but is never completed.
+		REQUIRE(dataFile.Rewind(2));
+		dataFile.Append({ 5, 6, 7 });
+		leafSet.Remove(0);
+		leafSet.Add(5);
+
+		TxHashSetJournal::Entry entry2;
+		entry2.blockHash = block2;
+		entry2.files["kernel/pmmr_data.bin"] = dataFile.GetPendingFlush();
+		entry2.leafSets["output/pmmr_leaf.bin"] = TxHashSetJournal::LeafSetChanges{ leafSet.GetAddedSinceFlush(), leafSet.GetRemovedSinceFlush() };
+		REQUIRE(entry2.files["kernel/pmmr_data.bin"].overwrittenBytes == std::vector<unsigned char>({ 3, 4 }));
+		REQUIRE(pJournal->Begin(std::move(entry2)));
+		REQUIRE(dataFile.Flush());
+		REQUIRE(leafSet.Flush());
+		REQUIRE(std::filesystem::file_size(txHashSetDirectory + "kernel/pmmr_data.bin") == 5);
+
+		// Block 2's entry is the only way to undo its flush, so another commit can't replace it.
+		TxHashSetJournal::Entry entry3;
+		entry3.blockHash = Hash::ValueOf(3);
+		entry3.files["kernel/pmmr_data.bin"] = dataFile.GetPendingFlush();
+		REQUIRE_FALSE(pJournal->Begin(std::move(entry3)));
+	}
+
+	// Recovering twice must give the same result, in case of a crash during recovery.
+	for (int i = 0; i < 2; i++)
+	{
+		std::unique_ptr<TxHashSetJournal> pJournal(TxHashSetJournal::Load(txHashSetDirectory));
+		REQUIRE(pJournal->GetCommittedBlockHash() == std::make_optional<Hash>(block1));
+
+		File dataFile(txHashSetDirectory + "kernel/pmmr_data.bin");
+		REQUIRE(dataFile.Load());
+		REQUIRE(dataFile.GetSize() == 4);
+		REQUIRE(dataFile.ReadView(0, 4).ToVector() == std::vector<unsigned char>({ 1, 2, 3, 4 }));
+
+		LeafSet leafSet(txHashSetDirectory + "output/pmmr_leaf.bin");
+		REQUIRE(leafSet.Load());
+		REQUIRE(leafSet.Contains(0));
+		REQUIRE(leafSet.Contains(1));
+		REQUIRE_FALSE(leafSet.Contains(5));
+	}
+
+	std::filesystem::remove_all(txHashSetDirectory);
+}
@@ -0,0 +1,91 @@
+#include <ThirdParty/Catch2/catch.hpp>
+
+#include "../UTXOIndex.h"
+
+#include <vector>
+
+static Commitment CreateCommitment(const uint32_t value, const bool collide = false)
+{
+	std::vector<unsigned char> bytes(33, 0);
+	bytes[0] = 0x08;
+	for (size_t i = 0; i < 4; i++)
+	{
+		// When colliding, only bytes outside of the hashed range vary, so every commitment has the same home slot.
+		bytes[(collide ? 29 : 1) + i] = (unsigned char)(value >> (8 * i));
+	}
+
+	return Commitment(CBigInteger<33>(std::move(bytes)));
+}
+
+TEST_CASE("UTXOIndex - Add, remove, and discard")
+{
+	UTXOIndex index;
+
+	const uint32_t numOutputs = 100000;
+	for (uint32_t i = 0; i < numOutputs; i++)
+	{
+		index.AddCommitted(CreateCommitment(i), OutputLocation(i, i / 10));
+	}
+
+	REQUIRE(index.GetSize() == numOutputs);
+	REQUIRE(index.GetLocation(CreateCommitment(12345)).value().GetMMRIndex() == 12345);
+	REQUIRE(index.GetLocation(CreateCommitment(12345)).value().GetBlockHeight() == 1234);
+	REQUIRE_FALSE(index.GetLocation(CreateCommitment(numOutputs)).has_value());
+
+	// Spent outputs can still be found until committed.
+	for (uint32_t i = 0; i < numOutputs; i += 2)
+	{
+		index.MarkRemoved(CreateCommitment(i));
+	}
+
+	index.Add(CreateCommitment(numOutputs), OutputLocation(numOutputs, 0));
+	REQUIRE(index.GetLocation(CreateCommitment(0)).has_value());
+
+	index.Discard();
+	REQUIRE(index.GetSize() == numOutputs);
+	REQUIRE_FALSE(index.GetLocation(CreateCommitment(numOutputs)).has_value());
+
+	for (uint32_t i = 0; i < numOutputs; i += 2)
+	{
+		index.MarkRemoved(CreateCommitment(i));
+	}
+
+	// Output 0 was added back (ie. by a rewind) before the commit, so it stays.
+	index.Commit([](const uint64_t mmrIndex) { return mmrIndex == 0; });
+
+	REQUIRE(index.GetSize() == (numOutputs / 2) + 1);
+	REQUIRE(index.GetLocation(CreateCommitment(0)).has_value());
+	for (uint32_t i = 1; i < numOutputs; i++)
+	{
+		REQUIRE(index.GetLocation(CreateCommitment(i)).has_value() == (i % 2 == 1));
+	}
+}
+
+TEST_CASE("UTXOIndex - Colliding commitments")
+{
+	UTXOIndex index;
+
+	const uint32_t numOutputs = 1000;
+	for (uint32_t i = 0; i < numOutputs; i++)
+	{
+		index.Add(CreateCommitment(i, true), OutputLocation(i, 0));
+	}
+
+	// Removing from the middle of the probe sequence must not hide the entries after it.
+	for (uint32_t i = 0; i < numOutputs; i += 3)
+	{
+		index.MarkRemoved(CreateCommitment(i, true));
+	}
+
+	index.Commit([](const uint64_t) { return false; });
+
+	for (uint32_t i = 0; i < numOutputs; i++)
+	{
+		const std::optional<OutputLocation> locationOpt = index.GetLocation(CreateCommitment(i, true));
+		REQUIRE(locationOpt.has_value() == (i % 3 != 0));
+		if (locationOpt.has_value())
+		{
+			REQUIRE(locationOpt.value().GetMMRIndex() == i);
+		}
+	}
+}
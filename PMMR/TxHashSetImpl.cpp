@@ -8,22 +8,31 @@
 #include <Common/Util/StringUtil.h>
 #include <BlockChain/BlockChainServer.h>
 #include <Database/BlockDb.h>
+#include <Consensus/BlockTime.h>
+#include <Common/Util/ThreadUtil.h>
+#include <Infrastructure/ThreadManager.h>
 #include <Infrastructure/Logger.h>
 #include <async++.h>
 
-TxHashSet::TxHashSet(IBlockDB& blockDB, KernelMMR* pKernelMMR, OutputPMMR* pOutputPMMR, RangeProofPMMR* pRangeProofPMMR, const BlockHeader& blockHeader)
-	: m_blockDB(blockDB), m_pKernelMMR(pKernelMMR), m_pOutputPMMR(pOutputPMMR), m_pRangeProofPMMR(pRangeProofPMMR), m_blockHeader(blockHeader), m_blockHeaderBackup(blockHeader)
+// Compacting is mostly disk-bound, and the horizon only moves ~60 blocks an hour, so there's no need to do it more often.
+static const std::chrono::hours COMPACTION_INTERVAL = std::chrono::hours(1);
+
+TxHashSet::TxHashSet(IBlockDB& blockDB, TxHashSetJournal* pJournal, KernelMMR* pKernelMMR, OutputPMMR* pOutputPMMR, RangeProofPMMR* pRangeProofPMMR, const BlockHeader& blockHeader)
+	: m_blockDB(blockDB), m_pJournal(pJournal), m_pKernelMMR(pKernelMMR), m_pOutputPMMR(pOutputPMMR), m_pRangeProofPMMR(pRangeProofPMMR), m_blockHeader(blockHeader), m_blockHeaderBackup(blockHeader)
 {
 
 }
 
 TxHashSet::~TxHashSet()
 {
+	StopCompaction();
+
 	std::unique_lock<std::shared_mutex> writeLock(m_txHashSetMutex);
 
 	delete m_pKernelMMR;
 	delete m_pOutputPMMR;
 	delete m_pRangeProofPMMR;
+	delete m_pJournal;
 }
 
 bool TxHashSet::IsUnspent(const OutputLocation& location) const
@@ -33,6 +42,38 @@ bool TxHashSet::IsUnspent(const OutputLocation& location) const
 	return m_pOutputPMMR->IsUnspent(location.GetMMRIndex());
 }
 
+std::optional<OutputLocation> TxHashSet::GetOutputPosition(const Commitment& outputCommitment) const
+{
+	std::shared_lock<std::shared_mutex> readLock(m_txHashSetMutex);
+
+	return m_utxoIndex.GetLocation(outputCommitment);
+}
+
+void TxHashSet::LoadUTXOIndex()
+{
+	std::unique_lock<std::shared_mutex> writeLock(m_txHashSetMutex);
+
+	LoggerAPI::LogInfo("TxHashSet::LoadUTXOIndex - Loading unspent outputs.");
+
+	m_utxoIndex.Clear();
+
+	const uint64_t outputSize = m_pOutputPMMR->GetSize();
+	for (uint64_t mmrIndex = 0; mmrIndex < outputSize; mmrIndex++)
+	{
+		std::unique_ptr<OutputIdentifier> pOutput = m_pOutputPMMR->GetOutputAt(mmrIndex);
+		if (pOutput != nullptr)
+		{
+			std::optional<OutputLocation> locationOpt = m_blockDB.GetOutputPosition(pOutput->GetCommitment());
+			if (locationOpt.has_value() && locationOpt.value().GetMMRIndex() == mmrIndex)
+			{
+				m_utxoIndex.AddCommitted(pOutput->GetCommitment(), locationOpt.value());
+			}
+		}
+	}
+
+	LoggerAPI::LogInfo("TxHashSet::LoadUTXOIndex - Loaded " + std::to_string(m_utxoIndex.GetSize()) + " unspent outputs.");
+}
+
 bool TxHashSet::IsValid(const Transaction& transaction) const
 {
 	std::shared_lock<std::shared_mutex> readLock(m_txHashSetMutex);
@@ -41,7 +82,7 @@ bool TxHashSet::IsValid(const Transaction& transaction) const
 	for (const TransactionInput& input : transaction.GetBody().GetInputs())
 	{
 		const Commitment& commitment = input.GetCommitment();
-		std::optional<OutputLocation> outputPosOpt = m_blockDB.GetOutputPosition(commitment);
+		std::optional<OutputLocation> outputPosOpt = m_utxoIndex.GetLocation(commitment);
 		if (!outputPosOpt.has_value())
 		{
 			return false;
@@ -58,7 +99,7 @@ bool TxHashSet::IsValid(const Transaction& transaction) const
 	// Validate outputs
 	for (const TransactionOutput& output : transaction.GetBody().GetOutputs())
 	{
-		std::optional<OutputLocation> outputPosOpt = m_blockDB.GetOutputPosition(output.GetCommitment());
+		std::optional<OutputLocation> outputPosOpt = m_utxoIndex.GetLocation(output.GetCommitment());
 		if (outputPosOpt.has_value())
 		{
 			std::unique_ptr<OutputIdentifier> pOutput = m_pOutputPMMR->GetOutputAt(outputPosOpt.value().GetMMRIndex());
@@ -72,12 +113,12 @@ bool TxHashSet::IsValid(const Transaction& transaction) const
 	return true;
 }
 
-std::unique_ptr<BlockSums> TxHashSet::ValidateTxHashSet(const BlockHeader& header, const IBlockChainServer& blockChainServer)
+std::unique_ptr<BlockSums> TxHashSet::ValidateTxHashSet(const Config& config, const BlockHeader& header, const IBlockChainServer& blockChainServer)
 {
 	std::shared_lock<std::shared_mutex> readLock(m_txHashSetMutex);
 
 	LoggerAPI::LogInfo("TxHashSet::ValidateTxHashSet - Validating TxHashSet for block " + HexUtil::ConvertHash(header.GetHash()));
-	std::unique_ptr<BlockSums> pBlockSums = TxHashSetValidator(blockChainServer).Validate(*this, header);
+	std::unique_ptr<BlockSums> pBlockSums = TxHashSetValidator(config, blockChainServer).Validate(*this, header);
 	if (pBlockSums != nullptr)
 	{
 		LoggerAPI::LogInfo("TxHashSet::ValidateTxHashSet - Successfully validated TxHashSet.");
@@ -96,7 +137,7 @@ bool TxHashSet::ApplyBlock(const FullBlock& block)
 	for (const TransactionInput& input : block.GetTransactionBody().GetInputs())
 	{
 		const Commitment& commitment = input.GetCommitment();
-		std::optional<OutputLocation> outputPosOpt = m_blockDB.GetOutputPosition(commitment);
+		std::optional<OutputLocation> outputPosOpt = m_utxoIndex.GetLocation(commitment);
 		if (!outputPosOpt.has_value())
 		{
 			LoggerAPI::LogWarning("TxHashSet::ApplyBlock - Output position not found for commitment: " + HexUtil::ConvertToHex(commitment.GetCommitmentBytes().GetData()) + " in block: " + std::to_string(block.GetBlockHeader().GetHeight()));
@@ -116,6 +157,8 @@ bool TxHashSet::ApplyBlock(const FullBlock& block)
 			return false;
 		}
 
+		m_utxoIndex.MarkRemoved(commitment);
+
 		blockInputBitmap.add(mmrIndex + 1);
 	}
 
@@ -124,7 +167,7 @@ bool TxHashSet::ApplyBlock(const FullBlock& block)
 	// Append new outputs
 	for (const TransactionOutput& output : block.GetTransactionBody().GetOutputs())
 	{
-		std::optional<OutputLocation> outputPosOpt = m_blockDB.GetOutputPosition(output.GetCommitment());
+		std::optional<OutputLocation> outputPosOpt = m_utxoIndex.GetLocation(output.GetCommitment());
 		if (outputPosOpt.has_value())
 		{
 			if (outputPosOpt.value().GetMMRIndex() < m_blockHeader.GetOutputMMRSize())
@@ -137,11 +180,14 @@ bool TxHashSet::ApplyBlock(const FullBlock& block)
 			}
 		}
 
+		const uint64_t mmrIndex = m_pOutputPMMR->GetSize();
 		if (!m_pOutputPMMR->Append(OutputIdentifier::FromOutput(output), block.GetBlockHeader().GetHeight()))
 		{
 			return false;
 		}
 
+		m_utxoIndex.Add(output.GetCommitment(), OutputLocation(mmrIndex, block.GetBlockHeader().GetHeight()));
+
 		if (!m_pRangeProofPMMR->Append(output.GetRangeProof()))
 		{
 			return false;
@@ -186,7 +232,10 @@ bool TxHashSet::ValidateRoots(const BlockHeader& blockHeader) const
 
 bool TxHashSet::SaveOutputPositions(const BlockHeader& blockHeader, const uint64_t firstOutputIndex)
 {
-	std::shared_lock<std::shared_mutex> readLock(m_txHashSetMutex);
+	std::unique_lock<std::shared_mutex> writeLock(m_txHashSetMutex);
+
+	// Write all of the block's output positions at once.
+	ScopedBlockDBBatch batch(m_blockDB);
 
 	const uint64_t size = blockHeader.GetOutputMMRSize();
 	for (uint64_t mmrIndex = firstOutputIndex; mmrIndex < size; mmrIndex++)
@@ -194,11 +243,13 @@ bool TxHashSet::SaveOutputPositions(const BlockHeader& blockHeader, const uint64
 		std::unique_ptr<OutputIdentifier> pOutput = m_pOutputPMMR->GetOutputAt(mmrIndex);
 		if (pOutput != nullptr)
 		{
-			m_blockDB.AddOutputPosition(pOutput->GetCommitment(), OutputLocation(mmrIndex, blockHeader.GetHeight()));
+			const OutputLocation location(mmrIndex, blockHeader.GetHeight());
+			m_blockDB.AddOutputPosition(pOutput->GetCommitment(), location);
+			m_utxoIndex.AddCommitted(pOutput->GetCommitment(), location);
 		}
 	}
 
-	return true;
+	return batch.Commit();
 }
 
 std::vector<Hash> TxHashSet::GetLastKernelHashes(const uint64_t numberOfKernels) const
@@ -243,7 +294,7 @@ OutputRange TxHashSet::GetOutputsByLeafIndex(const uint64_t startIndex, const ui
 		if (pOutput != nullptr)
 		{
 			std::unique_ptr<RangeProof> pRangeProof = m_pRangeProofPMMR->GetRangeProofAt(mmrIndex);
-			std::optional<OutputLocation> locationOpt = m_blockDB.GetOutputPosition(pOutput->GetCommitment());
+			std::optional<OutputLocation> locationOpt = m_utxoIndex.GetLocation(pOutput->GetCommitment());
 			if (pRangeProof == nullptr || !locationOpt.has_value() || locationOpt.value().GetMMRIndex() != mmrIndex)
 			{
 				return OutputRange(0, 0, std::vector<OutputDisplayInfo>());
@@ -266,6 +317,12 @@ bool TxHashSet::Rewind(const BlockHeader& header)
 	Roaring leavesToAdd;
 	while (m_blockHeader != header)
 	{
+		if (m_blockHeader.GetHeight() <= header.GetHeight())
+		{
+			LoggerAPI::LogError("TxHashSet::Rewind - Block " + header.FormatHash() + " is not an ancestor of " + m_blockHeader.FormatHash());
+			return false;
+		}
+
 		std::optional<Roaring> blockInputBitmapOpt = m_blockDB.GetBlockInputBitmap(m_blockHeader.GetHash());
 		if (blockInputBitmapOpt.has_value())
 		{
@@ -279,10 +336,39 @@ bool TxHashSet::Rewind(const BlockHeader& header)
 		m_blockHeader = *m_blockDB.GetBlockHeader(m_blockHeader.GetPreviousBlockHash());
 	}
 
+	// Outputs added after the header are no longer unspent.
+	const uint64_t outputSize = m_pOutputPMMR->GetSize();
+	for (uint64_t mmrIndex = header.GetOutputMMRSize(); mmrIndex < outputSize; mmrIndex++)
+	{
+		std::unique_ptr<OutputIdentifier> pOutput = m_pOutputPMMR->GetOutputAt(mmrIndex);
+		if (pOutput != nullptr)
+		{
+			m_utxoIndex.MarkRemoved(pOutput->GetCommitment());
+		}
+	}
+
 	m_pKernelMMR->Rewind(header.GetKernelMMRSize());
 	m_pOutputPMMR->Rewind(header.GetOutputMMRSize(), std::make_optional<Roaring>(leavesToAdd));
 	m_pRangeProofPMMR->Rewind(header.GetOutputMMRSize(), std::make_optional<Roaring>(leavesToAdd));
 
+	// Outputs spent after the header are unspent again. They're only missing from the index if their spends were committed.
+	for (const uint32_t position : leavesToAdd)
+	{
+		std::unique_ptr<OutputIdentifier> pOutput = m_pOutputPMMR->GetOutputAt(position - 1);
+		if (pOutput != nullptr)
+		{
+			std::optional<OutputLocation> locationOpt = m_utxoIndex.GetLocation(pOutput->GetCommitment());
+			if (!locationOpt.has_value() || locationOpt.value().GetMMRIndex() != position - 1)
+			{
+				locationOpt = m_blockDB.GetOutputPosition(pOutput->GetCommitment());
+				if (locationOpt.has_value() && locationOpt.value().GetMMRIndex() == position - 1)
+				{
+					m_utxoIndex.Add(pOutput->GetCommitment(), locationOpt.value());
+				}
+			}
+		}
+	}
+
 	return true;
 }
 
@@ -290,6 +376,18 @@ bool TxHashSet::Commit()
 {
 	std::unique_lock<std::shared_mutex> writeLock(m_txHashSetMutex);
 
+	// Journal the changes first, so a crash while flushing can be undone on the next startup.
+	TxHashSetJournal::Entry journalEntry;
+	journalEntry.blockHash = m_blockHeader.GetHash();
+	m_pKernelMMR->AddToJournal(journalEntry);
+	m_pOutputPMMR->AddToJournal(journalEntry);
+	m_pRangeProofPMMR->AddToJournal(journalEntry);
+
+	if (!m_pJournal->Begin(std::move(journalEntry)))
+	{
+		return false;
+	}
+
 	async::task<bool> kernelTask = async::spawn([this] { return this->m_pKernelMMR->Flush(); });
 	async::task<bool> outputTask = async::spawn([this] { return this->m_pOutputPMMR->Flush(); });
 	async::task<bool> rangeProofTask = async::spawn([this] { return this->m_pRangeProofPMMR->Flush(); });
@@ -299,7 +397,26 @@ bool TxHashSet::Commit()
 		return std::get<0>(results).get() && std::get<1>(results).get() && std::get<2>(results).get();
 	}).get();
 
+	if (!flushed)
+	{
+		// The journal entry stays pending, so the partial flush is undone on the next startup.
+		LoggerAPI::LogError("TxHashSet::Commit - Failed to flush block " + m_blockHeader.FormatHash());
+		return false;
+	}
+
+	if (!m_pJournal->Complete())
+	{
+		return false;
+	}
+
 	m_blockHeaderBackup = m_blockHeader;
+	m_utxoIndex.Commit([this](const uint64_t mmrIndex) { return m_pOutputPMMR->IsUnspent(mmrIndex); });
+
+	if (!m_pendingCompactors.empty())
+	{
+		FinishCompaction();
+	}
+
 	return true;
 }
 
@@ -310,15 +427,188 @@ bool TxHashSet::Discard()
 	m_pKernelMMR->Discard();
 	m_pOutputPMMR->Discard();
 	m_pRangeProofPMMR->Discard();
+	m_utxoIndex.Discard();
 	m_blockHeader = m_blockHeaderBackup;
 	return true;
 }
 
 bool TxHashSet::Compact()
 {
+	std::vector<std::unique_ptr<PMMRCompactor>> compactors;
+
+	// Determine what can be pruned as of the last commit.
+	{
+		std::shared_lock<std::shared_mutex> readLock(m_txHashSetMutex);
+
+		if (!m_pendingCompactors.empty() || m_blockHeaderBackup.GetHeight() <= Consensus::CUT_THROUGH_HORIZON)
+		{
+			return true;
+		}
+
+		// Outputs spent after the horizon are still needed in case of a rewind.
+		const uint64_t horizonHeight = m_blockHeaderBackup.GetHeight() - Consensus::CUT_THROUGH_HORIZON;
+		std::unique_ptr<BlockHeader> pHorizonHeader = std::make_unique<BlockHeader>(m_blockHeaderBackup);
+		Roaring rewindRmPos;
+		while (pHorizonHeader->GetHeight() > horizonHeight)
+		{
+			std::optional<Roaring> blockInputBitmapOpt = m_blockDB.GetBlockInputBitmap(pHorizonHeader->GetHash());
+			if (!blockInputBitmapOpt.has_value())
+			{
+				LoggerAPI::LogWarning("TxHashSet::Compact - Input bitmap not found for block " + pHorizonHeader->FormatHash());
+				return false;
+			}
+
+			rewindRmPos |= blockInputBitmapOpt.value();
+
+			pHorizonHeader = m_blockDB.GetBlockHeader(pHorizonHeader->GetPreviousBlockHash());
+			if (pHorizonHeader == nullptr)
+			{
+				return false;
+			}
+		}
+
+		const std::string& txHashSetDirectory = m_pJournal->GetTxHashSetDirectory();
+		const uint64_t cutoffSize = pHorizonHeader->GetOutputMMRSize();
+
+		std::unique_ptr<PMMRCompactor> pOutputCompactor = PMMRCompactor::Create(txHashSetDirectory, "output", OUTPUT_SIZE, m_pOutputPMMR->GetLeafSet(), m_pOutputPMMR->GetPruneList(), cutoffSize, rewindRmPos);
+		if (pOutputCompactor != nullptr)
+		{
+			compactors.emplace_back(std::move(pOutputCompactor));
+		}
+
+		std::unique_ptr<PMMRCompactor> pRangeProofCompactor = PMMRCompactor::Create(txHashSetDirectory, "rangeproof", RANGE_PROOF_SIZE, m_pRangeProofPMMR->GetLeafSet(), m_pRangeProofPMMR->GetPruneList(), cutoffSize, rewindRmPos);
+		if (pRangeProofCompactor != nullptr)
+		{
+			compactors.emplace_back(std::move(pRangeProofCompactor));
+		}
+	}
+
+	if (compactors.empty())
+	{
+		return true;
+	}
+
+	// Nothing before the horizon changes, so the compacted copies can be written while blocks are still being processed.
+	for (const std::unique_ptr<PMMRCompactor>& pCompactor : compactors)
+	{
+		if (!pCompactor->WriteStagedFiles(m_terminate))
+		{
+			return false;
+		}
+	}
+
 	std::unique_lock<std::shared_mutex> writeLock(m_txHashSetMutex);
 
-	// TODO: Implement
+	m_pendingCompactors = std::move(compactors);
+	if (HasUncommittedChanges())
+	{
+		LoggerAPI::LogDebug("TxHashSet::Compact - Waiting for the next commit to finish compacting.");
+		return true;
+	}
+
+	return FinishCompaction();
+}
 
-	return true;
-}
\ No newline at end of file
+void TxHashSet::StartCompaction()
+{
+	StopCompaction();
+
+	m_terminate = false;
+	m_compactionThread = std::thread(Thread_Compact, std::ref(*this));
+}
+
+void TxHashSet::StopCompaction()
+{
+	m_terminate = true;
+
+	if (m_compactionThread.joinable())
+	{
+		m_compactionThread.join();
+	}
+}
+
+void TxHashSet::Thread_Compact(TxHashSet& txHashSet)
+{
+	ThreadManagerAPI::SetCurrentThreadName("COMPACTION_THREAD");
+	LoggerAPI::LogDebug("TxHashSet::Thread_Compact() - BEGIN");
+
+	while (!txHashSet.m_terminate)
+	{
+		ThreadUtil::SleepFor(COMPACTION_INTERVAL, txHashSet.m_terminate);
+		if (!txHashSet.m_terminate)
+		{
+			if (!txHashSet.Compact() && !txHashSet.m_terminate)
+			{
+				LoggerAPI::LogWarning("TxHashSet::Thread_Compact() - Compaction failed.");
+			}
+		}
+	}
+
+	LoggerAPI::LogDebug("TxHashSet::Thread_Compact() - END");
+}
+
+bool TxHashSet::HasUncommittedChanges() const
+{
+	TxHashSetJournal::Entry entry;
+	m_pOutputPMMR->AddToJournal(entry);
+	m_pRangeProofPMMR->AddToJournal(entry);
+
+	for (auto iter = entry.files.cbegin(); iter != entry.files.cend(); iter++)
+	{
+		if (iter->second.position != iter->second.flushedSize || iter->second.newSize != iter->second.flushedSize)
+		{
+			return true;
+		}
+	}
+
+	for (auto iter = entry.leafSets.cbegin(); iter != entry.leafSets.cend(); iter++)
+	{
+		if (!iter->second.added.isEmpty() || !iter->second.removed.isEmpty())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Must be called with the write lock held, and no uncommitted changes.
+bool TxHashSet::FinishCompaction()
+{
+	std::vector<std::unique_ptr<PMMRCompactor>> compactors = std::move(m_pendingCompactors);
+	m_pendingCompactors.clear();
+
+	std::vector<std::string> relativePaths;
+	for (const std::unique_ptr<PMMRCompactor>& pCompactor : compactors)
+	{
+		if (!pCompactor->Finalize())
+		{
+			return false;
+		}
+
+		const std::vector<std::string> paths = pCompactor->GetRelativePaths();
+		relativePaths.insert(relativePaths.end(), paths.cbegin(), paths.cend());
+	}
+
+	const bool replaced = m_pJournal->ReplaceFiles(relativePaths);
+	if (!replaced)
+	{
+		LoggerAPI::LogError("TxHashSet::FinishCompaction - Failed to replace compacted files.");
+	}
+
+	// Reload even if the replacement failed part way through, since some of the files may have been replaced.
+	const std::string& txHashSetDirectory = m_pJournal->GetTxHashSetDirectory();
+
+	delete m_pOutputPMMR;
+	m_pOutputPMMR = OutputPMMR::Load(txHashSetDirectory, m_blockDB);
+
+	delete m_pRangeProofPMMR;
+	m_pRangeProofPMMR = RangeProofPMMR::Load(txHashSetDirectory);
+
+	if (replaced)
+	{
+		LoggerAPI::LogInfo("TxHashSet::FinishCompaction - Pruned " + std::to_string(compactors.front()->GetNumLeavesPruned()) + " spent outputs.");
+	}
+
+	return replaced;
+}
@@ -3,17 +3,24 @@
 #include "KernelMMR.h"
 #include "OutputPMMR.h"
 #include "RangeProofPMMR.h"
+#include "TxHashSetJournal.h"
+#include "PMMRCompactor.h"
+#include "UTXOIndex.h"
 
 #include <PMMR/TxHashSet.h>
 #include <Config/Config.h>
+#include <atomic>
+#include <memory>
 #include <shared_mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 // TODO: Implement an "UpdateContext" object that can be committed to.
 class TxHashSet : public ITxHashSet
 {
 public:
-	TxHashSet(IBlockDB& blockDB, KernelMMR* pKernelMMR, OutputPMMR* pOutputPMMR, RangeProofPMMR* pRangeProofPMMR, const BlockHeader& blockHeader);
+	TxHashSet(IBlockDB& blockDB, TxHashSetJournal* pJournal, KernelMMR* pKernelMMR, OutputPMMR* pOutputPMMR, RangeProofPMMR* pRangeProofPMMR, const BlockHeader& blockHeader);
 	~TxHashSet();
 
 	inline void ReadLock() { m_txHashSetMutex.lock_shared(); }
@@ -21,9 +28,15 @@ public:
 	inline const BlockHeader& GetBlockHeader() const { return m_blockHeader; }
 	inline const BlockHeader& GetFlushedBlockHeader() const { return m_blockHeaderBackup; }
 
+	//
+	// Indexes the unspent outputs, using the locations saved in the BlockDB. Outputs without a saved location are skipped.
+	//
+	void LoadUTXOIndex();
+
 	virtual bool IsUnspent(const OutputLocation& location) const override final;
+	virtual std::optional<OutputLocation> GetOutputPosition(const Commitment& outputCommitment) const override final;
 	virtual bool IsValid(const Transaction& transaction) const override final;
-	virtual std::unique_ptr<BlockSums> ValidateTxHashSet(const BlockHeader& header, const IBlockChainServer& blockChainServer) override final;
+	virtual std::unique_ptr<BlockSums> ValidateTxHashSet(const Config& config, const BlockHeader& header, const IBlockChainServer& blockChainServer) override final;
 	virtual bool ApplyBlock(const FullBlock& block) override final;
 	virtual bool ValidateRoots(const BlockHeader& blockHeader) const override final;
 	virtual bool SaveOutputPositions(const BlockHeader& blockHeader, const uint64_t firstOutputIndex) override final;
@@ -38,19 +51,38 @@ public:
 	virtual bool Discard() override final;
 	virtual bool Compact() override final;
 
+	//
+	// Starts a thread that periodically calls Compact. It's stopped automatically when the TxHashSet is destroyed.
+	//
+	void StartCompaction();
+	void StopCompaction();
+
 	KernelMMR* GetKernelMMR() { return m_pKernelMMR; }
 	OutputPMMR* GetOutputPMMR() { return m_pOutputPMMR; }
 	RangeProofPMMR* GetRangeProofPMMR() { return m_pRangeProofPMMR; }
 
 private:
+	static void Thread_Compact(TxHashSet& txHashSet);
+
+	bool HasUncommittedChanges() const;
+	bool FinishCompaction();
+
 	IBlockDB& m_blockDB;
 
+	TxHashSetJournal* m_pJournal;
 	KernelMMR* m_pKernelMMR;
 	OutputPMMR* m_pOutputPMMR;
 	RangeProofPMMR* m_pRangeProofPMMR;
 
 	BlockHeader m_blockHeader;
 	BlockHeader m_blockHeaderBackup;
+	UTXOIndex m_utxoIndex;
+
+	// Compactions waiting for the next Commit to be finished.
+	std::vector<std::unique_ptr<PMMRCompactor>> m_pendingCompactors;
+
+	std::atomic_bool m_terminate = false;
+	std::thread m_compactionThread;
 
 	mutable std::shared_mutex m_txHashSetMutex;
 };
\ No newline at end of file
@@ -0,0 +1,508 @@
+#include "TxHashSetJournal.h"
+#include "Common/LeafSet.h"
+
+#include <Common/Util/FileUtil.h>
+#include <Common/Util/HexUtil.h>
+#include <Common/Util/StringUtil.h>
+#include <Core/Serialization/ByteBuffer.h>
+#include <Core/Serialization/Serializer.h>
+#include <Core/Serialization/DeserializationException.h>
+#include <Infrastructure/Logger.h>
+#include <filesystem>
+#include <fstream>
+
+#ifdef _WIN32
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <cerrno>
+#endif
+
+TxHashSetJournal::TxHashSetJournal(const std::string& txHashSetDirectory)
+	: m_txHashSetDirectory(txHashSetDirectory), m_path(txHashSetDirectory + "journal.bin")
+{
+
+}
+
+TxHashSetJournal* TxHashSetJournal::Load(const std::string& txHashSetDirectory)
+{
+	TxHashSetJournal* pJournal = new TxHashSetJournal(txHashSetDirectory);
+	if (!pJournal->Recover())
+	{
+		LoggerAPI::LogError("TxHashSetJournal::Load - Failed to recover TxHashSet from journal " + pJournal->m_path);
+	}
+
+	return pJournal;
+}
+
+bool TxHashSetJournal::Begin(Entry&& entry)
+{
+	if (m_pendingEntryOpt.has_value())
+	{
+		// The pending entry is the only record of how to undo its partial flush, so it must not be overwritten.
+		// It's undone when the journal is loaded on the next startup.
+		LoggerAPI::LogError("TxHashSetJournal::Begin - Commit of block " + HexUtil::ConvertHash(m_pendingEntryOpt.value().blockHash) + " is still pending.");
+		return false;
+	}
+
+	Record record;
+	record.status = EStatus::PENDING;
+	record.previousBlockHashOpt = m_committedBlockHashOpt;
+	record.entry = std::move(entry);
+
+	if (!Write(record))
+	{
+		LoggerAPI::LogError("TxHashSetJournal::Begin - Failed to write journal entry for block " + HexUtil::ConvertHash(record.entry.blockHash));
+		return false;
+	}
+
+	m_pendingEntryOpt = std::make_optional<Entry>(std::move(record.entry));
+	return true;
+}
+
+bool TxHashSetJournal::Complete()
+{
+	if (!m_pendingEntryOpt.has_value())
+	{
+		return false;
+	}
+
+	const Record record = CreateCompleteRecord(m_pendingEntryOpt.value());
+	if (!Write(record))
+	{
+		LoggerAPI::LogError("TxHashSetJournal::Complete - Failed to complete journal entry for block " + HexUtil::ConvertHash(record.entry.blockHash));
+		return false;
+	}
+
+	SetCommitted(record);
+	m_pendingEntryOpt = std::nullopt;
+	return true;
+}
+
+bool TxHashSetJournal::ReplaceFiles(const std::vector<std::string>& relativePaths)
+{
+	if (!m_committedBlockHashOpt.has_value() || m_pendingEntryOpt.has_value())
+	{
+		return false;
+	}
+
+	Entry entry;
+	entry.blockHash = m_committedBlockHashOpt.value();
+	for (const auto& committedFile : m_committedFileSizes)
+	{
+		entry.files[committedFile.first].newSize = committedFile.second;
+	}
+
+	for (const std::string& relativePath : relativePaths)
+	{
+		// Only sizes of files that are flushed by commits are tracked.
+		auto iter = entry.files.find(relativePath);
+		if (iter != entry.files.end())
+		{
+			std::error_code ec;
+			iter->second.newSize = (uint64_t)std::filesystem::file_size(GetStagedPath(m_txHashSetDirectory + relativePath), ec);
+			if (ec)
+			{
+				LoggerAPI::LogError("TxHashSetJournal::ReplaceFiles - Staged copy of " + relativePath + " not found.");
+				return false;
+			}
+		}
+	}
+
+	Record record = CreateCompleteRecord(entry);
+	record.status = EStatus::REPLACING;
+	record.replacedFiles = relativePaths;
+	if (!Write(record))
+	{
+		LoggerAPI::LogError("TxHashSetJournal::ReplaceFiles - Failed to write journal entry.");
+		return false;
+	}
+
+	return FinishReplacing(record);
+}
+
+// Finishing is idempotent, since a staged file no longer exists once it's been renamed.
+bool TxHashSetJournal::FinishReplacing(const Record& record)
+{
+	for (const std::string& relativePath : record.replacedFiles)
+	{
+		const std::string path = m_txHashSetDirectory + relativePath;
+		const std::string stagedPath = GetStagedPath(path);
+
+		std::error_code ec;
+		if (std::filesystem::exists(stagedPath, ec) && !FileUtil::RenameFile(stagedPath, path))
+		{
+			LoggerAPI::LogError("TxHashSetJournal::FinishReplacing - Failed to replace " + path);
+			return false;
+		}
+	}
+
+	Record complete = record;
+	complete.status = EStatus::COMPLETE;
+	complete.replacedFiles.clear();
+	if (!Write(complete))
+	{
+		return false;
+	}
+
+	SetCommitted(complete);
+	return true;
+}
+
+void TxHashSetJournal::SetCommitted(const Record& record)
+{
+	m_committedBlockHashOpt = std::make_optional<Hash>(record.entry.blockHash);
+
+	m_committedFileSizes.clear();
+	for (const auto& file : record.entry.files)
+	{
+		m_committedFileSizes[file.first] = file.second.newSize;
+	}
+}
+
+bool TxHashSetJournal::Recover()
+{
+	std::error_code ec;
+	if (!std::filesystem::exists(m_path, ec))
+	{
+		return true;
+	}
+
+	std::optional<Record> recordOpt = Read();
+	if (!recordOpt.has_value())
+	{
+		return false;
+	}
+
+	const Record& record = recordOpt.value();
+	if (record.status == EStatus::COMPLETE)
+	{
+		SetCommitted(record);
+		return VerifyFileSizes(record);
+	}
+
+	if (record.status == EStatus::REPLACING)
+	{
+		LoggerAPI::LogWarning("TxHashSetJournal::Recover - Finishing interrupted replacement of TxHashSet files.");
+		return FinishReplacing(record) && VerifyFileSizes(record);
+	}
+
+	LoggerAPI::LogWarning("TxHashSetJournal::Recover - Undoing interrupted commit of block " + HexUtil::ConvertHash(record.entry.blockHash));
+	if (!Undo(record))
+	{
+		return false;
+	}
+
+	if (!record.previousBlockHashOpt.has_value())
+	{
+		// Nothing was committed before the interrupted entry, so there's no state left to record.
+		std::filesystem::remove(m_path, ec);
+		return true;
+	}
+
+	// Record the restored state as complete, so the undo isn't repeated on the next startup.
+	Entry restored;
+	restored.blockHash = record.previousBlockHashOpt.value();
+	for (const auto& file : record.entry.files)
+	{
+		restored.files[file.first].newSize = file.second.flushedSize;
+	}
+
+	const Record complete = CreateCompleteRecord(restored);
+	if (!Write(complete))
+	{
+		return false;
+	}
+
+	SetCommitted(complete);
+	return true;
+}
+
+// Undoing is idempotent, so it's safe to crash and repeat it.
+bool TxHashSetJournal::Undo(const Record& record) const
+{
+	for (const auto& file : record.entry.files)
+	{
+		if (!UndoFlush(file.first, file.second))
+		{
+			return false;
+		}
+	}
+
+	for (const auto& leafSet : record.entry.leafSets)
+	{
+		if (!UndoLeafSetChanges(leafSet.first, leafSet.second))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool TxHashSetJournal::UndoFlush(const std::string& relativePath, const File::PendingFlush& pendingFlush) const
+{
+	const std::string path = m_txHashSetDirectory + relativePath;
+
+	std::error_code ec;
+	const uint64_t fileSize = std::filesystem::exists(path, ec) ? (uint64_t)std::filesystem::file_size(path, ec) : 0;
+	if (fileSize < pendingFlush.position)
+	{
+		// Flushing never cuts a file back further than the position, so the file was modified outside of the TxHashSet.
+		LoggerAPI::LogError(StringUtil::Format("TxHashSetJournal::UndoFlush - %s is only %llu bytes, but flush started at %llu.", path.c_str(), fileSize, pendingFlush.position));
+		return false;
+	}
+
+	if (pendingFlush.flushedSize == 0 && fileSize == 0)
+	{
+		return true;
+	}
+
+	std::filesystem::resize_file(path, pendingFlush.position, ec);
+	if (ec)
+	{
+		LoggerAPI::LogError("TxHashSetJournal::UndoFlush - Failed to truncate " + path);
+		return false;
+	}
+
+	if (!pendingFlush.overwrittenBytes.empty())
+	{
+		std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+		file.seekp(pendingFlush.position, std::ios::beg);
+		file.write((const char*)pendingFlush.overwrittenBytes.data(), pendingFlush.overwrittenBytes.size());
+		file.close();
+
+		if (file.fail())
+		{
+			LoggerAPI::LogError("TxHashSetJournal::UndoFlush - Failed to restore overwritten bytes of " + path);
+			return false;
+		}
+	}
+
+	std::filesystem::resize_file(path, pendingFlush.flushedSize, ec);
+
+	return !ec;
+}
+
+bool TxHashSetJournal::UndoLeafSetChanges(const std::string& relativePath, const LeafSetChanges& changes) const
+{
+	// The leafset file is replaced atomically, so it's either the old or the new one. Undoing the changes turns either into the old one.
+	LeafSet leafSet(m_txHashSetDirectory + relativePath);
+	leafSet.Load();
+	leafSet.ApplyChanges(changes.removed, changes.added);
+
+	return leafSet.Flush();
+}
+
+bool TxHashSetJournal::VerifyFileSizes(const Record& record) const
+{
+	for (const auto& file : record.entry.files)
+	{
+		const std::string path = m_txHashSetDirectory + file.first;
+
+		std::error_code ec;
+		const uint64_t fileSize = std::filesystem::exists(path, ec) ? (uint64_t)std::filesystem::file_size(path, ec) : 0;
+		if (fileSize != file.second.newSize)
+		{
+			LoggerAPI::LogError(StringUtil::Format("TxHashSetJournal::VerifyFileSizes - %s is %llu bytes, but %llu were committed.", path.c_str(), fileSize, file.second.newSize));
+			return false;
+		}
+	}
+
+	return true;
+}
+
+TxHashSetJournal::Record TxHashSetJournal::CreateCompleteRecord(const Entry& entry)
+{
+	// A complete record only needs the committed file sizes.
+	Record record;
+	record.status = EStatus::COMPLETE;
+	record.entry.blockHash = entry.blockHash;
+
+	for (const auto& file : entry.files)
+	{
+		File::PendingFlush committed;
+		committed.position = file.second.newSize;
+		committed.flushedSize = file.second.newSize;
+		committed.newSize = file.second.newSize;
+		record.entry.files[file.first] = std::move(committed);
+	}
+
+	return record;
+}
+
+static void SerializeBitmap(Serializer& serializer, const Roaring& bitmap)
+{
+	std::vector<unsigned char> bytes(bitmap.getSizeInBytes());
+	bitmap.write((char*)bytes.data());
+
+	serializer.Append<uint64_t>(bytes.size());
+	serializer.AppendByteVector(bytes);
+}
+
+static Roaring DeserializeBitmap(ByteBuffer& byteBuffer)
+{
+	const uint64_t numBytes = byteBuffer.ReadU64();
+	const std::vector<unsigned char> bytes = byteBuffer.ReadVector(numBytes);
+
+	return Roaring::readSafe((const char*)bytes.data(), bytes.size());
+}
+
+bool TxHashSetJournal::Write(const Record& record) const
+{
+	Serializer serializer;
+	serializer.Append<uint8_t>(record.status);
+	serializer.AppendBigInteger(record.entry.blockHash);
+	serializer.Append<uint8_t>(record.previousBlockHashOpt.has_value() ? 1 : 0);
+	serializer.AppendBigInteger(record.previousBlockHashOpt.value_or(ZERO_HASH));
+
+	serializer.Append<uint32_t>((uint32_t)record.entry.files.size());
+	for (const auto& file : record.entry.files)
+	{
+		serializer.AppendVarStr(file.first);
+		serializer.Append<uint64_t>(file.second.position);
+		serializer.Append<uint64_t>(file.second.flushedSize);
+		serializer.Append<uint64_t>(file.second.newSize);
+		serializer.Append<uint64_t>(file.second.overwrittenBytes.size());
+		serializer.AppendByteVector(file.second.overwrittenBytes);
+	}
+
+	serializer.Append<uint32_t>((uint32_t)record.entry.leafSets.size());
+	for (const auto& leafSet : record.entry.leafSets)
+	{
+		serializer.AppendVarStr(leafSet.first);
+		SerializeBitmap(serializer, leafSet.second.added);
+		SerializeBitmap(serializer, leafSet.second.removed);
+	}
+
+	serializer.Append<uint32_t>((uint32_t)record.replacedFiles.size());
+	for (const std::string& relativePath : record.replacedFiles)
+	{
+		serializer.AppendVarStr(relativePath);
+	}
+
+	// The journal is replaced atomically, so a crash never leaves a partially written entry.
+	return WriteDurably(m_path, serializer.GetBytes());
+}
+
+// Writes to a temp file that's synced before it replaces the journal, and the rename is synced before returning,
+// so the entry is on disk before any of the files it describes are flushed.
+bool TxHashSetJournal::WriteDurably(const std::string& path, const std::vector<unsigned char>& bytes)
+{
+	const std::string tmpPath = path + ".tmp";
+
+#ifdef _WIN32
+	HANDLE hFile = CreateFile(tmpPath.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	DWORD written = 0;
+	const bool synced = WriteFile(hFile, bytes.data(), (DWORD)bytes.size(), &written, NULL) && written == bytes.size() && FlushFileBuffers(hFile);
+	CloseHandle(hFile);
+
+	return synced && MoveFileEx(tmpPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+	const int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd == -1)
+	{
+		return false;
+	}
+
+	size_t written = 0;
+	while (written < bytes.size())
+	{
+		const ssize_t result = write(fd, bytes.data() + written, bytes.size() - written);
+		if (result == -1 && errno != EINTR)
+		{
+			close(fd);
+			return false;
+		}
+
+		written += result > 0 ? (size_t)result : 0;
+	}
+
+	const bool synced = fsync(fd) == 0;
+	if (close(fd) != 0 || !synced || rename(tmpPath.c_str(), path.c_str()) != 0)
+	{
+		return false;
+	}
+
+	// The rename is only durable once the directory is synced.
+	const std::string directory = std::filesystem::path(path).parent_path().string();
+	const int dirFd = open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+	if (dirFd == -1)
+	{
+		return false;
+	}
+
+	const bool dirSynced = fsync(dirFd) == 0;
+	close(dirFd);
+
+	return dirSynced;
+#endif
+}
+
+std::optional<TxHashSetJournal::Record> TxHashSetJournal::Read() const
+{
+	std::vector<unsigned char> bytes;
+	if (!FileUtil::ReadFile(m_path, bytes))
+	{
+		return std::nullopt;
+	}
+
+	try
+	{
+		ByteBuffer byteBuffer(bytes);
+
+		Record record;
+		record.status = (EStatus)byteBuffer.ReadU8();
+		record.entry.blockHash = byteBuffer.ReadBigInteger<32>();
+
+		const bool hasPrevious = byteBuffer.ReadU8() == 1;
+		const Hash previousBlockHash = byteBuffer.ReadBigInteger<32>();
+		if (hasPrevious)
+		{
+			record.previousBlockHashOpt = std::make_optional<Hash>(previousBlockHash);
+		}
+
+		const uint32_t numFiles = byteBuffer.ReadU32();
+		for (uint32_t i = 0; i < numFiles; i++)
+		{
+			const std::string relativePath = byteBuffer.ReadVarStr();
+
+			File::PendingFlush pendingFlush;
+			pendingFlush.position = byteBuffer.ReadU64();
+			pendingFlush.flushedSize = byteBuffer.ReadU64();
+			pendingFlush.newSize = byteBuffer.ReadU64();
+			pendingFlush.overwrittenBytes = byteBuffer.ReadVector(byteBuffer.ReadU64());
+			record.entry.files[relativePath] = std::move(pendingFlush);
+		}
+
+		const uint32_t numLeafSets = byteBuffer.ReadU32();
+		for (uint32_t i = 0; i < numLeafSets; i++)
+		{
+			const std::string relativePath = byteBuffer.ReadVarStr();
+
+			LeafSetChanges changes;
+			changes.added = DeserializeBitmap(byteBuffer);
+			changes.removed = DeserializeBitmap(byteBuffer);
+			record.entry.leafSets[relativePath] = std::move(changes);
+		}
+
+		const uint32_t numReplacedFiles = byteBuffer.ReadU32();
+		for (uint32_t i = 0; i < numReplacedFiles; i++)
+		{
+			record.replacedFiles.push_back(byteBuffer.ReadVarStr());
+		}
+
+		return std::make_optional<Record>(std::move(record));
+	}
+	catch (const DeserializationException&)
+	{
+		LoggerAPI::LogError("TxHashSetJournal::Read - Journal " + m_path + " is corrupt.");
+		return std::nullopt;
+	}
+}
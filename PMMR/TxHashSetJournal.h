@@ -0,0 +1,111 @@
+#pragma once
+
+#include <Core/File.h>
+#include <Crypto/Hash.h>
+#include <Core/CRoaring/roaring.hh>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+//
+// Write-ahead journal that makes TxHashSet commits atomic across the kernel, output, and rangeproof PMMRs.
+// Before any MMR file is flushed, everything needed to undo the flush (file sizes, overwritten bytes, and leafset changes)
+// is recorded as a pending entry. Once every file is flushed, the entry is marked complete.
+// On startup, an interrupted commit is undone, so the files always match the last complete entry
+// and the TxHashSet never needs to be resynced after a crash.
+// Whole files (ie. compacted copies) are replaced the same way: the replacement is recorded first, then finished on startup if interrupted.
+//
+class TxHashSetJournal
+{
+public:
+	struct LeafSetChanges
+	{
+		Roaring added;
+		Roaring removed;
+	};
+
+	struct Entry
+	{
+		Hash blockHash;
+
+		// Keyed by path relative to the TxHashSet directory.
+		std::map<std::string, File::PendingFlush> files;
+		std::map<std::string, LeafSetChanges> leafSets;
+	};
+
+	//
+	// Loads the journal and recovers the TxHashSet files to the last complete entry.
+	//
+	static TxHashSetJournal* Load(const std::string& txHashSetDirectory);
+
+	//
+	// Returns the hash of the block the TxHashSet files were last committed at, if known.
+	//
+	inline const std::optional<Hash>& GetCommittedBlockHash() const { return m_committedBlockHashOpt; }
+
+	inline const std::string& GetTxHashSetDirectory() const { return m_txHashSetDirectory; }
+
+	//
+	// Writes a pending entry. Must succeed before any of the files in the entry are flushed.
+	// Fails if a previous entry is still pending, since its partial flush can only be undone on startup.
+	//
+	bool Begin(Entry&& entry);
+
+	//
+	// Marks the pending entry complete. Must only be called once every file in the entry has been flushed.
+	//
+	bool Complete();
+
+	//
+	// Path that the replacement for a file must be written to before calling ReplaceFiles.
+	//
+	static std::string GetStagedPath(const std::string& path) { return path + ".staged"; }
+
+	//
+	// Replaces each of the files (given as relative paths) with its staged copy.
+	// Must only be called when there are no uncommitted changes. The replaced files must be reloaded afterwards.
+	//
+	bool ReplaceFiles(const std::vector<std::string>& relativePaths);
+
+private:
+	enum EStatus : uint8_t
+	{
+		PENDING = 0,
+		COMPLETE = 1,
+		REPLACING = 2
+	};
+
+	struct Record
+	{
+		EStatus status;
+		std::optional<Hash> previousBlockHashOpt;
+		Entry entry;
+		std::vector<std::string> replacedFiles;
+	};
+
+	TxHashSetJournal(const std::string& txHashSetDirectory);
+
+	bool Recover();
+	bool Undo(const Record& record) const;
+	bool UndoFlush(const std::string& relativePath, const File::PendingFlush& pendingFlush) const;
+	bool UndoLeafSetChanges(const std::string& relativePath, const LeafSetChanges& changes) const;
+	bool VerifyFileSizes(const Record& record) const;
+	bool FinishReplacing(const Record& record);
+	void SetCommitted(const Record& record);
+
+	static Record CreateCompleteRecord(const Entry& entry);
+
+	bool Write(const Record& record) const;
+	static bool WriteDurably(const std::string& path, const std::vector<unsigned char>& bytes);
+	std::optional<Record> Read() const;
+
+	const std::string m_txHashSetDirectory;
+	const std::string m_path;
+
+	std::optional<Hash> m_committedBlockHashOpt;
+	std::map<std::string, uint64_t> m_committedFileSizes;
+	std::optional<Entry> m_pendingEntryOpt;
+};
@@ -5,11 +5,12 @@
 #include "Zip/Zipper.h"
 
 #include <Common/Util/FileUtil.h>
+#include <Common/Util/HexUtil.h>
 #include <Common/Util/StringUtil.h>
 #include <Infrastructure/Logger.h>
 
 TxHashSetManager::TxHashSetManager(const Config& config, IBlockDB& blockDB)
-	: m_config(config), m_blockDB(blockDB), m_pTxHashSet(nullptr)
+	: m_config(config), m_blockDB(blockDB), m_pTxHashSet(nullptr), m_compactionEnabled(false)
 {
 
 }
@@ -18,21 +19,82 @@ ITxHashSet* TxHashSetManager::Open(const BlockHeader& confirmedTip)
 {
 	Close();
 
+	// Recover from the journal first, so the MMRs load the files as they were at the last complete commit.
+	TxHashSetJournal* pJournal = TxHashSetJournal::Load(m_config.GetTxHashSetDirectory());
+
 	KernelMMR* pKernelMMR = KernelMMR::Load(m_config.GetTxHashSetDirectory());
 	OutputPMMR* pOutputPMMR = OutputPMMR::Load(m_config.GetTxHashSetDirectory(), m_blockDB);
 	RangeProofPMMR* pRangeProofPMMR = RangeProofPMMR::Load(m_config.GetTxHashSetDirectory());
 
-	m_pTxHashSet = new TxHashSet(m_blockDB, pKernelMMR, pOutputPMMR, pRangeProofPMMR, confirmedTip);
+	const std::optional<Hash>& committedBlockHashOpt = pJournal->GetCommittedBlockHash();
+	if (committedBlockHashOpt.has_value() && committedBlockHashOpt.value() != confirmedTip.GetHash())
+	{
+		// The TxHashSet was committed before the chain was updated, so rewind it back to the confirmed tip.
+		std::unique_ptr<BlockHeader> pCommittedHeader = m_blockDB.GetBlockHeader(committedBlockHashOpt.value());
+		if (pCommittedHeader != nullptr)
+		{
+			LoggerAPI::LogWarning("TxHashSetManager::Open - TxHashSet was committed at " + pCommittedHeader->FormatHash() + ". Rewinding to " + confirmedTip.FormatHash());
+
+			TxHashSet* pTxHashSet = new TxHashSet(m_blockDB, pJournal, pKernelMMR, pOutputPMMR, pRangeProofPMMR, *pCommittedHeader);
+			pTxHashSet->LoadUTXOIndex();
+			if (!pTxHashSet->Rewind(confirmedTip) || !pTxHashSet->Commit())
+			{
+				// Returning the TxHashSet would leave it at a different block than the chain, so it must be resynced instead.
+				LoggerAPI::LogError("TxHashSetManager::Open - Failed to rewind TxHashSet to " + confirmedTip.FormatHash());
+				DestroyTxHashSet(pTxHashSet);
+				return nullptr;
+			}
+
+			SetTxHashSet(pTxHashSet);
+			return m_pTxHashSet;
+		}
+
+		LoggerAPI::LogError("TxHashSetManager::Open - Committed block " + HexUtil::ConvertHash(committedBlockHashOpt.value()) + " not found.");
+	}
+
+	TxHashSet* pTxHashSet = new TxHashSet(m_blockDB, pJournal, pKernelMMR, pOutputPMMR, pRangeProofPMMR, confirmedTip);
+	pTxHashSet->LoadUTXOIndex();
+	SetTxHashSet(pTxHashSet);
 
 	return m_pTxHashSet;
 }
 
-void TxHashSetManager::Flush()
+ITxHashSet* TxHashSetManager::Reset(const BlockHeader& genesisHeader)
 {
-	if (m_pTxHashSet != nullptr)
+	Close();
+
+	// Only the files are removed, since the MMRs expect their folders to exist.
+	std::vector<std::string> filePaths;
+	std::error_code ec;
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(m_config.GetTxHashSetDirectory(), ec))
 	{
-		m_pTxHashSet->Commit();
+		if (entry.is_regular_file(ec))
+		{
+			filePaths.push_back(entry.path().string());
+		}
 	}
+
+	for (const std::string& filePath : filePaths)
+	{
+		if (!FileUtil::RemoveFile(filePath))
+		{
+			LoggerAPI::LogError("TxHashSetManager::Reset - Failed to remove " + filePath);
+			return nullptr;
+		}
+	}
+
+	return Open(genesisHeader);
+}
+
+bool TxHashSetManager::Flush()
+{
+	if (m_pTxHashSet != nullptr && !m_pTxHashSet->Commit())
+	{
+		LoggerAPI::LogError("TxHashSetManager::Flush - Failed to commit TxHashSet.");
+		return false;
+	}
+
+	return true;
 }
 
 ITxHashSet* TxHashSetManager::LoadFromZip(const Config& config, IBlockDB& blockDB, const std::string& zipFilePath, const BlockHeader& blockHeader)
@@ -43,6 +105,10 @@ ITxHashSet* TxHashSetManager::LoadFromZip(const Config& config, IBlockDB& blockD
 		LoggerAPI::LogInfo(StringUtil::Format("TxHashSetAPI::LoadFromZip - %s extracted successfully.", zipFilePath.c_str()));
 		FileUtil::RemoveFile(zipFilePath);
 
+		// The journal describes the replaced files, so it no longer applies.
+		FileUtil::RemoveFile(config.GetTxHashSetDirectory() + "journal.bin");
+		TxHashSetJournal* pJournal = TxHashSetJournal::Load(config.GetTxHashSetDirectory());
+
 		KernelMMR* pKernelMMR = KernelMMR::Load(config.GetTxHashSetDirectory());
 		pKernelMMR->Rewind(blockHeader.GetKernelMMRSize());
 		pKernelMMR->Flush();
@@ -55,7 +121,10 @@ ITxHashSet* TxHashSetManager::LoadFromZip(const Config& config, IBlockDB& blockD
 		pRangeProofPMMR->Rewind(blockHeader.GetOutputMMRSize(), std::nullopt);
 		pRangeProofPMMR->Flush();
 
-		return new TxHashSet(blockDB, pKernelMMR, pOutputPMMR, pRangeProofPMMR, blockHeader);
+		// Any locations saved for a previous TxHashSet are replaced when the output positions are saved.
+		TxHashSet* pTxHashSet = new TxHashSet(blockDB, pJournal, pKernelMMR, pOutputPMMR, pRangeProofPMMR, blockHeader);
+		pTxHashSet->LoadUTXOIndex();
+		return pTxHashSet;
 	}
 
 	return nullptr;
@@ -84,15 +153,25 @@ bool TxHashSetManager::SaveSnapshot(const BlockHeader& blockHeader, const std::s
 
 	const BlockHeader flushedBlockHeader = pTxHashSet->GetFlushedBlockHeader();
 
+	// Compacted files may be staged, but they aren't part of the TxHashSet until they're swapped in.
+	for (const std::string& pmmrName : { "output", "rangeproof" })
+	{
+		for (const std::string& fileName : { "pmmr_hash.bin", "pmmr_data.bin", "pmmr_prun.bin" })
+		{
+			FileUtil::RemoveFile(TxHashSetJournal::GetStagedPath(snapshotDir + pmmrName + "/" + fileName));
+		}
+	}
+
 	// 3. Unlock TxHashSet
 	pTxHashSet->Unlock();
 
 	{
 		// 4. Load Snapshot TxHashSet
+		TxHashSetJournal* pJournal = TxHashSetJournal::Load(snapshotDir);
 		KernelMMR* pKernelMMR = KernelMMR::Load(snapshotDir);
 		OutputPMMR* pOutputPMMR = OutputPMMR::Load(snapshotDir, m_blockDB);
 		RangeProofPMMR* pRangeProofPMMR = RangeProofPMMR::Load(snapshotDir);
-		TxHashSet snapshotTxHashSet(m_blockDB, pKernelMMR, pOutputPMMR, pRangeProofPMMR, flushedBlockHeader);
+		TxHashSet snapshotTxHashSet(m_blockDB, pJournal, pKernelMMR, pOutputPMMR, pRangeProofPMMR, flushedBlockHeader);
 
 		// 5. Rewind Snapshot TxHashSet
 		if (!snapshotTxHashSet.Rewind(blockHeader))
@@ -138,6 +217,31 @@ void TxHashSetManager::SetTxHashSet(ITxHashSet* pTxHashSet)
 {
 	Close();
 	m_pTxHashSet = pTxHashSet;
+
+	if (m_compactionEnabled && m_pTxHashSet != nullptr)
+	{
+		((TxHashSet*)m_pTxHashSet)->StartCompaction();
+	}
+}
+
+void TxHashSetManager::StartCompaction()
+{
+	m_compactionEnabled = true;
+
+	if (m_pTxHashSet != nullptr)
+	{
+		((TxHashSet*)m_pTxHashSet)->StartCompaction();
+	}
+}
+
+void TxHashSetManager::StopCompaction()
+{
+	m_compactionEnabled = false;
+
+	if (m_pTxHashSet != nullptr)
+	{
+		((TxHashSet*)m_pTxHashSet)->StopCompaction();
+	}
 }
 
 void TxHashSetManager::DestroyTxHashSet(ITxHashSet* pTxHashSet)
@@ -7,14 +7,17 @@
 
 #include <Core/Validation/KernelSignatureValidator.h>
 #include <Core/Validation/KernelSumValidator.h>
+#include <Config/Config.h>
 #include <Consensus/Common.h>
 #include <Common/Util/HexUtil.h>
 #include <Infrastructure/Logger.h>
 #include <BlockChain/BlockChainServer.h>
 #include <async++.h>
+#include <deque>
+#include <thread>
 
-TxHashSetValidator::TxHashSetValidator(const IBlockChainServer& blockChainServer)
-	: m_blockChainServer(blockChainServer)
+TxHashSetValidator::TxHashSetValidator(const Config& config, const IBlockChainServer& blockChainServer)
+	: m_config(config), m_blockChainServer(blockChainServer)
 {
 
 }
@@ -33,16 +36,9 @@ std::unique_ptr<BlockSums> TxHashSetValidator::Validate(TxHashSet& txHashSet, co
 		return std::unique_ptr<BlockSums>(nullptr);
 	}
 
-	// Validate MMR hashes in parallel
-	async::task<bool> kernelTask = async::spawn([this, &kernelMMR] { return this->ValidateMMRHashes(kernelMMR); });
-	async::task<bool> outputTask = async::spawn([this, &outputPMMR] { return this->ValidateMMRHashes(outputPMMR); });
-	async::task<bool> rangeProofTask = async::spawn([this, &rangeProofPMMR] { return this->ValidateMMRHashes(rangeProofPMMR); });
+	// Validate MMR hashes. Each MMR is split into chunks which are validated in parallel.
+	const bool mmrHashesValidated = ValidateMMRHashes(kernelMMR) && ValidateMMRHashes(outputPMMR) && ValidateMMRHashes(rangeProofPMMR);
 
-	const bool mmrHashesValidated = async::when_all(kernelTask, outputTask, rangeProofTask).then(
-		[](std::tuple<async::task<bool>, async::task<bool>, async::task<bool>> results) -> bool {
-		return std::get<0>(results).get() && std::get<1>(results).get() && std::get<2>(results).get();
-	}).get();
-	
 	if (!mmrHashesValidated)
 	{
 		LoggerAPI::LogError("TxHashSetValidator::Validate - Invalid MMR hashes.");
@@ -115,48 +111,77 @@ bool TxHashSetValidator::ValidateSizes(TxHashSet& txHashSet, const BlockHeader&
 bool TxHashSetValidator::ValidateMMRHashes(const MMR& mmr) const
 {
 	const uint64_t size = mmr.GetSize();
-	for (uint64_t i = 0; i < size; i++)
+
+	std::vector<async::task<bool>> tasks;
+	for (uint64_t firstIndex = 0; firstIndex < size; firstIndex += MMR_HASH_CHUNK_SIZE)
+	{
+		const uint64_t lastIndex = (std::min)(size, firstIndex + MMR_HASH_CHUNK_SIZE);
+		tasks.push_back(async::spawn([&mmr, firstIndex, lastIndex] { return mmr.ValidateHashes(firstIndex, lastIndex); }));
+	}
+
+	// Wait for every chunk, even after a failure, since the tasks reference the MMR.
+	bool valid = true;
+	for (auto& task : tasks)
 	{
-		const uint64_t height = MMRUtil::GetHeight(i);
-		if (height > 0)
+		if (!task.get())
 		{
-			const std::unique_ptr<Hash> pParentHash = mmr.GetHashAt(i);
-			if (pParentHash != nullptr)
-			{
-				const uint64_t leftIndex = MMRUtil::GetLeftChildIndex(i, height);
-				const std::unique_ptr<Hash> pLeftHash = mmr.GetHashAt(leftIndex);
+			valid = false;
+		}
+	}
 
-				const uint64_t rightIndex = MMRUtil::GetRightChildIndex(i);
-				const std::unique_ptr<Hash> pRightHash = mmr.GetHashAt(rightIndex);
+	return valid;
+}
 
-				if (pLeftHash != nullptr && pRightHash != nullptr)
-				{
-					const Hash expectedHash = MMRHashUtil::HashParentWithIndex(*pLeftHash, *pRightHash, i);
-					if (*pParentHash != expectedHash)
-					{
-						LoggerAPI::LogError("TxHashSetValidator::ValidateMMRHashes - Invalid parent hash at index " + std::to_string(i));
-						return false;
-					}
-				}
-			}
+bool TxHashSetValidator::ValidateKernelHistory(const KernelMMR& kernelMMR, const BlockHeader& blockHeader) const
+{
+	const uint64_t numHeights = blockHeader.GetHeight() + 1;
+
+	std::vector<async::task<bool>> tasks;
+	for (uint64_t firstHeight = 0; firstHeight < numHeights; firstHeight += KERNEL_HISTORY_CHUNK_SIZE)
+	{
+		const uint64_t lastHeight = (std::min)(numHeights, firstHeight + KERNEL_HISTORY_CHUNK_SIZE);
+		tasks.push_back(async::spawn([this, &kernelMMR, firstHeight, lastHeight] { return this->ValidateKernelHistory(kernelMMR, firstHeight, lastHeight); }));
+	}
+
+	bool valid = true;
+	for (auto& task : tasks)
+	{
+		if (!task.get())
+		{
+			valid = false;
 		}
 	}
 
-	return true;
+	return valid;
 }
 
-bool TxHashSetValidator::ValidateKernelHistory(const KernelMMR& kernelMMR, const BlockHeader& blockHeader) const
+// Validates the kernel roots of the headers in [firstHeight, lastHeight) in a single pass,
+// growing the kernel MMR's peaks from one header's size to the next instead of recalculating them.
+bool TxHashSetValidator::ValidateKernelHistory(const KernelMMR& kernelMMR, const uint64_t firstHeight, const uint64_t lastHeight) const
 {
-	for (uint64_t height = 0; height <= blockHeader.GetHeight(); height++)
+	std::unique_ptr<MMRPeaks> pPeaks(nullptr);
+	for (uint64_t height = firstHeight; height < lastHeight; height++)
 	{
-		std::unique_ptr<BlockHeader> pHeader = m_blockChainServer.GetBlockHeaderByHeight(height, EChainType::CANDIDATE);
-		if (pHeader == nullptr)
+		// Only the kernel MMR size and root are needed, so the summary avoids loading and deserializing every header.
+		std::optional<HeaderSummary> summaryOpt = m_blockChainServer.GetHeaderSummaryByHeight(height, EChainType::CANDIDATE);
+		if (!summaryOpt.has_value())
 		{
 			LoggerAPI::LogError("TxHashSetValidator::ValidateKernelHistory - No header found at height " + std::to_string(height));
 			return false;
 		}
-		
-		if (kernelMMR.Root(pHeader->GetKernelMMRSize()) != pHeader->GetKernelRoot())
+
+		const HeaderSummary& summary = summaryOpt.value();
+		if (pPeaks == nullptr)
+		{
+			pPeaks = std::make_unique<MMRPeaks>(kernelMMR.GetPeaks(summary.GetKernelMMRSize()));
+		}
+		else if (!pPeaks->Grow(summary.GetKernelMMRSize()))
+		{
+			LoggerAPI::LogError("TxHashSetValidator::ValidateKernelHistory - Kernel MMR too small for header at height " + std::to_string(height));
+			return false;
+		}
+
+		if (pPeaks->Root() != summary.GetKernelRoot())
 		{
 			LoggerAPI::LogError("TxHashSetValidator::ValidateKernelHistory - Kernel root not matching for header at height " + std::to_string(height));
 			return false;
@@ -200,77 +225,118 @@ std::unique_ptr<BlockSums> TxHashSetValidator::ValidateKernelSums(TxHashSet& txH
 
 bool TxHashSetValidator::ValidateRangeProofs(TxHashSet& txHashSet, const BlockHeader& blockHeader) const
 {
+	// Rangeproofs are read from the MMRs on this thread and verified in batches across the thread pool.
+	// The number of batches in flight is bounded so the whole UTXO set is never loaded into memory at once.
+	const size_t maxBatchesInFlight = GetMaxBatchesInFlight();
+	const size_t batchSize = m_config.GetNodeConfig().GetRangeProofBatchSize();
+
+	std::deque<async::task<bool>> tasks;
+	bool valid = true;
+
 	std::vector<std::pair<Commitment, RangeProof>> rangeProofs;
+	rangeProofs.reserve(batchSize);
 
-	for (uint64_t mmrIndex = 0; mmrIndex < txHashSet.GetOutputPMMR()->GetSize(); mmrIndex++)
+	const OutputPMMR* pOutputPMMR = txHashSet.GetOutputPMMR();
+	const RangeProofPMMR* pRangeProofPMMR = txHashSet.GetRangeProofPMMR();
+	const uint64_t outputMMRSize = pOutputPMMR->GetSize();
+	for (uint64_t mmrIndex = 0; mmrIndex < outputMMRSize && valid; mmrIndex++)
 	{
-		std::unique_ptr<OutputIdentifier> pOutput = txHashSet.GetOutputPMMR()->GetOutputAt(mmrIndex);
+		std::unique_ptr<OutputIdentifier> pOutput = pOutputPMMR->GetOutputAt(mmrIndex);
 		if (pOutput != nullptr)
 		{
-			std::unique_ptr<RangeProof> pRangeProof = txHashSet.GetRangeProofPMMR()->GetRangeProofAt(mmrIndex);
+			std::unique_ptr<RangeProof> pRangeProof = pRangeProofPMMR->GetRangeProofAt(mmrIndex);
 			if (pRangeProof == nullptr)
 			{
 				LoggerAPI::LogError("TxHashSetValidator::ValidateRangeProofs - No rangeproof found at mmr index " + std::to_string(mmrIndex));
-				return false;
+				valid = false;
+				break;
 			}
 
-			rangeProofs.emplace_back(std::make_pair<Commitment, RangeProof>(Commitment(pOutput->GetCommitment()), RangeProof(*pRangeProof)));
+			rangeProofs.emplace_back(std::make_pair<Commitment, RangeProof>(Commitment(pOutput->GetCommitment()), std::move(*pRangeProof)));
 
-			if (rangeProofs.size() >= 1000)
+			if (rangeProofs.size() >= batchSize)
 			{
-				if (!Crypto::VerifyRangeProofs(rangeProofs))
+				if (tasks.size() >= maxBatchesInFlight)
 				{
-					return false;
+					valid = tasks.front().get();
+					tasks.pop_front();
 				}
 
-				rangeProofs.clear();
+				tasks.push_back(async::spawn([batch = std::move(rangeProofs)] { return Crypto::VerifyRangeProofs(batch); }));
+				rangeProofs = std::vector<std::pair<Commitment, RangeProof>>();
+				rangeProofs.reserve(batchSize);
 			}
 		}
 	}
 
-	if (!rangeProofs.empty())
+	if (valid && !rangeProofs.empty())
+	{
+		tasks.push_back(async::spawn([batch = std::move(rangeProofs)] { return Crypto::VerifyRangeProofs(batch); }));
+	}
+
+	for (auto& task : tasks)
 	{
-		if (!Crypto::VerifyRangeProofs(rangeProofs))
+		if (!task.get())
 		{
-			return false;
+			valid = false;
 		}
 	}
 	
-	return true;
+	return valid;
 }
 
 bool TxHashSetValidator::ValidateKernelSignatures(const KernelMMR& kernelMMR) const
 {
+	// Each batch of kernels is verified with a single batch signature verification, with batches spread across threads.
+	// Like rangeproofs, the number of batches in flight is bounded so the whole kernel set is never loaded into memory at once.
+	const size_t maxBatchesInFlight = GetMaxBatchesInFlight();
+
+	std::deque<async::task<bool>> tasks;
+	bool valid = true;
+
 	std::vector<TransactionKernel> kernels;
+	kernels.reserve(KERNEL_SIGNATURE_BATCH_SIZE);
 
 	const uint64_t mmrSize = kernelMMR.GetSize();
-	const uint64_t numKernels = MMRUtil::GetNumLeaves(mmrSize);
-	for (uint64_t i = 0; i < mmrSize; i++)
+	for (uint64_t i = 0; i < mmrSize && valid; i++)
 	{
 		std::unique_ptr<TransactionKernel> pKernel = kernelMMR.GetKernelAt(i);
 		if (pKernel != nullptr)
 		{
-			kernels.push_back(*pKernel);
+			kernels.emplace_back(std::move(*pKernel));
 
-			if (kernels.size() >= 2000)
+			if (kernels.size() >= KERNEL_SIGNATURE_BATCH_SIZE)
 			{
-				if (!KernelSignatureValidator::VerifyKernelSignatures(kernels))
+				if (tasks.size() >= maxBatchesInFlight)
 				{
-					return false;
+					valid = tasks.front().get();
+					tasks.pop_front();
 				}
 
-				kernels.clear();
+				tasks.push_back(async::spawn([batch = std::move(kernels)] { return KernelSignatureValidator::VerifyKernelSignatures(batch); }));
+				kernels = std::vector<TransactionKernel>();
+				kernels.reserve(KERNEL_SIGNATURE_BATCH_SIZE);
 			}
 		}
 	}
 
-	if (!kernels.empty())
+	if (valid && !kernels.empty())
+	{
+		tasks.push_back(async::spawn([batch = std::move(kernels)] { return KernelSignatureValidator::VerifyKernelSignatures(batch); }));
+	}
+
+	for (auto& task : tasks)
 	{
-		if (!KernelSignatureValidator::VerifyKernelSignatures(kernels))
+		if (!task.get())
 		{
-			return false;
+			valid = false;
 		}
 	}
 
-	return true;
-}
\ No newline at end of file
+	return valid;
+}
+
+size_t TxHashSetValidator::GetMaxBatchesInFlight()
+{
+	return 2 * (std::max)(std::thread::hardware_concurrency(), 1u);
+}
@@ -10,22 +10,38 @@ class KernelMMR;
 class IBlockChainServer;
 class MMR;
 class Commitment;
+class Config;
 
 class TxHashSetValidator
 {
 public:
-	TxHashSetValidator(const IBlockChainServer& blockChainServer);
+	TxHashSetValidator(const Config& config, const IBlockChainServer& blockChainServer);
 
 	std::unique_ptr<BlockSums> Validate(TxHashSet& txHashSet, const BlockHeader& blockHeader) const;
 
 private:
+	// Number of MMR nodes whose hashes are validated by a single task.
+	static const uint64_t MMR_HASH_CHUNK_SIZE = 65536;
+
 	bool ValidateSizes(TxHashSet& txHashSet, const BlockHeader& blockHeader) const;
 	bool ValidateMMRHashes(const MMR& mmr) const;
 
+	// Number of block heights whose kernel roots are validated by a single task.
+	static const uint64_t KERNEL_HISTORY_CHUNK_SIZE = 8192;
+
 	bool ValidateKernelHistory(const KernelMMR& kernelMMR, const BlockHeader& blockHeader) const;
+	bool ValidateKernelHistory(const KernelMMR& kernelMMR, const uint64_t firstHeight, const uint64_t lastHeight) const;
 	std::unique_ptr<BlockSums> ValidateKernelSums(TxHashSet& txHashSet, const BlockHeader& blockHeader) const;
 	bool ValidateRangeProofs(TxHashSet& txHashSet, const BlockHeader& blockHeader) const;
+
+	// Number of kernel signatures verified together by a single task.
+	static const size_t KERNEL_SIGNATURE_BATCH_SIZE = 2000;
+
 	bool ValidateKernelSignatures(const KernelMMR& kernelMMR) const;
 
+	// Maximum number of rangeproof or kernel signature batches that are read but not yet verified.
+	static size_t GetMaxBatchesInFlight();
+
+	const Config& m_config;
 	const IBlockChainServer& m_blockChainServer;
 };
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "UTXOIndex.h"
+
+#include <cstring>
+
+static const size_t INITIAL_CAPACITY = 1 << 16;
+
+static size_t GetHomeSlot(const unsigned char* pCommitment, const size_t mask)
+{
+	// The first byte of a commitment is always 0x08 or 0x09, and the rest should be random.
+	// The bits are still mixed, so clusters can't form from commitments that aren't.
+	uint64_t hash;
+	memcpy(&hash, pCommitment + 1, sizeof(uint64_t));
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+
+	return (size_t)hash & mask;
+}
+
+UTXOIndex::UTXOIndex()
+	: m_entries(INITIAL_CAPACITY), m_size(0)
+{
+
+}
+
+std::optional<OutputLocation> UTXOIndex::GetLocation(const Commitment& commitment) const
+{
+	const Entry& entry = m_entries[FindSlot(commitment.GetCommitmentBytes().data())];
+	if (entry.occupied)
+	{
+		return std::make_optional<OutputLocation>(entry.mmrIndex, entry.blockHeight);
+	}
+
+	return std::nullopt;
+}
+
+void UTXOIndex::AddCommitted(const Commitment& commitment, const OutputLocation& location)
+{
+	Put(commitment, location);
+}
+
+void UTXOIndex::Add(const Commitment& commitment, const OutputLocation& location)
+{
+	m_undoLog.emplace_back(std::make_pair(commitment, GetLocation(commitment)));
+	Put(commitment, location);
+}
+
+void UTXOIndex::MarkRemoved(const Commitment& commitment)
+{
+	m_removed.push_back(commitment);
+}
+
+void UTXOIndex::Commit(const std::function<bool(const uint64_t mmrIndex)>& isUnspent)
+{
+	for (const Commitment& commitment : m_removed)
+	{
+		std::optional<OutputLocation> locationOpt = GetLocation(commitment);
+		if (locationOpt.has_value() && !isUnspent(locationOpt.value().GetMMRIndex()))
+		{
+			Erase(commitment);
+		}
+	}
+
+	m_removed.clear();
+	m_undoLog.clear();
+}
+
+void UTXOIndex::Discard()
+{
+	for (auto iter = m_undoLog.crbegin(); iter != m_undoLog.crend(); iter++)
+	{
+		if (iter->second.has_value())
+		{
+			Put(iter->first, iter->second.value());
+		}
+		else
+		{
+			Erase(iter->first);
+		}
+	}
+
+	m_removed.clear();
+	m_undoLog.clear();
+}
+
+void UTXOIndex::Clear()
+{
+	m_entries = std::vector<Entry>(INITIAL_CAPACITY);
+	m_size = 0;
+	m_removed.clear();
+	m_undoLog.clear();
+}
+
+// Returns the slot containing the commitment, or the empty slot where it belongs.
+size_t UTXOIndex::FindSlot(const unsigned char* pCommitment) const
+{
+	const size_t mask = m_entries.size() - 1;
+	size_t slot = GetHomeSlot(pCommitment, mask);
+	while (m_entries[slot].occupied && memcmp(m_entries[slot].commitment, pCommitment, 33) != 0)
+	{
+		slot = (slot + 1) & mask;
+	}
+
+	return slot;
+}
+
+void UTXOIndex::Put(const Commitment& commitment, const OutputLocation& location)
+{
+	// Keep the load factor at or below 1/2, so probe sequences stay short.
+	if ((m_size + 1) * 2 > m_entries.size())
+	{
+		Grow();
+	}
+
+	const unsigned char* pCommitment = commitment.GetCommitmentBytes().data();
+	Entry& entry = m_entries[FindSlot(pCommitment)];
+	if (!entry.occupied)
+	{
+		memcpy(entry.commitment, pCommitment, 33);
+		entry.occupied = true;
+		m_size++;
+	}
+
+	entry.mmrIndex = location.GetMMRIndex();
+	entry.blockHeight = location.GetBlockHeight();
+}
+
+// Uses backward shift deletion, so lookups never need to skip over tombstones.
+void UTXOIndex::Erase(const Commitment& commitment)
+{
+	size_t slot = FindSlot(commitment.GetCommitmentBytes().data());
+	if (!m_entries[slot].occupied)
+	{
+		return;
+	}
+
+	const size_t mask = m_entries.size() - 1;
+	size_t next = (slot + 1) & mask;
+	while (m_entries[next].occupied)
+	{
+		const size_t home = GetHomeSlot(m_entries[next].commitment, mask);
+
+		// Move the entry back if the empty slot is between its home slot and where it is now.
+		if (((next - home) & mask) >= ((next - slot) & mask))
+		{
+			m_entries[slot] = m_entries[next];
+			slot = next;
+		}
+
+		next = (next + 1) & mask;
+	}
+
+	m_entries[slot].occupied = false;
+	m_size--;
+}
+
+void UTXOIndex::Grow()
+{
+	std::vector<Entry> entries(m_entries.size() * 2);
+	entries.swap(m_entries);
+
+	const size_t mask = m_entries.size() - 1;
+	for (const Entry& entry : entries)
+	{
+		if (entry.occupied)
+		{
+			size_t slot = GetHomeSlot(entry.commitment, mask);
+			while (m_entries[slot].occupied)
+			{
+				slot = (slot + 1) & mask;
+			}
+
+			m_entries[slot] = entry;
+		}
+	}
+}
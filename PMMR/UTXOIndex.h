@@ -0,0 +1,68 @@
+#pragma once
+
+#include <Crypto/Commitment.h>
+#include <Core/Models/OutputLocation.h>
+
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+
+//
+// In-memory index of output commitment -> OutputLocation for the unspent outputs, so inputs can be looked up
+// without reading the OUTPUT_POS column of the BlockDB.
+// The table is open-addressed with linear probing, storing the commitments inline, so a lookup is usually a single cache line.
+//
+// Changes are tracked like the MMRs: added outputs can be discarded, and spent or rewound outputs aren't removed until Commit.
+// Until then, they can still be looked up, since the block being applied may need their locations (ie. for coinbase maturity).
+// Callers must check the output PMMR to know whether an output is actually unspent.
+//
+class UTXOIndex
+{
+public:
+	UTXOIndex();
+
+	std::optional<OutputLocation> GetLocation(const Commitment& commitment) const;
+	inline size_t GetSize() const { return m_size; }
+
+	//
+	// Adds an output that's already committed. Not undone by Discard.
+	//
+	void AddCommitted(const Commitment& commitment, const OutputLocation& location);
+
+	//
+	// Adds an output, replacing any existing location for the same commitment.
+	//
+	void Add(const Commitment& commitment, const OutputLocation& location);
+
+	//
+	// Marks an output as spent or rewound. It's removed on Commit, unless isUnspent says it was added back since.
+	//
+	void MarkRemoved(const Commitment& commitment);
+
+	void Commit(const std::function<bool(const uint64_t mmrIndex)>& isUnspent);
+	void Discard();
+	void Clear();
+
+private:
+	struct Entry
+	{
+		unsigned char commitment[33];
+		bool occupied;
+		uint64_t mmrIndex;
+		uint64_t blockHeight;
+	};
+
+	size_t FindSlot(const unsigned char* pCommitment) const;
+	void Put(const Commitment& commitment, const OutputLocation& location);
+	void Erase(const Commitment& commitment);
+	void Grow();
+
+	std::vector<Entry> m_entries;
+	size_t m_size;
+
+	// Previous locations of added outputs, in the order they were added, for Discard.
+	std::vector<std::pair<Commitment, std::optional<OutputLocation>>> m_undoLog;
+	std::vector<Commitment> m_removed;
+};
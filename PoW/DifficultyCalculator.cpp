@@ -24,13 +24,13 @@ DifficultyCalculator::DifficultyCalculator(const IBlockDB& blockDB)
 //
 // The secondary proof-of-work factor is calculated along the same lines, as
 // an adjustment on the deviation against the ideal value.
-HeaderInfo DifficultyCalculator::CalculateNextDifficulty(const BlockHeader& header) const
+HeaderInfo DifficultyCalculator::CalculateNextDifficulty(const BlockHeader& header, const std::vector<BlockHeader>* pPendingHeaders) const
 {
 	// Create vector of difficulty data running from earliest
 	// to latest, and pad with simulated pre-genesis data to allow earlier
 	// adjustment if there isn't enough window data length will be
 	// DIFFICULTY_ADJUST_WINDOW + 1 (for initial block time bound)
-	const std::vector<HeaderInfo> difficultyData = DifficultyLoader(m_blockDB).LoadDifficultyData(header);
+	const std::vector<HeaderInfo> difficultyData = DifficultyLoader(m_blockDB).LoadDifficultyData(header, pPendingHeaders);
 
 	// First, get the ratio of secondary PoW vs primary, skipping initial header
 	const std::vector<HeaderInfo> difficultyDataSkipFirst(difficultyData.cbegin() + 1, difficultyData.cend());
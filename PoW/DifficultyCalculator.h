@@ -10,7 +10,7 @@ class DifficultyCalculator
 public:
 	DifficultyCalculator(const IBlockDB& blockDB);
 
-	HeaderInfo CalculateNextDifficulty(const BlockHeader& blockHeader) const;
+	HeaderInfo CalculateNextDifficulty(const BlockHeader& blockHeader, const std::vector<BlockHeader>* pPendingHeaders = nullptr) const;
 
 private:
 	uint64_t ARCount(const std::vector<HeaderInfo>& difficultyData) const;
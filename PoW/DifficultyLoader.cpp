@@ -1,10 +1,6 @@
 #include "DifficultyLoader.h"
 
 #include <Consensus/BlockDifficulty.h>
-#include <lru/cache.hpp>
-
-// TODO: A FIFO cache would be more appropriate.
-LRU::Cache<Hash, BlockHeader> BLOCK_HEADERS_CACHE(128);
 
 DifficultyLoader::DifficultyLoader(const IBlockDB& blockDB)
 	: m_blockDB(blockDB)
@@ -12,13 +8,13 @@ DifficultyLoader::DifficultyLoader(const IBlockDB& blockDB)
 
 }
 
-std::vector<HeaderInfo> DifficultyLoader::LoadDifficultyData(const BlockHeader& header) const
+std::vector<HeaderInfo> DifficultyLoader::LoadDifficultyData(const BlockHeader& header, const std::vector<BlockHeader>* pPendingHeaders) const
 {
 	const size_t numBlocksNeeded = Consensus::DIFFICULTY_ADJUST_WINDOW + 1;
 	std::vector<HeaderInfo> difficultyData;
 	difficultyData.reserve(numBlocksNeeded);
 
-	std::unique_ptr<BlockHeader> pHeader = LoadHeader(header.GetPreviousBlockHash());
+	std::unique_ptr<BlockHeader> pHeader = LoadHeader(header.GetPreviousBlockHash(), header.GetHeight() - 1, pPendingHeaders);
 	while (difficultyData.size() < numBlocksNeeded && pHeader != nullptr)
 	{
 		const int64_t timestamp = pHeader->GetTimestamp();
@@ -26,7 +22,7 @@ std::vector<HeaderInfo> DifficultyLoader::LoadDifficultyData(const BlockHeader&
 		const uint32_t scalingFactor = pHeader->GetScalingDifficulty();
 		const bool secondary = pHeader->GetProofOfWork().IsSecondary();
 
-		pHeader = LoadHeader(pHeader->GetPreviousBlockHash());
+		pHeader = pHeader->GetHeight() == 0 ? nullptr : LoadHeader(pHeader->GetPreviousBlockHash(), pHeader->GetHeight() - 1, pPendingHeaders);
 		if (pHeader != nullptr)
 		{
 			const uint64_t difficulty = totalDifficulty - pHeader->GetTotalDifficulty();
@@ -39,28 +35,26 @@ std::vector<HeaderInfo> DifficultyLoader::LoadDifficultyData(const BlockHeader&
 		}
 	}
 
-	BLOCK_HEADERS_CACHE.insert(header.GetHash(), header);
-
 	return PadDifficultyData(difficultyData);
 }
 
-std::unique_ptr<BlockHeader> DifficultyLoader::LoadHeader(const Hash& headerHash) const
+// The BlockDB caches deserialized headers, so walking back through the window is cheap.
+std::unique_ptr<BlockHeader> DifficultyLoader::LoadHeader(const Hash& headerHash, const uint64_t height, const std::vector<BlockHeader>* pPendingHeaders) const
 {
-	auto iter = BLOCK_HEADERS_CACHE.find(headerHash);
-	if (iter != BLOCK_HEADERS_CACHE.end())
-	{
-		return std::make_unique<BlockHeader>(iter->second);
-	}
-	else
+	if (pPendingHeaders != nullptr && !pPendingHeaders->empty())
 	{
-		std::unique_ptr<BlockHeader> pHeader = m_blockDB.GetBlockHeader(headerHash);
-		if (pHeader != nullptr)
+		const uint64_t firstHeight = pPendingHeaders->front().GetHeight();
+		if (height >= firstHeight && (height - firstHeight) < pPendingHeaders->size())
 		{
-			BLOCK_HEADERS_CACHE.insert(headerHash, *pHeader);
+			const BlockHeader& pendingHeader = (*pPendingHeaders)[height - firstHeight];
+			if (pendingHeader.GetHash() == headerHash)
+			{
+				return std::make_unique<BlockHeader>(pendingHeader);
+			}
 		}
-
-		return pHeader;
 	}
+
+	return m_blockDB.GetBlockHeader(headerHash);
 }
 
 // Converts an iterator of block difficulty data to more a more manageable
@@ -11,10 +11,14 @@ class DifficultyLoader
 public:
 	DifficultyLoader(const IBlockDB& blockDB);
 
-	std::vector<HeaderInfo> LoadDifficultyData(const BlockHeader& header) const;
+	//
+	// pPendingHeaders are consecutive headers (ordered by height) that were validated but aren't stored in the BlockDB yet.
+	// They're checked before the BlockDB, so a chunk of sync headers can be validated before it's written in a single batch.
+	//
+	std::vector<HeaderInfo> LoadDifficultyData(const BlockHeader& header, const std::vector<BlockHeader>* pPendingHeaders = nullptr) const;
 
 private:
-	std::unique_ptr<BlockHeader> LoadHeader(const Hash& headerHash) const;
+	std::unique_ptr<BlockHeader> LoadHeader(const Hash& headerHash, const uint64_t height, const std::vector<BlockHeader>* pPendingHeaders) const;
 	std::vector<HeaderInfo> PadDifficultyData(std::vector<HeaderInfo>& difficultyData) const;
 
 	const IBlockDB& m_blockDB;
@@ -11,4 +11,14 @@ PoWManager::PoWManager(const Config& config, const IBlockDB& blockDB)
 bool PoWManager::IsPoWValid(const BlockHeader& header, const BlockHeader& previousHeader) const
 {
 	return PoWValidator(m_config, m_blockDB).IsPoWValid(header, previousHeader);
+}
+
+bool PoWManager::IsDifficultyValid(const BlockHeader& header, const BlockHeader& previousHeader, const std::vector<BlockHeader>* pPendingHeaders) const
+{
+	return PoWValidator(m_config, m_blockDB).IsDifficultyValid(header, previousHeader, pPendingHeaders);
+}
+
+bool PoWManager::IsProofValid(const BlockHeader& header) const
+{
+	return PoWValidator(m_config, m_blockDB).IsProofValid(header);
 }
\ No newline at end of file
@@ -15,6 +15,11 @@ PoWValidator::PoWValidator(const Config& config, const IBlockDB& blockDB)
 }
 
 bool PoWValidator::IsPoWValid(const BlockHeader& header, const BlockHeader& previousHeader) const
+{
+	return IsDifficultyValid(header, previousHeader) && IsProofValid(header);
+}
+
+bool PoWValidator::IsDifficultyValid(const BlockHeader& header, const BlockHeader& previousHeader, const std::vector<BlockHeader>* pPendingHeaders) const
 {
 	// Validate Total Difficulty
 	if (header.GetTotalDifficulty() <= previousHeader.GetTotalDifficulty())
@@ -29,7 +34,7 @@ bool PoWValidator::IsPoWValid(const BlockHeader& header, const BlockHeader& prev
 	}
 
 	// Explicit check to ensure total_difficulty has increased by exactly the _network_ difficulty of the previous block.
-	const HeaderInfo nextHeaderInfo = DifficultyCalculator(m_blockDB).CalculateNextDifficulty(header);
+	const HeaderInfo nextHeaderInfo = DifficultyCalculator(m_blockDB).CalculateNextDifficulty(header, pPendingHeaders);
 	if (targetDifficulty != nextHeaderInfo.GetDifficulty())
 	{
 		return false;
@@ -41,7 +46,12 @@ bool PoWValidator::IsPoWValid(const BlockHeader& header, const BlockHeader& prev
 		return false;
 	}
 
+	return true;
+}
 
+// Only depends on the header itself, so it's safe to call for many headers in parallel.
+bool PoWValidator::IsProofValid(const BlockHeader& header) const
+{
 	const ProofOfWork& proofOfWork = header.GetProofOfWork();
 	const EPoWType powType = PoWUtil(m_config).DeterminePoWType(proofOfWork.GetEdgeBits());
 	if (powType == EPoWType::CUCKAROO)
@@ -85,7 +95,8 @@ uint64_t PoWValidator::GetMaximumDifficulty(const BlockHeader& header) const
 
 	std::vector<unsigned char> temp;
 	temp.resize(sizeof(uint64_t));
-	std::reverse_copy(proofOfWork.GetHash().GetData().cbegin(), proofOfWork.GetHash().GetData().cbegin() + sizeof(uint64_t), temp.begin());
+	const Hash& powHash = proofOfWork.GetHash();
+	std::reverse_copy(powHash.cbegin(), powHash.cbegin() + sizeof(uint64_t), temp.begin());
 
 	uint64_t hash64;
 	memcpy(&hash64, &temp[0], sizeof(uint64_t));
@@ -10,6 +10,8 @@ public:
 	PoWValidator(const Config& config, const IBlockDB& blockDB);
 
 	bool IsPoWValid(const BlockHeader& header, const BlockHeader& previousHeader) const;
+	bool IsDifficultyValid(const BlockHeader& header, const BlockHeader& previousHeader, const std::vector<BlockHeader>* pPendingHeaders = nullptr) const;
+	bool IsProofValid(const BlockHeader& header) const;
 
 private:
 	uint64_t GetMaximumDifficulty(const BlockHeader& header) const;
@@ -0,0 +1,121 @@
+#include <ThirdParty/Catch2/catch.hpp>
+
+#include "../DifficultyLoader.h"
+#include "../DifficultyCalculator.h"
+
+#include <Consensus/BlockDifficulty.h>
+#include <Consensus/BlockTime.h>
+#include <unordered_map>
+
+// Only stores headers. Everything else is unused by the difficulty calculation.
+class TestHeaderDB : public IBlockDB
+{
+public:
+	virtual std::vector<BlockHeader*> LoadBlockHeaders(const std::vector<Hash>&) const override final { return std::vector<BlockHeader*>(); }
+	virtual std::unique_ptr<BlockHeader> GetBlockHeader(const Hash& hash) const override final
+	{
+		auto iter = m_headers.find(hash);
+		return iter == m_headers.end() ? std::unique_ptr<BlockHeader>(nullptr) : std::make_unique<BlockHeader>(iter->second);
+	}
+
+	virtual void AddBlockHeader(const BlockHeader& blockHeader) override final { m_headers.insert({ blockHeader.GetHash(), blockHeader }); }
+	virtual void AddBlockHeaders(const std::vector<BlockHeader>& blockHeaders) override final
+	{
+		for (const BlockHeader& blockHeader : blockHeaders)
+		{
+			AddBlockHeader(blockHeader);
+		}
+	}
+
+	virtual void AddBlock(const FullBlock&) override final { }
+	virtual std::unique_ptr<FullBlock> GetBlock(const Hash&) const override final { return std::unique_ptr<FullBlock>(nullptr); }
+	virtual void AddBlockSums(const Hash&, const BlockSums&) override final { }
+	virtual std::unique_ptr<BlockSums> GetBlockSums(const Hash&) const override final { return std::unique_ptr<BlockSums>(nullptr); }
+	virtual void AddOutputPosition(const Commitment&, const OutputLocation&) override final { }
+	virtual std::optional<OutputLocation> GetOutputPosition(const Commitment&) const override final { return std::nullopt; }
+	virtual void AddBlockInputBitmap(const Hash&, const Roaring&) override final { }
+	virtual std::optional<Roaring> GetBlockInputBitmap(const Hash&) const override final { return std::nullopt; }
+	virtual void BeginBatch() override final { }
+	virtual bool CommitBatch() override final { return true; }
+	virtual void RollbackBatch() override final { }
+
+private:
+	std::unordered_map<Hash, BlockHeader> m_headers;
+};
+
+// Builds a chain with irregular block times and difficulties, so a truncated or padded window gives different results.
+static std::vector<BlockHeader> CreateChain(const uint64_t numHeaders)
+{
+	std::vector<BlockHeader> headers;
+	Hash previousHash = ZERO_HASH;
+	int64_t timestamp = 1546030084;
+	uint64_t totalDifficulty = 0;
+	for (uint64_t height = 0; height < numHeaders; height++)
+	{
+		timestamp += 30 + (int64_t)((height * 37) % 61);
+		totalDifficulty += Consensus::MIN_DIFFICULTY + ((height * 7919) % 1000);
+
+		const uint8_t edgeBits = (height % 3 == 0) ? Consensus::SECOND_POW_EDGE_BITS : Consensus::DEFAULT_MIN_EDGE_BITS;
+		BlockHeader header(
+			1,
+			height,
+			timestamp,
+			Hash(previousHash),
+			Hash(ZERO_HASH),
+			Hash(ZERO_HASH),
+			Hash(ZERO_HASH),
+			Hash(ZERO_HASH),
+			BlindingFactor(ZERO_HASH),
+			0,
+			0,
+			totalDifficulty,
+			Consensus::INITIAL_GRAPH_WEIGHT,
+			height,
+			ProofOfWork(edgeBits, std::vector<uint64_t>(42, height))
+		);
+
+		previousHash = header.GetHash();
+		headers.emplace_back(std::move(header));
+	}
+
+	return headers;
+}
+
+TEST_CASE("DifficultyLoader - Pending headers")
+{
+	const uint64_t numStored = Consensus::DIFFICULTY_ADJUST_WINDOW + 10;
+	const std::vector<BlockHeader> chain = CreateChain(numStored + 20);
+
+	// fullDB has every header. partialDB is missing the chunk that's being validated.
+	TestHeaderDB fullDB;
+	fullDB.AddBlockHeaders(chain);
+
+	TestHeaderDB partialDB;
+	partialDB.AddBlockHeaders(std::vector<BlockHeader>(chain.cbegin(), chain.cbegin() + numStored));
+
+	const std::vector<BlockHeader> chunk(chain.cbegin() + numStored, chain.cend());
+	REQUIRE(chunk.size() >= 2);
+
+	// From the 2nd header on, the previous header is only available from the chunk.
+	REQUIRE(partialDB.GetBlockHeader(chunk[0].GetHash()) == nullptr);
+
+	// Every header in the chunk sees the same window as if the chunk was already stored.
+	for (const BlockHeader& header : chunk)
+	{
+		const std::vector<HeaderInfo> expected = DifficultyLoader(fullDB).LoadDifficultyData(header);
+		const std::vector<HeaderInfo> actual = DifficultyLoader(partialDB).LoadDifficultyData(header, &chunk);
+		REQUIRE(actual.size() == expected.size());
+		for (size_t i = 0; i < expected.size(); i++)
+		{
+			REQUIRE(actual[i].GetTimestamp() == expected[i].GetTimestamp());
+			REQUIRE(actual[i].GetDifficulty() == expected[i].GetDifficulty());
+			REQUIRE(actual[i].GetSecondaryScaling() == expected[i].GetSecondaryScaling());
+			REQUIRE(actual[i].IsSecondary() == expected[i].IsSecondary());
+		}
+
+		const HeaderInfo expectedNext = DifficultyCalculator(fullDB).CalculateNextDifficulty(header);
+		const HeaderInfo actualNext = DifficultyCalculator(partialDB).CalculateNextDifficulty(header, &chunk);
+		REQUIRE(actualNext.GetDifficulty() == expectedNext.GetDifficulty());
+		REQUIRE(actualNext.GetSecondaryScaling() == expectedNext.GetSecondaryScaling());
+	}
+}
@@ -199,6 +199,8 @@ Json::Value JSONFactory::BuildConnectedPeerJSON(const ConnectedPeer& connectedPe
 	peerNode["direction"] = connectedPeer.GetDirection() == EDirection::OUTBOUND ? "Outbound" : "Inbound";
 	peerNode["total_difficulty"] = connectedPeer.GetTotalDifficulty();
 	peerNode["height"] = connectedPeer.GetHeight();
+	peerNode["bytes_sent"] = connectedPeer.GetBytesSent();
+	peerNode["bytes_received"] = connectedPeer.GetBytesReceived();
 
 	return peerNode;
 }
\ No newline at end of file
@@ -49,24 +49,27 @@ int BlockInfoAPI::GetLatestBlockInfo(struct mg_connection* conn, NodeContext& se
 		numBlocks = (int)std::min((uint64_t)numBlocks, tipHeight + 1);
 		for (int i = 0; i < numBlocks; i++)
 		{
-			std::unique_ptr<BlockHeader> pBlockHeader = server.m_pBlockChainServer->GetBlockHeaderByHeight(tipHeight - i, EChainType::CONFIRMED);
-			if (pBlockHeader != nullptr)
+			std::optional<HeaderSummary> summaryOpt = server.m_pBlockChainServer->GetHeaderSummaryByHeight(tipHeight - i, EChainType::CONFIRMED);
+			if (summaryOpt.has_value())
 			{
+				const HeaderSummary& summary = summaryOpt.value();
+
 				Json::Value blockNode;
 
-				blockNode["height"] = pBlockHeader->GetHeight();
-				blockNode["hash"] = HexUtil::ConvertToHex(pBlockHeader->GetHash().GetData());
-				blockNode["timestamp"] = pBlockHeader->GetTimestamp();
-				blockNode["pow"] = (pBlockHeader->GetProofOfWork().IsPrimary() ? "AT" : "AR") + std::to_string(pBlockHeader->GetProofOfWork().GetEdgeBits());
-				blockNode["total_difficulty"] = pBlockHeader->GetTotalDifficulty();
+				blockNode["height"] = summary.GetHeight();
+				blockNode["hash"] = HexUtil::ConvertToHex(summary.GetHash().GetData());
+				blockNode["timestamp"] = summary.GetTimestamp();
+				blockNode["pow"] = (summary.IsSecondary() ? "AR" : "AT") + std::to_string(summary.GetEdgeBits());
+				blockNode["total_difficulty"] = summary.GetTotalDifficulty();
 
-				if (pBlockHeader->GetHeight() > 0)
+				std::optional<HeaderSummary> previousSummaryOpt = summary.GetHeight() > 0 ? server.m_pBlockChainServer->GetHeaderSummaryByHeight(summary.GetHeight() - 1, EChainType::CONFIRMED) : std::nullopt;
+				if (previousSummaryOpt.has_value())
 				{
-					blockNode["difficulty"] = pBlockHeader->GetTotalDifficulty() - server.m_pBlockChainServer->GetBlockHeaderByHash(pBlockHeader->GetPreviousBlockHash())->GetTotalDifficulty();
+					blockNode["difficulty"] = summary.GetTotalDifficulty() - previousSummaryOpt.value().GetTotalDifficulty();
 				}
 				else
 				{
-					blockNode["difficulty"] = pBlockHeader->GetTotalDifficulty();
+					blockNode["difficulty"] = summary.GetTotalDifficulty();
 				}
 
 				// TODO: Inputs, outputs, and kernels
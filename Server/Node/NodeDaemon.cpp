@@ -23,6 +23,7 @@ NodeDaemon::NodeDaemon(const Config& config)
 INodeClient* NodeDaemon::Initialize()
 {
 	LoggerAPI::Initialize(m_config.GetLogDirectory(), m_config.GetLogLevel());
+	Crypto::ConfigureVerifiedCaches(m_config.GetNodeConfig().GetRangeProofCacheSize(), m_config.GetNodeConfig().GetKernelSignatureCacheSize());
 	m_pDatabase = DatabaseAPI::OpenDatabase(m_config);
 	m_pTxHashSetManager = new TxHashSetManager(m_config, m_pDatabase->GetBlockDB());
 	m_pTransactionPool = TxPoolAPI::CreateTransactionPool(m_config, *m_pTxHashSetManager, m_pDatabase->GetBlockDB());
@@ -44,6 +45,12 @@ void NodeDaemon::Shutdown()
 	BlockChainAPI::ShutdownBlockChainServer(m_pBlockChainServer);
 	delete m_pTxHashSetManager;
 	DatabaseAPI::CloseDatabase(m_pDatabase);
+
+	const VerifiedCache::Stats rangeProofCacheStats = Crypto::GetRangeProofCacheStats();
+	const VerifiedCache::Stats kernelSignatureCacheStats = Crypto::GetKernelSignatureCacheStats();
+	LoggerAPI::LogInfo("NodeDaemon::Shutdown - Rangeproof cache hits: " + std::to_string(rangeProofCacheStats.hits) + ", misses: " + std::to_string(rangeProofCacheStats.misses));
+	LoggerAPI::LogInfo("NodeDaemon::Shutdown - Kernel signature cache hits: " + std::to_string(kernelSignatureCacheStats.hits) + ", misses: " + std::to_string(kernelSignatureCacheStats.misses));
+
 	LoggerAPI::Flush();
 }
 
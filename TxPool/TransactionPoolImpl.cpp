@@ -43,13 +43,19 @@ bool TransactionPool::AddTransaction(const Transaction& transaction, const EPool
 		}
 	}
 
+	const ITxHashSet* pTxHashSet = m_txHashSetManager.GetTxHashSet();
+	if (pTxHashSet == nullptr)
+	{
+		return false;
+	}
+
 	// Verify coinbase maturity
 	const uint64_t maximumBlockHeight = std::max(lastConfirmedBlock.GetHeight() + 1, Consensus::COINBASE_MATURITY) - Consensus::COINBASE_MATURITY;
 	for (const TransactionInput& input : transaction.GetBody().GetInputs())
 	{
 		if (input.GetFeatures() == EOutputFeatures::COINBASE_OUTPUT)
 		{
-			const std::optional<OutputLocation> outputPosOpt = m_blockDB.GetOutputPosition(input.GetCommitment()); // TODO: Already loaded during pTxHashSet-IsValid. Combine for efficiency
+			const std::optional<OutputLocation> outputPosOpt = pTxHashSet->GetOutputPosition(input.GetCommitment());
 			if (!outputPosOpt.has_value() || outputPosOpt.value().GetBlockHeight() > maximumBlockHeight)
 			{
 				LoggerAPI::LogInfo("TransactionPool::AddTransaction - Coinbase not mature: " + HexUtil::ConvertHash(transaction.GetHash()));
@@ -59,8 +65,7 @@ bool TransactionPool::AddTransaction(const Transaction& transaction, const EPool
 	}
 
 	// Check all inputs are in current UTXO set & all outputs unique in current UTXO set
-	const ITxHashSet* pTxHashSet = m_txHashSetManager.GetTxHashSet();
-	if (pTxHashSet == nullptr || !pTxHashSet->IsValid(transaction))
+	if (!pTxHashSet->IsValid(transaction))
 	{
 		LoggerAPI::LogInfo("TransactionPool::AddTransaction - Transaction inputs/outputs not valid: " + HexUtil::ConvertHash(transaction.GetHash()));
 		return false;
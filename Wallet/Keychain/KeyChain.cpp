@@ -50,5 +50,5 @@ std::unique_ptr<RangeProof> KeyChain::GenerateRangeProof(const KeyChainPath& key
 
 SecretKey KeyChain::CreateNonce(const Commitment& commitment) const
 {
-	return Crypto::Blake2b(commitment.GetCommitmentBytes().GetData(), m_bulletProofNonce.GetBytes().GetData());
+	return Crypto::Blake2b(commitment.GetCommitmentBytes().GetData(), m_bulletProofNonce.GetBytes().GetSecureData());
 }
\ No newline at end of file
@@ -4,7 +4,6 @@
 
 #include <Crypto/Crypto.h>
 #include <Common/Util/BitUtil.h>
-#include <Common/Util/VectorUtil.h>
 #include <Core/Serialization/Serializer.h>
 
 KeyGenerator::KeyGenerator(const Config& config)
@@ -16,18 +15,17 @@ KeyGenerator::KeyGenerator(const Config& config)
 PrivateExtKey KeyGenerator::GenerateMasterKey(const SecretKey& seed) const
 {
 	unsigned char key[] = { 'I','a','m','V','o', 'l', 'd', 'e', 'm', 'o', 'r', 't' };
-	std::vector<unsigned char> vchKey = VectorUtil::MakeVector<unsigned char, 12>(key);
-	const CBigInteger<64> hash = Crypto::HMAC_SHA512(vchKey, seed.GetBytes().GetData());
-	const std::vector<unsigned char>& vchHash = hash.GetData();
+	const SecureVector vchKey(key, key + 12);
+	const CBigInteger<64> hash = Crypto::HMAC_SHA512(vchKey, seed.GetBytes().GetSecureData());
 
-	CBigInteger<32> masterSecretKey(&vchHash[0]);
+	CBigInteger<32> masterSecretKey(hash.data());
 
 	if (masterSecretKey == KeyDefs::BIG_INT_ZERO || masterSecretKey >= KeyDefs::SECP256K1_N)
 	{
 		throw std::out_of_range("The seed resulted in an invalid private key."); // Less than 2^127 chance.
 	}
 
-	CBigInteger<32> masterChainCode(&vchHash[32]);
+	CBigInteger<32> masterChainCode(hash.data() + 32);
 
 	return PrivateExtKey::Create(m_config.GetWalletConfig().GetPrivateKeyVersion(), 0, 0, 0, std::move(masterChainCode), std::move(masterSecretKey));
 }
@@ -59,12 +57,9 @@ std::unique_ptr<PrivateExtKey> KeyGenerator::GenerateChildPrivateKey(const Priva
 
 	serializer.Append<uint32_t>(childKeyIndex);
 
-	const CBigInteger<64> hmacSha512 = Crypto::HMAC_SHA512(parentExtendedKey.GetChainCode().GetBytes().GetData(), serializer.GetBytes());
-	const std::vector<unsigned char>& hmacSha512Vector = hmacSha512.GetData();
+	const CBigInteger<64> hmacSha512 = Crypto::HMAC_SHA512(parentExtendedKey.GetChainCode().GetBytes().GetSecureData(), serializer.GetSecureBytes());
 
-	std::vector<unsigned char> vchLeft;
-	vchLeft.insert(vchLeft.begin(), hmacSha512Vector.cbegin(), hmacSha512Vector.cbegin() + 32);
-	const CBigInteger<32> left(std::move(vchLeft));
+	const CBigInteger<32> left(hmacSha512.data());
 
 	if (left >= KeyDefs::SECP256K1_N)
 	{
@@ -77,9 +72,7 @@ std::unique_ptr<PrivateExtKey> KeyGenerator::GenerateChildPrivateKey(const Priva
 		throw std::out_of_range("The child key generated was invalid."); // Less than 2^127 chance.
 	}
 
-	std::vector<unsigned char> vchRight;
-	vchRight.insert(vchRight.begin(), hmacSha512Vector.cbegin() + 32, hmacSha512Vector.cbegin() + 64);
-	CBigInteger<32> childChainCode(&vchRight[0]);
+	CBigInteger<32> childChainCode(hmacSha512.data() + 32);
 
 	return std::make_unique<PrivateExtKey>(PrivateExtKey::Create(m_config.GetWalletConfig().GetPrivateKeyVersion(), parentExtendedKey.GetDepth() + 1, parentFingerprint, childKeyIndex, std::move(childChainCode), std::move(childPrivateKey)));
 }
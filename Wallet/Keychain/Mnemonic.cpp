@@ -5,7 +5,7 @@
 #include <Crypto/Crypto.h>
 
 // TODO: Apply password
-SecureString Mnemonic::CreateMnemonic(const std::vector<unsigned char>& entropy, const std::optional<SecureString>& password)
+SecureString Mnemonic::CreateMnemonic(const SecureVector& entropy, const std::optional<SecureString>& password)
 {
 	if (entropy.size() % 4 != 0)
 	{
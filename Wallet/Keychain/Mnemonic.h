@@ -7,6 +7,6 @@
 class Mnemonic
 {
 public:
-	static SecureString CreateMnemonic(const std::vector<unsigned char>& entropy, const std::optional<SecureString>& password);
+	static SecureString CreateMnemonic(const SecureVector& entropy, const std::optional<SecureString>& password);
 	static std::optional<std::vector<unsigned char>> ToEntropy(const SecureString& walletWords, const std::optional<SecureString>& password);
 };
\ No newline at end of file
@@ -19,7 +19,7 @@ std::optional<SecretKey> SeedEncrypter::DecryptWalletSeed(const EncryptedSeed& e
 
 		SecretKey walletSeed(&decrypted[0]);
 
-		const CBigInteger<32> hash256 = Crypto::HMAC_SHA256(walletSeed.GetBytes().GetData(), passwordHash.GetBytes().GetData());
+		const CBigInteger<32> hash256 = Crypto::HMAC_SHA256(walletSeed.GetBytes().GetSecureData(), passwordHash.GetBytes().GetSecureData());
 		const CBigInteger<32> hash256Check(&decrypted[32]);
 		if (hash256 == hash256Check)
 		{
@@ -37,19 +37,19 @@ std::optional<SecretKey> SeedEncrypter::DecryptWalletSeed(const EncryptedSeed& e
 EncryptedSeed SeedEncrypter::EncryptWalletSeed(const SecretKey& walletSeed, const SecureString& password) const
 {
 	CBigInteger<32> randomNumber = RandomNumberGenerator::GenerateRandom32();
-	CBigInteger<16> iv = CBigInteger<16>(&randomNumber.GetData()[0]);
-	CBigInteger<8> salt(std::vector<unsigned char>(randomNumber.GetData().cbegin() + 16, randomNumber.GetData().cbegin() + 24));
+	CBigInteger<16> iv = CBigInteger<16>(randomNumber.data());
+	CBigInteger<8> salt(randomNumber.data() + 16);
 
 	SecretKey passwordHash = Crypto::PBKDF(password, salt.GetData());
 
-	const std::vector<unsigned char>& walletSeedBytes = walletSeed.GetBytes().GetData();
+	const SecureVector walletSeedBytes = walletSeed.GetBytes().GetSecureData();
 
-	const CBigInteger<32> hash256 = Crypto::HMAC_SHA256(walletSeedBytes, passwordHash.GetBytes().GetData());
-	const std::vector<unsigned char>& hash256Bytes = hash256.GetData();
+	const CBigInteger<32> hash256 = Crypto::HMAC_SHA256(walletSeedBytes, passwordHash.GetBytes().GetSecureData());
 
 	SecureVector seedPlusHash;
-	seedPlusHash.insert(seedPlusHash.begin(), walletSeedBytes.cbegin(), walletSeedBytes.cend());
-	seedPlusHash.insert(seedPlusHash.end(), hash256Bytes.cbegin(), hash256Bytes.cend());
+	seedPlusHash.reserve(64);
+	seedPlusHash.insert(seedPlusHash.end(), walletSeedBytes.cbegin(), walletSeedBytes.cend());
+	seedPlusHash.insert(seedPlusHash.end(), hash256.cbegin(), hash256.cend());
 
 	std::vector<unsigned char> encrypted = Crypto::AES256_Encrypt(seedPlusHash, passwordHash, iv);
 
@@ -4,7 +4,6 @@
 #include <Crypto/Crypto.h>
 #include <Crypto/RandomNumberGenerator.h>
 #include <Wallet/SessionTokenException.h>
-#include <Common/Util/VectorUtil.h>
 
 SessionManager::SessionManager(const Config& config, const INodeClient& nodeClient, IWalletDB& walletDB)
 	: m_config(config), m_nodeClient(nodeClient), m_walletDB(walletDB)
@@ -40,9 +39,12 @@ SessionToken SessionManager::Login(const std::string& username, const SecretKey&
 	KeyChain keyChain = KeyChain::FromSeed(m_config, seed);
 	Wallet* pWallet = Wallet::LoadWallet(m_config, m_nodeClient, m_walletDB, username);
 
-	const CBigInteger<32> hash = Crypto::SHA256(seed.GetBytes().GetData());
-	const std::vector<unsigned char> checksum(hash.GetData().cbegin(), hash.GetData().cbegin() + 4);
-	const std::vector<unsigned char> seedWithChecksum = VectorUtil::Concat(seed.GetBytes().GetData(), checksum);
+	const CBigInteger<32> hash = Crypto::SHA256(seed.GetBytes().GetSecureData());
+
+	SecureVector seedWithChecksum;
+	seedWithChecksum.reserve(36);
+	seedWithChecksum.insert(seedWithChecksum.end(), seed.GetBytes().cbegin(), seed.GetBytes().cend());
+	seedWithChecksum.insert(seedWithChecksum.end(), hash.cbegin(), hash.cbegin() + 4);
 
 	std::vector<unsigned char> tokenKey = RandomNumberGenerator::GenerateRandomBytes(seedWithChecksum.size());
 	std::vector<unsigned char> encryptedSeedWithCS(36);
@@ -74,14 +76,14 @@ SecretKey SessionManager::GetSeed(const SessionToken& token) const
 	{
 		const LoggedInSession* pSession = iter->second;
 		
-		std::vector<unsigned char> seedWithCS(36);
+		SecureVector seedWithCS(36);
 		for (size_t i = 0; i < 36; i++)
 		{
 			seedWithCS[i] = pSession->m_encryptedSeedWithCS[i] ^ token.GetTokenKey()[i];
 		}
 
-		SecretKey seed(std::vector<unsigned char>(seedWithCS.cbegin(), seedWithCS.cbegin() + 32));
-		CBigInteger<32> hash = Crypto::SHA256(seed.GetBytes().GetData());
+		SecretKey seed(CBigInteger<32>(seedWithCS.data()));
+		CBigInteger<32> hash = Crypto::SHA256(seed.GetBytes().GetSecureData());
 		for (int i = 0; i < 4; i++)
 		{
 			if (seedWithCS[32 + i] != hash[i])
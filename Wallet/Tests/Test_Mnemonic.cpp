@@ -6,28 +6,28 @@
 TEST_CASE("Mnemonic::CreateMnemonic")
 {
 	{
-		std::vector<unsigned char> entropy = CBigInteger<16>::FromHex("00000000000000000000000000000000").GetData();
+		SecureVector entropy = CBigInteger<16>::FromHex("00000000000000000000000000000000").GetSecureData();
 		SecureString mnemonic = Mnemonic().CreateMnemonic(entropy, std::nullopt);
 		SecureString expected = "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about";
 		REQUIRE(mnemonic == expected);
 	}
 
 	{
-		std::vector<unsigned char> entropy = CBigInteger<16>::FromHex("7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f").GetData();
+		SecureVector entropy = CBigInteger<16>::FromHex("7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f7f").GetSecureData();
 		SecureString mnemonic = Mnemonic().CreateMnemonic(entropy, std::nullopt);
 		SecureString expected = "legal winner thank year wave sausage worth useful legal winner thank yellow";
 		REQUIRE(mnemonic == expected);
 	}
 
 	{
-		std::vector<unsigned char> entropy = CBigInteger<16>::FromHex("80808080808080808080808080808080").GetData();
+		SecureVector entropy = CBigInteger<16>::FromHex("80808080808080808080808080808080").GetSecureData();
 		SecureString mnemonic = Mnemonic().CreateMnemonic(entropy, std::nullopt);
 		SecureString expected = "letter advice cage absurd amount doctor acoustic avoid letter advice cage above";
 		REQUIRE(mnemonic == expected);
 	}
 
 	{
-		std::vector<unsigned char> entropy = CBigInteger<16>::FromHex("ffffffffffffffffffffffffffffffff").GetData();
+		SecureVector entropy = CBigInteger<16>::FromHex("ffffffffffffffffffffffffffffffff").GetSecureData();
 		SecureString mnemonic = Mnemonic().CreateMnemonic(entropy, std::nullopt);
 		SecureString expected = "zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo wrong";
 		REQUIRE(mnemonic == expected);
@@ -36,7 +36,7 @@ TEST_CASE("Mnemonic::CreateMnemonic")
 	// TODO: Include remaining test vectors from https://github.com/bitcoin/bips/blob/master/bip-0039.mediawiki#Test_vectors
 
 	{
-		std::vector<unsigned char> entropy = CBigInteger<32>::FromHex("f585c11aec520db57dd353c69554b21a89b20fb0650966fa0a9d6f74fd989d8f").GetData();
+		SecureVector entropy = CBigInteger<32>::FromHex("f585c11aec520db57dd353c69554b21a89b20fb0650966fa0a9d6f74fd989d8f").GetSecureData();
 		SecureString mnemonic = Mnemonic().CreateMnemonic(entropy, std::nullopt);
 		SecureString expected = "void come effort suffer camp survey warrior heavy shoot primary clutch crush open amazing screen patrol group space point ten exist slush involve unfold";
 		REQUIRE(mnemonic == expected);
@@ -30,7 +30,7 @@ std::optional<std::pair<SecureString, SessionToken>> WalletManager::InitializeNe
 	const std::string usernameLower = StringUtil::ToLower(username);
 	if (m_pWalletDB->CreateWallet(usernameLower, encryptedSeed))
 	{
-		SecureString walletWords = Mnemonic::CreateMnemonic(walletSeed.GetBytes().GetData(), std::make_optional(password));
+		SecureString walletWords = Mnemonic::CreateMnemonic(walletSeed.GetBytes().GetSecureData(), std::make_optional(password));
 		SessionToken token = m_sessionManager.Login(usernameLower, walletSeed);
 
 		return std::make_optional<std::pair<SecureString, SessionToken>>(std::make_pair<SecureString, SessionToken>(std::move(walletWords), std::move(token)));
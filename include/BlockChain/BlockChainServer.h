@@ -13,11 +13,13 @@
 #include <Core/Models/Display/BlockWithOutputs.h>
 #include <BlockChain/ChainType.h>
 #include <Core/Models/BlockHeader.h>
+#include <Core/Models/HeaderSummary.h>
 #include <Core/Models/FullBlock.h>
 #include <Core/Models/CompactBlock.h>
 #include <Core/Models/Transaction.h>
 #include <Crypto/BigInteger.h>
 
+#include <optional>
 #include <vector>
 #include <memory>
 
@@ -67,6 +69,12 @@ public:
 	//
 	virtual std::unique_ptr<BlockHeader> GetBlockHeaderByHeight(const uint64_t height, const EChainType chainType) const = 0;
 
+	//
+	// Returns the summary of the block header at the given height.
+	// This is much cheaper than GetBlockHeaderByHeight, since it usually doesn't need to read the database.
+	//
+	virtual std::optional<HeaderSummary> GetHeaderSummaryByHeight(const uint64_t height, const EChainType chainType) const = 0;
+
 	//
 	// Returns the block header matching the given hash.
 	// This will be null if no matching block header is found.
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <vector>
+#include <cstring>
 
 #if defined(_MSC_VER)
 #define WIN32_LEAN_AND_MEAN
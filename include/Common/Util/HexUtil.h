@@ -83,8 +83,7 @@ namespace HexUtil
 
 	static std::string ConvertHash(const Hash& hash)
 	{
-		const std::vector<unsigned char>& bytes = hash.GetData();
-		const std::vector<unsigned char> firstSixBytes = std::vector<unsigned char>(bytes.cbegin(), bytes.cbegin() + 6);
+		const std::vector<unsigned char> firstSixBytes = std::vector<unsigned char>(hash.cbegin(), hash.cbegin() + 6);
 		
 		return ConvertToHex(firstSixBytes);
 	}
@@ -7,6 +7,8 @@
 #include <Config/Genesis.h>
 #include <Config/WalletConfig.h>
 #include <Config/ServerConfig.h>
+#include <Config/NodeConfig.h>
+#include <Config/DatabaseConfig.h>
 #include <string>
 #include <filesystem>
 
@@ -21,6 +23,8 @@ public:
 		const P2PConfig& p2pConfig,
 		const WalletConfig& walletConfig, 
 		const ServerConfig& serverConfig,
+		const NodeConfig& nodeConfig,
+		const DatabaseConfig& databaseConfig,
 		const std::string& logLevel
 	)
 		: m_clientMode(clientMode), 
@@ -30,6 +34,8 @@ public:
 		m_p2pConfig(p2pConfig),
 		m_walletConfig(walletConfig),
 		m_serverConfig(serverConfig),
+		m_nodeConfig(nodeConfig),
+		m_databaseConfig(databaseConfig),
 		m_logLevel(logLevel)
 	{
 		std::filesystem::create_directories(m_dataPath + "NODE\\" + m_txHashSetPath);
@@ -53,6 +59,8 @@ public:
 	inline const EClientMode GetClientMode() const { return EClientMode::FAST_SYNC; }
 	inline const WalletConfig& GetWalletConfig() const { return m_walletConfig; }
 	inline const ServerConfig& GetServerConfig() const { return m_serverConfig; }
+	inline const NodeConfig& GetNodeConfig() const { return m_nodeConfig; }
+	inline const DatabaseConfig& GetDatabaseConfig() const { return m_databaseConfig; }
 	inline const std::string& GetLogLevel() const { return m_logLevel; }
 
 private:
@@ -68,5 +76,7 @@ private:
 	Environment m_environment;
 	WalletConfig m_walletConfig;
 	ServerConfig m_serverConfig;
+	NodeConfig m_nodeConfig;
+	DatabaseConfig m_databaseConfig;
 	std::string m_logLevel;
 };
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdint.h>
+
+class DatabaseConfig
+{
+public:
+	DatabaseConfig(
+		const uint32_t blockCacheSizeMB,
+		const uint32_t bloomFilterBitsPerKey,
+		const uint32_t writeBufferSizeMB,
+		const uint32_t blockWriteBufferSizeMB,
+		const bool compressBlocks,
+		const uint32_t maxWriteMBPerSec,
+		const uint32_t statsDumpPeriodSecs,
+		const uint32_t headerCacheSize
+	)
+		: m_blockCacheSizeMB(blockCacheSizeMB),
+		m_bloomFilterBitsPerKey(bloomFilterBitsPerKey),
+		m_writeBufferSizeMB(writeBufferSizeMB),
+		m_blockWriteBufferSizeMB(blockWriteBufferSizeMB),
+		m_compressBlocks(compressBlocks),
+		m_maxWriteMBPerSec(maxWriteMBPerSec),
+		m_statsDumpPeriodSecs(statsDumpPeriodSecs),
+		m_headerCacheSize(headerCacheSize)
+	{
+
+	}
+
+	// Size of the block cache shared by every column family.
+	inline uint32_t GetBlockCacheSizeMB() const { return m_blockCacheSizeMB; }
+
+	// Bits per key of the bloom filters on the point lookup column families (HEADER, OUTPUT_POS, etc). 0 disables them.
+	inline uint32_t GetBloomFilterBitsPerKey() const { return m_bloomFilterBitsPerKey; }
+
+	// Memtable size of the point lookup column families.
+	inline uint32_t GetWriteBufferSizeMB() const { return m_writeBufferSizeMB; }
+
+	// Memtable size of the BLOCK column family, which is written sequentially and rarely read.
+	inline uint32_t GetBlockWriteBufferSizeMB() const { return m_blockWriteBufferSizeMB; }
+
+	// Compress the lower levels of the BLOCK column family. The other column families hold hashes, which don't compress.
+	inline bool ShouldCompressBlocks() const { return m_compressBlocks; }
+
+	// Limits the rate of flush and compaction writes. 0 means unlimited.
+	inline uint32_t GetMaxWriteMBPerSec() const { return m_maxWriteMBPerSec; }
+
+	// How often RocksDB statistics are written to the log. 0 disables statistics.
+	inline uint32_t GetStatsDumpPeriodSecs() const { return m_statsDumpPeriodSecs; }
+
+	// Number of deserialized headers to keep in memory. 0 disables the cache.
+	inline uint32_t GetHeaderCacheSize() const { return m_headerCacheSize; }
+
+private:
+	uint32_t m_blockCacheSizeMB;
+	uint32_t m_bloomFilterBitsPerKey;
+	uint32_t m_writeBufferSizeMB;
+	uint32_t m_blockWriteBufferSizeMB;
+	bool m_compressBlocks;
+	uint32_t m_maxWriteMBPerSec;
+	uint32_t m_statsDumpPeriodSecs;
+	uint32_t m_headerCacheSize;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <stdint.h>
+
+class NodeConfig
+{
+public:
+	NodeConfig(const uint32_t rangeProofCacheSize, const uint32_t kernelSignatureCacheSize, const uint32_t headerChunkSize, const uint32_t rangeProofBatchSize)
+		: m_rangeProofCacheSize(rangeProofCacheSize), m_kernelSignatureCacheSize(kernelSignatureCacheSize), m_headerChunkSize(headerChunkSize), m_rangeProofBatchSize(rangeProofBatchSize)
+	{
+
+	}
+
+	// Number of verified rangeproofs to remember, so they aren't verified again when seen in a block after the mempool.
+	inline uint32_t GetRangeProofCacheSize() const { return m_rangeProofCacheSize; }
+
+	// Number of verified kernel signatures to remember.
+	inline uint32_t GetKernelSignatureCacheSize() const { return m_kernelSignatureCacheSize; }
+
+	// Maximum number of sync headers to validate, write, and commit to the header MMR at a time.
+	inline uint32_t GetHeaderChunkSize() const { return m_headerChunkSize; }
+
+	// Number of rangeproofs verified together by a single task when validating a downloaded TxHashSet.
+	inline uint32_t GetRangeProofBatchSize() const { return m_rangeProofBatchSize; }
+
+private:
+	uint32_t m_rangeProofCacheSize;
+	uint32_t m_kernelSignatureCacheSize;
+	uint32_t m_headerChunkSize;
+	uint32_t m_rangeProofBatchSize;
+};
@@ -3,21 +3,23 @@
 class P2PConfig
 {
 public:
-	P2PConfig() : P2PConfig(15, 5)
+	P2PConfig() : P2PConfig(15, 5, 4)
 	{
 		
 	}
 
-	P2PConfig(const int maxPeerConnections, const int preferredMinimumConnections)
-		: m_maxPeerConnections(maxPeerConnections), m_preferredMinimumConnections(preferredMinimumConnections)
+	P2PConfig(const int maxPeerConnections, const int preferredMinimumConnections, const int numIOThreads)
+		: m_maxPeerConnections(maxPeerConnections), m_preferredMinimumConnections(preferredMinimumConnections), m_numIOThreads(numIOThreads)
 	{
 
 	}
 
 	inline int GetMaxConnections() const { return m_maxPeerConnections; }
 	inline int GetPreferredMinConnections() const { return m_preferredMinimumConnections; }
+	inline int GetNumIOThreads() const { return m_numIOThreads; }
 
 private:
 	int m_maxPeerConnections;
 	int m_preferredMinimumConnections;
+	int m_numIOThreads;
 };
\ No newline at end of file
@@ -37,11 +37,25 @@ public:
 		return m_file.GetSize() / NUM_BYTES;
 	}
 
+	inline File::PendingFlush GetPendingFlush() const
+	{
+		return m_file.GetPendingFlush();
+	}
+
 	inline bool GetDataAt(const uint64_t position, std::vector<unsigned char>& data) const
 	{
 		return m_file.Read(position * NUM_BYTES, NUM_BYTES, data);
 	}
 
+	//
+	// Returns a view of the data at the given position without copying it.
+	// The view is invalidated by any modification to the file (AddData, Flush, Rewind, Discard).
+	//
+	inline ByteView GetDataViewAt(const uint64_t position) const
+	{
+		return m_file.ReadView(position * NUM_BYTES, NUM_BYTES);
+	}
+
 	inline void AddData(const std::vector<unsigned char>& data)
 	{
 		m_file.Append(data);
@@ -1,12 +1,16 @@
 #pragma once
 
-#pragma warning(push)
-#pragma warning(disable:4244)
-#pragma warning(disable:4267)
-#pragma warning(disable:4334)
-#pragma warning(disable:4018)
-#include <mio/mmap.hpp>
-#pragma warning(pop)
+#ifdef _WIN32
+	#pragma warning(push)
+	#pragma warning(disable:4244)
+	#pragma warning(disable:4267)
+	#pragma warning(disable:4334)
+	#pragma warning(disable:4018)
+	#include <mio/mmap.hpp>
+	#pragma warning(pop)
+#endif
+
+#include <Core/Serialization/ByteView.h>
 
 #include <stdint.h>
 #include <string>
@@ -16,16 +20,23 @@ class File
 {
 public:
 	File(const std::string& path);
+	~File();
 
 	File(const File& file) = delete;
 	File(File&& file) = delete;
 	File& operator=(const File&) = delete;
 
+	//
+	// (Re)loads the file from disk. If the path was replaced (eg. renamed over) since the last Load, the new file is opened.
+	//
 	bool Load();
 	bool Flush();
 
 	void Append(const std::vector<unsigned char>& data);
 
+	//
+	// Rewinds are only applied in memory. The file on disk isn't modified until the next Flush.
+	//
 	bool Rewind(const uint64_t nextPosition);
 	// TODO: bool Commit(); - Should eliminate a rewind-point, but not actually flush to disk.
 	bool Discard();
@@ -33,10 +44,47 @@ public:
 	uint64_t GetSize() const;
 	bool Read(const uint64_t position, const uint64_t numBytes, std::vector<unsigned char>& data) const;
 
+	//
+	// Returns a view directly into the memory-mapped file or the pending append buffer, without copying.
+	// The view is only valid until the next call to Append, Flush, Rewind, or Discard.
+	// Returns an empty view if the requested range is not available.
+	//
+	ByteView ReadView(const uint64_t position, const uint64_t numBytes) const;
+
+	//
+	// Describes what the next Flush will do to the file on disk, so an interrupted flush can be undone:
+	// the file is cut back to 'position', discarding 'overwrittenBytes' (only non-empty after a Rewind),
+	// and then the pending bytes are written until it reaches 'newSize'.
+	//
+	struct PendingFlush
+	{
+		uint64_t position;
+		uint64_t flushedSize;
+		uint64_t newSize;
+		std::vector<unsigned char> overwrittenBytes;
+	};
+
+	PendingFlush GetPendingFlush() const;
+
 private:
+	const unsigned char* GetMappedData() const;
+
 	std::string m_path;
 	uint64_t m_bufferIndex;
 	uint64_t m_fileSize;
 	std::vector<unsigned char> m_buffer;
+
+#ifdef _WIN32
 	mio::mmap_source m_mmap;
+#else
+	bool Open(const bool create);
+	void Close();
+	bool IsReplaced() const;
+	bool Remap();
+
+	// The file stays open and mapped between flushes. The mapping is resized in place as the file grows or shrinks.
+	int m_fd;
+	void* m_pMapped;
+	uint64_t m_mappedSize;
+#endif
 };
\ No newline at end of file
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <stdint.h>
+#include <Crypto/Hash.h>
+#include <Core/Models/BlockHeader.h>
+#include <Core/Serialization/Serializer.h>
+#include <Core/Serialization/ByteBuffer.h>
+
+//
+// The fields of a block header that are needed when walking the chain by height (difficulty, timestamps, MMR sizes, and kernel roots),
+// without the roots and proof of work that make deserializing a full header expensive.
+// Serializes to a fixed size, so summaries can be stored in a file indexed by height.
+//
+class HeaderSummary
+{
+public:
+	static const size_t SIZE = 32 + 32 + 8 + 8 + 8 + 8 + 4 + 1;
+
+	//
+	// Constructors
+	//
+	HeaderSummary(
+		const uint64_t height,
+		const Hash& hash,
+		const Hash& kernelRoot,
+		const int64_t timestamp,
+		const uint64_t totalDifficulty,
+		const uint64_t outputMMRSize,
+		const uint64_t kernelMMRSize,
+		const uint32_t scalingDifficulty,
+		const uint8_t edgeBits
+	)
+		: m_height(height),
+		m_hash(hash),
+		m_kernelRoot(kernelRoot),
+		m_timestamp(timestamp),
+		m_totalDifficulty(totalDifficulty),
+		m_outputMMRSize(outputMMRSize),
+		m_kernelMMRSize(kernelMMRSize),
+		m_scalingDifficulty(scalingDifficulty),
+		m_edgeBits(edgeBits)
+	{
+
+	}
+
+	static HeaderSummary FromHeader(const BlockHeader& header)
+	{
+		return HeaderSummary(
+			header.GetHeight(),
+			header.GetHash(),
+			header.GetKernelRoot(),
+			header.GetTimestamp(),
+			header.GetTotalDifficulty(),
+			header.GetOutputMMRSize(),
+			header.GetKernelMMRSize(),
+			header.GetScalingDifficulty(),
+			header.GetProofOfWork().GetEdgeBits()
+		);
+	}
+
+	//
+	// Getters
+	//
+	inline uint64_t GetHeight() const { return m_height; }
+	inline const Hash& GetHash() const { return m_hash; }
+	inline const Hash& GetKernelRoot() const { return m_kernelRoot; }
+	inline int64_t GetTimestamp() const { return m_timestamp; }
+	inline uint64_t GetTotalDifficulty() const { return m_totalDifficulty; }
+	inline uint64_t GetOutputMMRSize() const { return m_outputMMRSize; }
+	inline uint64_t GetKernelMMRSize() const { return m_kernelMMRSize; }
+	inline uint32_t GetScalingDifficulty() const { return m_scalingDifficulty; }
+	inline uint8_t GetEdgeBits() const { return m_edgeBits; }
+	inline bool IsSecondary() const { return m_edgeBits == Consensus::SECOND_POW_EDGE_BITS; }
+
+	//
+	// Serialization/Deserialization
+	// The height isn't serialized, since it's the summary's position in the file.
+	//
+	void Serialize(Serializer& serializer) const
+	{
+		serializer.AppendBigInteger(m_hash);
+		serializer.AppendBigInteger(m_kernelRoot);
+		serializer.Append(m_timestamp);
+		serializer.Append(m_totalDifficulty);
+		serializer.Append(m_outputMMRSize);
+		serializer.Append(m_kernelMMRSize);
+		serializer.Append(m_scalingDifficulty);
+		serializer.Append(m_edgeBits);
+	}
+
+	static HeaderSummary Deserialize(const uint64_t height, ByteBuffer& byteBuffer)
+	{
+		const Hash hash = byteBuffer.ReadBigInteger<32>();
+		const Hash kernelRoot = byteBuffer.ReadBigInteger<32>();
+		const int64_t timestamp = byteBuffer.Read64();
+		const uint64_t totalDifficulty = byteBuffer.ReadU64();
+		const uint64_t outputMMRSize = byteBuffer.ReadU64();
+		const uint64_t kernelMMRSize = byteBuffer.ReadU64();
+		const uint32_t scalingDifficulty = byteBuffer.ReadU32();
+		const uint8_t edgeBits = byteBuffer.ReadU8();
+
+		return HeaderSummary(height, hash, kernelRoot, timestamp, totalDifficulty, outputMMRSize, kernelMMRSize, scalingDifficulty, edgeBits);
+	}
+
+private:
+	uint64_t m_height;
+	Hash m_hash;
+	Hash m_kernelRoot;
+	int64_t m_timestamp;
+	uint64_t m_totalDifficulty;
+	uint64_t m_outputMMRSize;
+	uint64_t m_kernelMMRSize;
+	uint32_t m_scalingDifficulty;
+	uint8_t m_edgeBits;
+};
@@ -8,6 +8,7 @@
 
 #include <Core/Serialization/EndianHelper.h>
 #include <Core/Serialization/DeserializationException.h>
+#include <Core/Serialization/ByteView.h>
 
 #include <vector>
 #include <string>
@@ -19,7 +20,13 @@ class ByteBuffer
 {
 public:
 	ByteBuffer(const std::vector<unsigned char>& bytes)
-		: m_bytes(bytes), m_index(0)
+		: m_index(0), m_bytes(bytes)
+	{
+
+	}
+
+	ByteBuffer(const ByteView& bytes)
+		: m_index(0), m_bytes(bytes)
 	{
 
 	}
@@ -169,11 +176,11 @@ public:
 			throw DeserializationException();
 		}
 
-		std::vector<unsigned char> data(m_bytes.cbegin() + m_index, m_bytes.cbegin() + m_index + NUM_BYTES);
+		const unsigned char* pData = &m_bytes[m_index];
 
 		m_index += NUM_BYTES;
 
-		return CBigInteger<NUM_BYTES>(data);
+		return CBigInteger<NUM_BYTES>(pData);
 	}
 
 	std::vector<unsigned char> ReadVector(const uint64_t numBytes)
@@ -196,5 +203,5 @@ public:
 
 private:
 	size_t m_index;
-	const std::vector<unsigned char>& m_bytes;
+	const ByteView m_bytes;
 };
\ No newline at end of file
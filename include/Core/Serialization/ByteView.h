@@ -0,0 +1,64 @@
+#pragma once
+
+//
+// This code is free for all purposes without any express guarantee it works.
+//
+// Author: David Burkett (davidburkett38@gmail.com)
+//
+
+#include <stdint.h>
+#include <vector>
+
+//
+// Non-owning, read-only view over a contiguous range of bytes.
+// The caller is responsible for ensuring the underlying memory outlives the view.
+//
+class ByteView
+{
+public:
+	//
+	// Constructors
+	//
+	ByteView()
+		: m_pData(nullptr), m_size(0)
+	{
+
+	}
+
+	ByteView(const unsigned char* pData, const size_t size)
+		: m_pData(pData), m_size(size)
+	{
+
+	}
+
+	ByteView(const std::vector<unsigned char>& bytes)
+		: m_pData(bytes.data()), m_size(bytes.size())
+	{
+
+	}
+
+	ByteView(const ByteView& other) = default;
+	ByteView& operator=(const ByteView& other) = default;
+
+	//
+	// Getters
+	//
+	inline const unsigned char* data() const { return m_pData; }
+	inline size_t size() const { return m_size; }
+	inline bool empty() const { return m_size == 0; }
+
+	inline const unsigned char* cbegin() const { return m_pData; }
+	inline const unsigned char* cend() const { return m_pData + m_size; }
+	inline const unsigned char* begin() const { return m_pData; }
+	inline const unsigned char* end() const { return m_pData + m_size; }
+
+	inline const unsigned char& operator[] (const size_t x) const { return m_pData[x]; }
+
+	inline ByteView SubView(const size_t offset, const size_t size) const { return ByteView(m_pData + offset, size); }
+
+	inline std::vector<unsigned char> ToVector() const { return std::vector<unsigned char>(cbegin(), cend()); }
+
+private:
+	const unsigned char* m_pData;
+	size_t m_size;
+};
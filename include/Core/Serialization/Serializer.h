@@ -64,9 +64,7 @@ public:
 	template<size_t NUM_BYTES>
 	void AppendBigInteger(const CBigInteger<NUM_BYTES>& bigInteger)
 	{
-		const std::vector<unsigned char>& data = bigInteger.GetData();
-		//std::reverse(data.begin(), data.end());
-		m_serialized.insert(m_serialized.end(), data.cbegin(), data.cend());
+		m_serialized.insert(m_serialized.end(), bigInteger.cbegin(), bigInteger.cend());
 	}
 
 	inline const std::vector<unsigned char>& GetBytes() const { return m_serialized; }
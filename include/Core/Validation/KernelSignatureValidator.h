@@ -9,10 +9,39 @@ class KernelSignatureValidator
 {
 public:
 	// Verify the tx kernels.
-	// No ability to batch verify these right now so just do them individually.
+	// Entails handling the commitment as a public key and checking the signature verifies with the fee as message.
+	// All signatures are batch verified at once, falling back to individual verification only to find the invalid kernel.
 	static bool VerifyKernelSignatures(const std::vector<TransactionKernel>& kernels)
 	{
-		// Verify the transaction proof validity. Entails handling the commitment as a public key and checking the signature verifies with the fee as message.
+		if (kernels.size() > 1)
+		{
+			std::vector<const Signature*> signatures;
+			std::vector<const Commitment*> publicKeys;
+			std::vector<Hash> signatureMessages;
+			signatures.reserve(kernels.size());
+			publicKeys.reserve(kernels.size());
+			signatureMessages.reserve(kernels.size());
+
+			for (const TransactionKernel& kernel : kernels)
+			{
+				signatures.push_back(&kernel.GetExcessSignature());
+				publicKeys.push_back(&kernel.GetExcessCommitment());
+				signatureMessages.emplace_back(kernel.GetSignatureMessage());
+			}
+
+			std::vector<const Hash*> messagePointers;
+			messagePointers.reserve(signatureMessages.size());
+			for (const Hash& signatureMessage : signatureMessages)
+			{
+				messagePointers.push_back(&signatureMessage);
+			}
+
+			if (Crypto::VerifyKernelSignatures(signatures, publicKeys, messagePointers))
+			{
+				return true;
+			}
+		}
+
 		for (const TransactionKernel& kernel : kernels)
 		{
 			const Commitment& publicKey = kernel.GetExcessCommitment();
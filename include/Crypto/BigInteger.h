@@ -6,16 +6,21 @@
 // Author: David Burkett (davidburkett38@gmail.com)
 //
 
+#include <Common/Secure.h>
+
 #include <stdint.h>
+#include <array>
 #include <vector>
 #include <string>
+#include <cstring>
+#include <algorithm>
 #include <stdexcept>
 #include <sstream>
 #include <iomanip>
 
 #pragma warning(disable: 4505)
 
-template<size_t NUM_BYTES, class ALLOC = std::allocator<unsigned char>>
+template<size_t NUM_BYTES>
 class CBigInteger
 {
 public:
@@ -23,32 +28,41 @@ public:
 	// Constructors
 	//
 	CBigInteger()
-		: m_data(NUM_BYTES)
+		: m_data()
 	{
 	}
 
-	CBigInteger(const std::vector<unsigned char, ALLOC>& data)
+	CBigInteger(const std::array<unsigned char, NUM_BYTES>& data)
 		: m_data(data)
 	{
 
 	}
 
-	CBigInteger(std::vector<unsigned char, ALLOC>&& data)
-		: m_data(std::move(data))
+	// Throws std::invalid_argument unless the vector holds exactly NUM_BYTES.
+	CBigInteger(const std::vector<unsigned char>& data)
+		: CBigInteger(data.data(), data.size())
 	{
 
 	}
 
-	CBigInteger(const unsigned char* data)
-		: m_data(data, data + NUM_BYTES)
+	CBigInteger(std::vector<unsigned char>&& data)
+		: CBigInteger(data.data(), data.size())
 	{
+
 	}
 
-	CBigInteger(const CBigInteger& bigInteger)
+	CBigInteger(const SecureVector& data)
+		: CBigInteger(data.data(), data.size())
 	{
-		m_data = bigInteger.GetData();
+
 	}
 
+	CBigInteger(const unsigned char* data)
+	{
+		memcpy(m_data.data(), data, NUM_BYTES);
+	}
+
+	CBigInteger(const CBigInteger& bigInteger) = default;
 	CBigInteger(CBigInteger&& bigInteger) noexcept = default;
 
 	//
@@ -56,30 +70,42 @@ public:
 	//
 	~CBigInteger() = default;
 
+	//
+	// Securely wipes the bytes. The data is stored inline, so this leaves no copies behind on the heap.
+	// Used by SecretKey to clear secret material on destruction.
+	//
 	void erase()
 	{
-		for (size_t i = 0; i < NUM_BYTES; i++)
-		{
-			m_data[i] = 0;
-		}
+		cleanse(m_data.data(), NUM_BYTES);
+	}
+
+	// NOTE: Returns a copy. Prefer data()/size() or operator[] on hot paths.
+	inline std::vector<unsigned char> GetData() const
+	{
+		return std::vector<unsigned char>(m_data.cbegin(), m_data.cend());
 	}
 
-	inline const std::vector<unsigned char, ALLOC>& GetData() const
+	// Returns a copy that is wiped when freed. Use this instead of GetData() for secret material.
+	inline SecureVector GetSecureData() const
 	{
-		return m_data;
+		return SecureVector(m_data.cbegin(), m_data.cend());
 	}
 
-	static CBigInteger<NUM_BYTES, ALLOC> ValueOf(const unsigned char value);
-	static CBigInteger<NUM_BYTES, ALLOC> FromHex(const std::string& hex);
-	static CBigInteger<NUM_BYTES, ALLOC> GetMaximumValue();
+	static CBigInteger<NUM_BYTES> ValueOf(const unsigned char value);
+	static CBigInteger<NUM_BYTES> FromHex(const std::string& hex);
+	static CBigInteger<NUM_BYTES> GetMaximumValue();
 
 	inline size_t size() const { return NUM_BYTES; }
 	inline const unsigned char* data() const { return m_data.data(); }
+	inline unsigned char* data() { return m_data.data(); }
+
+	inline typename std::array<unsigned char, NUM_BYTES>::const_iterator cbegin() const { return m_data.cbegin(); }
+	inline typename std::array<unsigned char, NUM_BYTES>::const_iterator cend() const { return m_data.cend(); }
 
-	const unsigned char* ToCharArray() const { return &m_data[0]; }
+	const unsigned char* ToCharArray() const { return m_data.data(); }
 	std::string ToHex() const;
 
-	CBigInteger<NUM_BYTES, ALLOC>& ReverseByteOrder();
+	CBigInteger<NUM_BYTES>& ReverseByteOrder();
 
 	CBigInteger addMod(const CBigInteger& addend, const CBigInteger& mod) const;
 
@@ -108,23 +134,7 @@ public:
 
 	inline bool operator<(const CBigInteger& rhs) const
 	{
-		if (this == &rhs)
-		{
-			return false;
-		}
-
-		auto rhsIter = rhs.m_data.cbegin();
-		for (auto iter = this->m_data.cbegin(); iter != this->m_data.cend(); iter++)
-		{
-			if (*rhsIter != *iter)
-			{
-				return *iter < *rhsIter;
-			}
-
-			rhsIter++;
-		}
-
-		return false;
+		return memcmp(m_data.data(), rhs.m_data.data(), NUM_BYTES) < 0;
 	}
 
 	inline bool operator>(const CBigInteger& rhs) const
@@ -134,20 +144,7 @@ public:
 
 	inline bool operator==(const CBigInteger& rhs) const
 	{
-		if (this == &rhs)
-		{
-			return true;
-		}
-
-		for (size_t i = 0; i < NUM_BYTES; i++)
-		{
-			if (this->m_data[i] != rhs.m_data[i])
-			{
-				return false;
-			}
-		}
-
-		return true;
+		return memcmp(m_data.data(), rhs.m_data.data(), NUM_BYTES) == 0;
 	}
 
 	inline bool operator!=(const CBigInteger& rhs) const
@@ -197,31 +194,39 @@ public:
 	}
 
 private:
-	std::vector<unsigned char, ALLOC> m_data;
+	CBigInteger(const unsigned char* data, const size_t size)
+		: m_data()
+	{
+		if (size != NUM_BYTES)
+		{
+			throw std::invalid_argument("CBigInteger: expected " + std::to_string(NUM_BYTES) + " bytes but got " + std::to_string(size));
+		}
+
+		memcpy(m_data.data(), data, NUM_BYTES);
+	}
+
+	std::array<unsigned char, NUM_BYTES> m_data;
 };
 
-template<size_t NUM_BYTES, class ALLOC>
-CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::ValueOf(const unsigned char value)
+template<size_t NUM_BYTES>
+CBigInteger<NUM_BYTES> CBigInteger<NUM_BYTES>::ValueOf(const unsigned char value)
 {
-	std::vector<unsigned char, ALLOC> data(NUM_BYTES);
-	data[NUM_BYTES - 1] = value;
-	return CBigInteger<NUM_BYTES, ALLOC>(&data[0]);
+	CBigInteger<NUM_BYTES> result;
+	result[NUM_BYTES - 1] = value;
+	return result;
 }
 
-template<size_t NUM_BYTES, class ALLOC>
-CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::GetMaximumValue()
+template<size_t NUM_BYTES>
+CBigInteger<NUM_BYTES> CBigInteger<NUM_BYTES>::GetMaximumValue()
 {
-	std::vector<unsigned char, ALLOC> data(NUM_BYTES);
-	for (int i = 0; i < NUM_BYTES; i++)
-	{
-		data[i] = 0xFF;
-	}
+	CBigInteger<NUM_BYTES> result;
+	result.m_data.fill(0xFF);
 
-	return CBigInteger<NUM_BYTES, ALLOC>(&data[0]);
+	return result;
 }
 
-template<size_t NUM_BYTES, class ALLOC>
-CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::FromHex(const std::string& hex)
+template<size_t NUM_BYTES>
+CBigInteger<NUM_BYTES> CBigInteger<NUM_BYTES>::FromHex(const std::string& hex)
 {
 	// TODO: Verify input size
 	size_t index = 0;
@@ -239,13 +244,13 @@ CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::FromHex(const std::
 		}
 	}
 
-	std::vector<unsigned char, ALLOC> data(NUM_BYTES);
-	for (size_t i = 0; i < hexNoSpaces.length(); i += 2)
+	CBigInteger<NUM_BYTES> result;
+	for (size_t i = 0; i < hexNoSpaces.length() && (i / 2) < NUM_BYTES; i += 2)
 	{
-		data[i / 2] = (FromHexChar(hexNoSpaces[i]) * 16 + FromHexChar(hexNoSpaces[i + 1]));
+		result[i / 2] = (FromHexChar(hexNoSpaces[i]) * 16 + FromHexChar(hexNoSpaces[i + 1]));
 	}
 
-	return CBigInteger<NUM_BYTES, ALLOC>(&data[0]);
+	return result;
 }
 
 static unsigned char FromHexChar(const char value)
@@ -263,8 +268,8 @@ static unsigned char FromHexChar(const char value)
 	return (unsigned char)(10 + value - 'A');
 }
 
-template<size_t NUM_BYTES, class ALLOC>
-std::string CBigInteger<NUM_BYTES, ALLOC>::ToHex() const
+template<size_t NUM_BYTES>
+std::string CBigInteger<NUM_BYTES>::ToHex() const
 {
 	std::ostringstream stream;
 	for (const unsigned char byte : m_data)
@@ -275,19 +280,19 @@ std::string CBigInteger<NUM_BYTES, ALLOC>::ToHex() const
 	return stream.str();
 }
 
-template<size_t NUM_BYTES, class ALLOC>
-CBigInteger<NUM_BYTES, ALLOC>& CBigInteger<NUM_BYTES, ALLOC>::ReverseByteOrder()
+template<size_t NUM_BYTES>
+CBigInteger<NUM_BYTES>& CBigInteger<NUM_BYTES>::ReverseByteOrder()
 {
 	std::reverse(m_data.begin(), m_data.end());
 	return *this;
 }
 
-template<size_t NUM_BYTES, class ALLOC>
-CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::addMod(const CBigInteger<NUM_BYTES, ALLOC>& addend, const CBigInteger<NUM_BYTES, ALLOC>& mod) const
+template<size_t NUM_BYTES>
+CBigInteger<NUM_BYTES> CBigInteger<NUM_BYTES>::addMod(const CBigInteger<NUM_BYTES>& addend, const CBigInteger<NUM_BYTES>& mod) const
 {
 	return *this + addend; // TODO: Handle mod
-	//std::vector<unsigned char, ALLOC> zeroVector(NUM_BYTES, 0);
-	//std::vector<unsigned char, ALLOC> totalSum(NUM_BYTES);
+	//std::vector<unsigned char> zeroVector(NUM_BYTES, 0);
+	//std::vector<unsigned char> totalSum(NUM_BYTES);
 
 	//int carry = 0;
 
@@ -319,29 +324,29 @@ CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::addMod(const CBigIn
 	//{
 	//	totalSum[0] = 255;
 	//	int remainder = sum - 255;
-	//	CBigInteger<NUM_BYTES, ALLOC> sum(&totalSum[0]);
+	//	CBigInteger<NUM_BYTES> sum(&totalSum[0]);
 
-	//	CBigInteger<NUM_BYTES, ALLOC> mod = sum % mod;
+	//	CBigInteger<NUM_BYTES> mod = sum % mod;
 	//	totalSum = mod.GetData();
 
 	//	sum = totalSum[0] +
 	//}
 
-	//return CBigInteger<NUM_BYTES, ALLOC>(&totalSum[0]);
+	//return CBigInteger<NUM_BYTES>(&totalSum[0]);
 }
 
-template<size_t NUM_BYTES, class ALLOC>
-CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::operator*(const CBigInteger<NUM_BYTES, ALLOC>& A) const
+template<size_t NUM_BYTES>
+CBigInteger<NUM_BYTES> CBigInteger<NUM_BYTES>::operator*(const CBigInteger<NUM_BYTES>& A) const
 {
-	const CBigInteger<NUM_BYTES, ALLOC> ZERO = CBigInteger<NUM_BYTES, ALLOC>::ValueOf(0);
+	const CBigInteger<NUM_BYTES> ZERO = CBigInteger<NUM_BYTES>::ValueOf(0);
 	if (A == ZERO)
 	{
 		return ZERO;
 	}
 
-	CBigInteger<NUM_BYTES, ALLOC> multiplier = CBigInteger<NUM_BYTES, ALLOC>::ValueOf(1);
-	CBigInteger<NUM_BYTES, ALLOC> nextMultiplier = CBigInteger<NUM_BYTES, ALLOC>::ValueOf(2);
-	CBigInteger<NUM_BYTES, ALLOC> product = *this;
+	CBigInteger<NUM_BYTES> multiplier = CBigInteger<NUM_BYTES>::ValueOf(1);
+	CBigInteger<NUM_BYTES> nextMultiplier = CBigInteger<NUM_BYTES>::ValueOf(2);
+	CBigInteger<NUM_BYTES> product = *this;
 
 	while (nextMultiplier <= A)
 	{
@@ -351,7 +356,7 @@ CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::operator*(const CBi
 		Double(nextMultiplier);
 	}
 
-	CBigInteger<NUM_BYTES, ALLOC> remaining = A - multiplier;
+	CBigInteger<NUM_BYTES> remaining = A - multiplier;
 
 	if (remaining > ZERO)
 	{
@@ -362,7 +367,7 @@ CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::operator*(const CBi
 
 
 	//// TODO: This math is all wrong
-	//std::vector<unsigned char, ALLOC> tempNUM_BYTES;
+	//std::vector<unsigned char> tempNUM_BYTES;
 
 	//int result = 0;
 	//int k = 0;
@@ -386,21 +391,21 @@ CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::operator*(const CBi
 	//	}
 	//}
 
-	//CBigInteger<NUM_BYTES, ALLOC> product(&temp[0]);
+	//CBigInteger<NUM_BYTES> product(&temp[0]);
 	//return product;
 }
 
-template<size_t NUM_BYTES, class ALLOC>
-CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::operator+(const CBigInteger<NUM_BYTES, ALLOC>& addend) const
+template<size_t NUM_BYTES>
+CBigInteger<NUM_BYTES> CBigInteger<NUM_BYTES>::operator+(const CBigInteger<NUM_BYTES>& addend) const
 {
-	std::vector<unsigned char, ALLOC> totalSum(NUM_BYTES);
+	CBigInteger<NUM_BYTES> totalSum;
 
 	int carry = 0;
 
 	for (int i = NUM_BYTES - 1; i >= 0; i--)
 	{
 		int digit1 = m_data[i];
-		int digit2 = addend.GetData()[i];
+		int digit2 = addend[i];
 
 		int sum = digit1 + digit2 + carry;
 
@@ -417,20 +422,20 @@ CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::operator+(const CBi
 		totalSum[i] = (unsigned char)sum;
 	}
 
-	return CBigInteger<NUM_BYTES, ALLOC>(&totalSum[0]);
+	return totalSum;
 }
 
-template<size_t NUM_BYTES, class ALLOC>
-CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::operator-(const CBigInteger<NUM_BYTES, ALLOC>& amount) const
+template<size_t NUM_BYTES>
+CBigInteger<NUM_BYTES> CBigInteger<NUM_BYTES>::operator-(const CBigInteger<NUM_BYTES>& amount) const
 {
-	std::vector<unsigned char, ALLOC> result(NUM_BYTES);
+	CBigInteger<NUM_BYTES> result;
 
 	int carry = 0;
 
 	for (int i = NUM_BYTES - 1; i >= 0; i--)
 	{
 		int digit1 = m_data[i];
-		int digit2 = amount.GetData()[i];
+		int digit2 = amount[i];
 
 		int temp = digit1 - carry;
 		carry = 0;
@@ -444,13 +449,13 @@ CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::operator-(const CBi
 		result[i] = (unsigned char)(temp - digit2);
 	}
 
-	return CBigInteger<NUM_BYTES, ALLOC>(&result[0]);
+	return result;
 }
 
-template<size_t NUM_BYTES, class ALLOC>
-CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::operator*(const int multiplier) const
+template<size_t NUM_BYTES>
+CBigInteger<NUM_BYTES> CBigInteger<NUM_BYTES>::operator*(const int multiplier) const
 {
-	CBigInteger temp(&m_data[0]);
+	CBigInteger temp(*this);
 	for (int i = 1; i < multiplier; i++)
 	{
 		temp = temp + *this;
@@ -459,10 +464,10 @@ CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::operator*(const int
 	return temp;
 }
 
-template<size_t NUM_BYTES, class ALLOC>
-CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::operator/(const int divisor) const
+template<size_t NUM_BYTES>
+CBigInteger<NUM_BYTES> CBigInteger<NUM_BYTES>::operator/(const int divisor) const
 {
-	std::vector<unsigned char, ALLOC> quotient(NUM_BYTES);
+	CBigInteger<NUM_BYTES> quotient;
 
 	int remainder = 0;
 	for (int i = 0; i < NUM_BYTES; i++)
@@ -472,26 +477,26 @@ CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::operator/(const int
 		remainder -= quotient[i] * divisor;
 	}
 
-	return CBigInteger<NUM_BYTES, ALLOC>(&quotient[0]);
+	return quotient;
 }
 
-template<size_t NUM_BYTES, class ALLOC>
-static void Double(CBigInteger<NUM_BYTES, ALLOC>& number)
+template<size_t NUM_BYTES>
+static void Double(CBigInteger<NUM_BYTES>& number)
 {
 	// TODO: Handle overflow
 	number = number + number;
 }
 
-template<size_t NUM_BYTES, class ALLOC>
-CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::operator/(const CBigInteger<NUM_BYTES, ALLOC>& divisor) const
+template<size_t NUM_BYTES>
+CBigInteger<NUM_BYTES> CBigInteger<NUM_BYTES>::operator/(const CBigInteger<NUM_BYTES>& divisor) const
 {
-	CBigInteger<NUM_BYTES, ALLOC> remaining = *this;
+	CBigInteger<NUM_BYTES> remaining = *this;
 
-	const CBigInteger<NUM_BYTES, ALLOC> ZERO = CBigInteger<NUM_BYTES, ALLOC>::ValueOf(0);
+	const CBigInteger<NUM_BYTES> ZERO = CBigInteger<NUM_BYTES>::ValueOf(0);
 
-	CBigInteger<NUM_BYTES, ALLOC> multiplier = CBigInteger<NUM_BYTES, ALLOC>::ValueOf(0);
-	CBigInteger<NUM_BYTES, ALLOC> prevTotal = divisor;
-	CBigInteger<NUM_BYTES, ALLOC> total = divisor;
+	CBigInteger<NUM_BYTES> multiplier = CBigInteger<NUM_BYTES>::ValueOf(0);
+	CBigInteger<NUM_BYTES> prevTotal = divisor;
+	CBigInteger<NUM_BYTES> total = divisor;
 
 	while (total <= remaining)
 	{
@@ -500,7 +505,7 @@ CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::operator/(const CBi
 
 		if (multiplier == ZERO)
 		{
-			multiplier = CBigInteger<NUM_BYTES, ALLOC>::ValueOf(1);
+			multiplier = CBigInteger<NUM_BYTES>::ValueOf(1);
 		}
 		else
 		{
@@ -510,7 +515,7 @@ CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::operator/(const CBi
 
 	total = prevTotal;
 
-	CBigInteger<NUM_BYTES, ALLOC> quotient = multiplier;
+	CBigInteger<NUM_BYTES> quotient = multiplier;
 	remaining  = remaining - total;
 	
 	if (remaining >= divisor)
@@ -521,32 +526,32 @@ CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::operator/(const CBi
 	return quotient;
 }
 
-template<size_t NUM_BYTES, class ALLOC>
-int CBigInteger<NUM_BYTES, ALLOC>::operator%(const int modulo) const
+template<size_t NUM_BYTES>
+int CBigInteger<NUM_BYTES>::operator%(const int modulo) const
 {
-	CBigInteger<NUM_BYTES, ALLOC> quotient = *this / modulo;
+	CBigInteger<NUM_BYTES> quotient = *this / modulo;
 
-	CBigInteger<NUM_BYTES, ALLOC> product = quotient * modulo;
-	CBigInteger<NUM_BYTES, ALLOC> modResult = *this - product;
+	CBigInteger<NUM_BYTES> product = quotient * modulo;
+	CBigInteger<NUM_BYTES> modResult = *this - product;
 
 	return modResult.m_data[NUM_BYTES - 1];
 }
 
-template<size_t NUM_BYTES, class ALLOC>
-CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::operator%(const CBigInteger<NUM_BYTES, ALLOC>& modulo) const
+template<size_t NUM_BYTES>
+CBigInteger<NUM_BYTES> CBigInteger<NUM_BYTES>::operator%(const CBigInteger<NUM_BYTES>& modulo) const
 {
-	CBigInteger<NUM_BYTES, ALLOC> quotient = *this / modulo;
+	CBigInteger<NUM_BYTES> quotient = *this / modulo;
 
-	CBigInteger<NUM_BYTES, ALLOC> product = quotient * modulo;
-	CBigInteger<NUM_BYTES, ALLOC> modResult = *this - product;
+	CBigInteger<NUM_BYTES> product = quotient * modulo;
+	CBigInteger<NUM_BYTES> modResult = *this - product;
 
 	return modResult;
 }
 
-template<size_t NUM_BYTES, class ALLOC>
-CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::operator^(const CBigInteger<NUM_BYTES, ALLOC>& xor) const
+template<size_t NUM_BYTES>
+CBigInteger<NUM_BYTES> CBigInteger<NUM_BYTES>::operator^(const CBigInteger<NUM_BYTES>& xor) const
 {
-	CBigInteger<NUM_BYTES, ALLOC> result = *this;
+	CBigInteger<NUM_BYTES> result = *this;
 	for (size_t i = 0; i < NUM_BYTES; i++)
 	{
 		result[i] ^= xor[i];
@@ -74,7 +74,7 @@ namespace std
 	{
 		size_t operator()(const Commitment& commitment) const
 		{
-			const std::vector<unsigned char>& bytes = commitment.GetCommitmentBytes().GetData();
+			const CBigInteger<33>& bytes = commitment.GetCommitmentBytes();
 			return BitUtil::ConvertToU64(bytes[0], bytes[4], bytes[8], bytes[12], bytes[16], bytes[20], bytes[24], bytes[28]);
 		}
 	};
@@ -21,6 +21,7 @@
 #include <Crypto/Hash.h>
 #include <Crypto/PublicKey.h>
 #include <Crypto/SecretKey.h>
+#include <Crypto/VerifiedCache.h>
 
 #ifdef MW_CRYPTO
 #define CRYPTO_API EXPORT
@@ -40,14 +41,22 @@ public:
 	static CBigInteger<32> Blake2b(const std::vector<unsigned char>& input);
 
 	//
-	// Uses Blake2b to hash the given input into a 32 byte hash using a key.
+	// Uses Blake2b to hash the given secret input into a 32 byte hash using a key.
 	//
-	static CBigInteger<32> Blake2b(const std::vector<unsigned char>& key, const std::vector<unsigned char>& input);
+	static CBigInteger<32> Blake2b(const std::vector<unsigned char>& key, const SecureVector& input);
+
+	//
+	// Uses Blake2b to hash each of the given messages into a 32 byte hash.
+	// The messages must all be messageLength bytes, and are stored back to back.
+	// Multiple messages are hashed at once on CPUs that support AVX2.
+	//
+	static std::vector<CBigInteger<32>> Blake2bBatch(const std::vector<unsigned char>& messages, const size_t messageLength);
 
 	//
 	// Uses SHA256 to hash the given input into a 32 byte hash.
 	//
 	static CBigInteger<32> SHA256(const std::vector<unsigned char>& input);
+	static CBigInteger<32> SHA256(const SecureVector& input);
 
 	//
 	// Uses RipeMD160 to hash the given input into a 20 byte hash.
@@ -57,12 +66,12 @@ public:
 	//
 	//
 	//
-	static CBigInteger<32> HMAC_SHA256(const std::vector<unsigned char>& key, const std::vector<unsigned char>& data);
+	static CBigInteger<32> HMAC_SHA256(const SecureVector& key, const SecureVector& data);
 
 	//
 	//
 	//
-	static CBigInteger<64> HMAC_SHA512(const std::vector<unsigned char>& key, const std::vector<unsigned char>& data);
+	static CBigInteger<64> HMAC_SHA512(const SecureVector& key, const SecureVector& data);
 
 	//
 	// Creates a pedersen commitment from a value with a zero blinding factor.
@@ -98,6 +107,23 @@ public:
 	//
 	static bool VerifyKernelSignature(const Signature& signature, const Commitment& publicKey, const Hash& message);
 
+	//
+	// Batch verifies the kernel signatures using a single multi-scalar multiplication.
+	// Returns false if any signature is invalid, without identifying which one.
+	//
+	static bool VerifyKernelSignatures(const std::vector<const Signature*>& signatures, const std::vector<const Commitment*>& publicKeys, const std::vector<const Hash*>& messages);
+
+	//
+	// Sets the maximum number of verified rangeproofs and kernel signatures to remember, so they aren't verified again.
+	//
+	static void ConfigureVerifiedCaches(const size_t rangeProofCacheSize, const size_t kernelSignatureCacheSize);
+
+	//
+	// Returns the number of hits and misses of the verified rangeproof and kernel signature caches.
+	//
+	static VerifiedCache::Stats GetRangeProofCacheStats();
+	static VerifiedCache::Stats GetKernelSignatureCacheStats();
+
 	//
 	//
 	//
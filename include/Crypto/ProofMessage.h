@@ -32,7 +32,7 @@ public:
 	std::vector<uint32_t> ToKeyIndices(const uint8_t length) const
 	{
 		std::vector<uint32_t> keyIndices(length);
-		ByteBuffer byteBuffer(m_proofMessageBytes.GetData());
+		ByteBuffer byteBuffer(ByteView(m_proofMessageBytes.data(), m_proofMessageBytes.size()));
 		for (size_t i = 0; i < length; i++)
 		{
 			keyIndices[i] = byteBuffer.ReadU32();
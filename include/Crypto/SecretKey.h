@@ -20,8 +20,8 @@ public:
 
 	inline const CBigInteger<32>& GetBytes() const { return m_seed; }
 
-	inline const unsigned char* data() const { return m_seed.GetData().data(); }
-	inline size_t size() const { return m_seed.GetData().size(); }
+	inline const unsigned char* data() const { return m_seed.data(); }
+	inline size_t size() const { return m_seed.size(); }
 
 	//
 	// Serialization/Deserialization
@@ -0,0 +1,138 @@
+#pragma once
+
+//
+// This code is free for all purposes without any express guarantee it works.
+//
+// Author: David Burkett (davidburkett38@gmail.com)
+//
+
+#include <Crypto/Hash.h>
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+#include <cstring>
+#include <stdint.h>
+
+//
+// Thread-safe set of fingerprints of data that was already verified (ie. rangeproofs and kernel signatures).
+// A fingerprint is the hash of everything the verification depends on, so a match means the exact same data was verified before.
+// Fingerprints are spread across independently locked shards to keep verification threads from contending on a single lock.
+// Once a shard is full, its oldest fingerprints are evicted first.
+//
+class VerifiedCache
+{
+public:
+	struct Stats
+	{
+		uint64_t hits;
+		uint64_t misses;
+	};
+
+	// Used until the node config is applied, and when the config doesn't override it.
+	static const size_t DEFAULT_CAPACITY = 50000;
+
+	VerifiedCache(const size_t capacity)
+		: m_shardCapacity(0), m_hits(0), m_misses(0)
+	{
+		SetCapacity(capacity);
+	}
+
+	//
+	// Sets the maximum number of fingerprints to remember. A capacity of 0 disables the cache.
+	//
+	void SetCapacity(const size_t capacity)
+	{
+		const size_t shardCapacity = (capacity + NUM_SHARDS - 1) / NUM_SHARDS;
+		m_shardCapacity = shardCapacity;
+
+		for (Shard& shard : m_shards)
+		{
+			std::unique_lock<std::mutex> lock(shard.mutex);
+			EvictToSize(shard, shardCapacity);
+		}
+	}
+
+	bool Contains(const Hash& fingerprint) const
+	{
+		const Shard& shard = GetShard(fingerprint);
+
+		bool found = false;
+		{
+			std::unique_lock<std::mutex> lock(shard.mutex);
+			found = shard.fingerprints.find(fingerprint) != shard.fingerprints.end();
+		}
+
+		if (found)
+		{
+			++m_hits;
+		}
+		else
+		{
+			++m_misses;
+		}
+
+		return found;
+	}
+
+	void Add(const Hash& fingerprint)
+	{
+		const size_t shardCapacity = m_shardCapacity;
+		if (shardCapacity == 0)
+		{
+			return;
+		}
+
+		Shard& shard = GetShard(fingerprint);
+
+		std::unique_lock<std::mutex> lock(shard.mutex);
+		if (shard.fingerprints.insert(fingerprint).second)
+		{
+			shard.insertionOrder.push_back(fingerprint);
+			EvictToSize(shard, shardCapacity);
+		}
+	}
+
+	Stats GetStats() const { return Stats{ m_hits.load(), m_misses.load() }; }
+
+private:
+	static const size_t NUM_SHARDS = 16;
+
+	// Fingerprints are already uniformly distributed hashes, so their leading bytes make a perfectly good hash.
+	struct FingerprintHasher
+	{
+		size_t operator()(const Hash& fingerprint) const
+		{
+			size_t value;
+			memcpy(&value, fingerprint.data(), sizeof(size_t));
+			return value;
+		}
+	};
+
+	struct Shard
+	{
+		mutable std::mutex mutex;
+		std::unordered_set<Hash, FingerprintHasher> fingerprints;
+		std::deque<Hash> insertionOrder;
+	};
+
+	static void EvictToSize(Shard& shard, const size_t size)
+	{
+		while (shard.insertionOrder.size() > size)
+		{
+			shard.fingerprints.erase(shard.insertionOrder.front());
+			shard.insertionOrder.pop_front();
+		}
+	}
+
+	// Uses the last byte, since the leading bytes already pick the bucket within the shard.
+	inline Shard& GetShard(const Hash& fingerprint) { return m_shards[fingerprint[HASH_SIZE - 1] % NUM_SHARDS]; }
+	inline const Shard& GetShard(const Hash& fingerprint) const { return m_shards[fingerprint[HASH_SIZE - 1] % NUM_SHARDS]; }
+
+	std::array<Shard, NUM_SHARDS> m_shards;
+	std::atomic<size_t> m_shardCapacity;
+	mutable std::atomic<uint64_t> m_hits;
+	mutable std::atomic<uint64_t> m_misses;
+};
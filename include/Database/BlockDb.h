@@ -35,4 +35,55 @@ public:
 
 	virtual void AddBlockInputBitmap(const Hash& blockHash, const Roaring& bitmap) = 0;
 	virtual std::optional<Roaring> GetBlockInputBitmap(const Hash& blockHash) const = 0;
+
+	//
+	// Buffers every write made by the calling thread until CommitBatch or RollbackBatch is called,
+	// so all of a block's changes are written atomically, with a single WAL append.
+	// Reads from the calling thread include the buffered writes. Writes from other threads are not batched,
+	// but a second thread calling BeginBatch waits until the first batch is committed or rolled back.
+	//
+	virtual void BeginBatch() = 0;
+	virtual bool CommitBatch() = 0;
+	virtual void RollbackBatch() = 0;
+};
+
+//
+// Begins a batch on construction, and rolls it back on destruction unless it was committed or rolled back already,
+// so an exception thrown while batching can't leave the BlockDB locked in batching mode.
+//
+class ScopedBlockDBBatch
+{
+public:
+	ScopedBlockDBBatch(IBlockDB& blockDB)
+		: m_blockDB(blockDB), m_open(true)
+	{
+		m_blockDB.BeginBatch();
+	}
+
+	~ScopedBlockDBBatch()
+	{
+		Rollback();
+	}
+
+	ScopedBlockDBBatch(const ScopedBlockDBBatch&) = delete;
+	ScopedBlockDBBatch& operator=(const ScopedBlockDBBatch&) = delete;
+
+	bool Commit()
+	{
+		m_open = false;
+		return m_blockDB.CommitBatch();
+	}
+
+	void Rollback()
+	{
+		if (m_open)
+		{
+			m_open = false;
+			m_blockDB.RollbackBatch();
+		}
+	}
+
+private:
+	IBlockDB& m_blockDB;
+	bool m_open;
 };
\ No newline at end of file
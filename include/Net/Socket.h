@@ -1,9 +1,15 @@
 #pragma once
 
 #include <Net/SocketAddress.h>
+#include <Core/Serialization/ByteView.h>
 #include <inttypes.h>
 #include <vector>
+
+#ifdef _WIN32
 #include <WinSock2.h>
+#else
+typedef int SOCKET;
+#endif
 
 class Socket
 {
@@ -12,6 +18,8 @@ public:
 
 	bool CloseSocket();
 
+	inline SOCKET GetHandle() const { return m_socket; }
+
 	inline const SocketAddress& GetSocketAddress() const { return m_address; }
 	inline const IPAddress& GetIPAddress() const { return m_address.GetIPAddress(); }
 	inline uint16_t GetPort() const { return m_address.GetPortNumber(); }
@@ -29,9 +37,31 @@ public:
 
 	bool Send(const std::vector<unsigned char>& message);
 
+	//
+	// Sends each of the buffers in order, handing as many as possible to the OS in a single call (writev/WSASend).
+	//
+	bool SendVectored(const std::vector<ByteView>& buffers);
+
+	//
+	// Sends as much of the buffers as the OS will accept without waiting, and returns the number of bytes sent in bytesSent.
+	// Returns false only if the send failed, so 0 bytes sent just means the socket's send buffer is full.
+	//
+	bool TrySendVectored(const std::vector<ByteView>& buffers, size_t& bytesSent);
+
 	bool HasReceivedData(const long timeoutMillis) const;
 	bool Receive(const size_t numBytes, std::vector<unsigned char>& data) const;
 
+	//
+	// Receives up to maxBytes, returning as soon as any bytes have arrived.
+	// Returns the number of bytes received, or 0 if the connection was closed or failed.
+	//
+	size_t ReceiveSome(unsigned char* pData, const size_t maxBytes) const;
+
+	//
+	// Returns the number of bytes that have arrived, and can be received without blocking.
+	//
+	size_t GetNumBytesAvailable() const;
+
 private:
 	SOCKET m_socket;
 
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <Net/Socket.h>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+// Forward Declarations
+class SocketPoller;
+
+//
+// Multiplexes many sockets over a small, fixed pool of I/O threads, instead of dedicating a thread to each socket.
+// Each socket is assigned to one I/O thread for its lifetime, so its handler's callbacks never run concurrently.
+//
+// Add, RequestWrite, SetReadInterest, SetSuspended, and Remove may be called from any thread. The changes are handed to the socket's I/O thread,
+// which applies them between waits, so the poller and the handler maps are only ever touched by their own thread.
+//
+class SocketReactor
+{
+public:
+	class IHandler
+	{
+	public:
+		virtual ~IHandler() = default;
+
+		//
+		// Called on the I/O thread when the socket has data to receive, or was closed by the peer.
+		// Returning false removes the socket from the reactor.
+		//
+		virtual bool OnReadable() = 0;
+
+		//
+		// Called on the I/O thread when the socket can be written to after RequestWrite was called.
+		// Write interest is cleared after each call, so handlers must call RequestWrite again when they have more to send.
+		// Returning false removes the socket from the reactor.
+		//
+		virtual bool OnWritable() = 0;
+
+		//
+		// Called on the I/O thread once the socket has been removed, after which the reactor no longer references the handler.
+		//
+		virtual void OnRemoved() = 0;
+	};
+
+	SocketReactor(const size_t numThreads);
+	~SocketReactor();
+
+	void Start();
+	void Stop();
+
+	void Add(const SOCKET socket, IHandler& handler);
+	void RequestWrite(IHandler& handler);
+
+	//
+	// Stops (or resumes) calling OnReadable for the handler, so a handler can stop receiving until it has caught up on sending.
+	// Errors and hangups are still reported through OnReadable.
+	//
+	void SetReadInterest(IHandler& handler, const bool readInterest);
+
+	//
+	// Takes the handler's socket out of (or puts it back into) the poller, without unregistering the handler,
+	// so another thread can use the socket directly for a while. No callbacks are made for a suspended socket, not even for errors or hangups.
+	// Write and read interest changes made while suspended take effect once the socket is resumed.
+	//
+	void SetSuspended(IHandler& handler, const bool suspended);
+
+	//
+	// Removes the handler's socket, and waits until OnRemoved has been called, so the handler can safely be destroyed.
+	// Returns false if the handler was not registered, or was already removed because one of its callbacks returned false.
+	//
+	bool Remove(IHandler& handler);
+
+private:
+	struct Registration
+	{
+		SOCKET socket;
+		bool readInterest;
+		bool writeInterest;
+		bool suspended;
+	};
+
+	struct IOThread
+	{
+		IOThread();
+		~IOThread();
+
+		std::unique_ptr<SocketPoller> pPoller;
+		std::thread thread;
+
+		std::mutex mutex;
+		std::condition_variable removedCondition;
+		std::vector<std::pair<SOCKET, IHandler*>> pendingAdds;
+		std::vector<IHandler*> pendingWrites;
+		std::vector<std::pair<IHandler*, bool>> pendingReadInterest;
+		std::vector<std::pair<IHandler*, bool>> pendingSuspensions;
+		std::unordered_set<IHandler*> pendingRemoves;
+		std::unordered_map<IHandler*, bool> completedRemoves;
+
+		// Only accessed by the I/O thread.
+		std::unordered_map<SOCKET, IHandler*> handlersBySocket;
+		std::unordered_map<IHandler*, Registration> registrations;
+	};
+
+	static void Thread_IO(SocketReactor& reactor, IOThread& ioThread);
+	IOThread* GetIOThread(IHandler& handler) const;
+	void ApplyPendingChanges(IOThread& ioThread);
+	bool RemoveHandler(IOThread& ioThread, IHandler* pHandler);
+
+	std::vector<std::unique_ptr<IOThread>> m_ioThreads;
+	std::atomic<bool> m_terminate;
+
+	mutable std::mutex m_assignmentMutex;
+	std::unordered_map<IHandler*, size_t> m_assignments;
+	size_t m_nextThread;
+};
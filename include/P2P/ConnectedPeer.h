@@ -8,12 +8,18 @@ class ConnectedPeer
 {
 public:
 	ConnectedPeer(const Socket& socket,  const Peer& peer, const EDirection direction)
-		: m_socket(socket), m_peer(peer), m_direction(direction), m_height(0), m_totalDifficulty(0)
+		: m_socket(socket), m_peer(peer), m_direction(direction), m_height(0), m_totalDifficulty(0), m_bytesSent(0), m_bytesReceived(0)
 	{
 
 	}
 	ConnectedPeer(const ConnectedPeer& peer)
-		: m_socket(peer.m_socket), m_peer(peer.m_peer), m_direction(peer.m_direction), m_height(peer.m_height.load()), m_totalDifficulty(peer.m_totalDifficulty.load())
+		: m_socket(peer.m_socket),
+		m_peer(peer.m_peer),
+		m_direction(peer.m_direction),
+		m_height(peer.m_height.load()),
+		m_totalDifficulty(peer.m_totalDifficulty.load()),
+		m_bytesSent(peer.m_bytesSent.load()),
+		m_bytesReceived(peer.m_bytesReceived.load())
 	{
 
 	}
@@ -30,6 +36,11 @@ public:
 	inline const EDirection GetDirection() const { return m_direction; }
 	inline const uint64_t GetTotalDifficulty() const { return m_totalDifficulty.load(); }
 	inline const uint64_t GetHeight() const { return m_height.load(); }
+	inline const uint64_t GetBytesSent() const { return m_bytesSent.load(); }
+	inline const uint64_t GetBytesReceived() const { return m_bytesReceived.load(); }
+
+	inline void AddBytesSent(const uint64_t bytesSent) { m_bytesSent += bytesSent; }
+	inline void AddBytesReceived(const uint64_t bytesReceived) { m_bytesReceived += bytesReceived; }
 
 	inline void UpdateVersion(const uint32_t version) { m_peer.UpdateVersion(version); }
 	inline void UpdateCapabilities(const Capabilities& capabilities) { m_peer.UpdateCapabilities(capabilities); }
@@ -42,5 +53,6 @@ private:
 	Peer m_peer;
 	std::atomic<uint64_t> m_totalDifficulty;
 	std::atomic<uint64_t> m_height;
-	// TODO: Add Connection Stats
+	std::atomic<uint64_t> m_bytesSent;
+	std::atomic<uint64_t> m_bytesReceived;
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include <string>
 #include <Core/Models/BlockSums.h>
 #include <Core/Models/OutputLocation.h>
@@ -23,7 +24,7 @@ public:
 	// Validates all hashes, signatures, etc in the entire TxHashSet.
 	// This is typically only used during initial sync.
 	//
-	virtual std::unique_ptr<BlockSums> ValidateTxHashSet(const BlockHeader& header, const IBlockChainServer& blockChainServer) = 0;
+	virtual std::unique_ptr<BlockSums> ValidateTxHashSet(const Config& config, const BlockHeader& header, const IBlockChainServer& blockChainServer) = 0;
 
 	//
 	// Saves the commitments, MMR indices, and block height for all unspent outputs in the block.
@@ -38,6 +39,12 @@ public:
 	//
 	virtual bool IsUnspent(const OutputLocation& location) const = 0;
 
+	//
+	// Returns the location of the unspent output with the given commitment, without reading from the BlockDB.
+	// Outputs spent by uncommitted blocks may still be returned, so use IsUnspent to check whether it's actually unspent.
+	//
+	virtual std::optional<OutputLocation> GetOutputPosition(const Commitment& outputCommitment) const = 0;
+
 	//
 	// Returns true if all inputs in the transaction are valid and unspent. Otherwise, false.
 	//
@@ -45,6 +52,8 @@ public:
 
 	//
 	// Appends all new kernels, outputs, and rangeproofs to the MMRs, and prunes all of the inputs.
+	// The output positions and input bitmap are written to the calling thread's BlockDB batch, if one was started,
+	// so they can be rolled back along with the TxHashSet if the block turns out to be invalid.
 	//
 	virtual bool ApplyBlock(const FullBlock& block) = 0;
 
@@ -92,6 +101,10 @@ public:
 	//
 	virtual bool Discard() = 0;
 
-	
+	//
+	// Prunes the outputs and rangeproofs spent before the cut-through horizon from disk.
+	// Most of the work is done without blocking readers or writers. If there are uncommitted changes when it's done,
+	// the compacted files are swapped in during the next Commit instead.
+	//
 	virtual bool Compact() = 0;
 };
\ No newline at end of file
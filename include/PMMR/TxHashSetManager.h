@@ -17,8 +17,17 @@ public:
 	TxHashSetManager(const Config& config, IBlockDB& blockDB);
 	~TxHashSetManager() = default;
 
+	//
+	// Opens the TxHashSet at the confirmed tip. Returns nullptr if the files can't be brought back to the confirmed tip.
+	//
 	ITxHashSet* Open(const BlockHeader& confirmedTip);
-	void Flush();
+
+	//
+	// Deletes the TxHashSet files and opens an empty TxHashSet at the genesis header, so it can be resynced.
+	//
+	ITxHashSet* Reset(const BlockHeader& genesisHeader);
+
+	bool Flush();
 	void Close();
 
 	ITxHashSet* GetTxHashSet();
@@ -26,6 +35,12 @@ public:
 	void SetTxHashSet(ITxHashSet* pTxHashSet);
 	static void DestroyTxHashSet(ITxHashSet* pTxHashSet);
 
+	//
+	// Periodically compacts the current TxHashSet in the background, including any TxHashSet it's later replaced with.
+	//
+	void StartCompaction();
+	void StopCompaction();
+
 	static ITxHashSet* LoadFromZip(const Config& config, IBlockDB& blockDB, const std::string& zipFilePath, const BlockHeader& header);
 	bool SaveSnapshot(const BlockHeader& header, const std::string& zipFilePath);
 
@@ -33,6 +48,7 @@ private:
 	const Config& m_config;
 	IBlockDB& m_blockDB;
 	ITxHashSet* m_pTxHashSet;
+	bool m_compactionEnabled;
 
 	// TODO: Needs mutex
 };
\ No newline at end of file
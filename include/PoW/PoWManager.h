@@ -25,6 +25,18 @@ public:
 
 	bool IsPoWValid(const BlockHeader& header, const BlockHeader& previousHeader) const;
 
+	//
+	// Validates the total difficulty and secondary scaling against the previous headers.
+	// Previous headers that aren't stored yet can be passed in as pPendingHeaders (consecutive, ordered by height).
+	//
+	bool IsDifficultyValid(const BlockHeader& header, const BlockHeader& previousHeader, const std::vector<BlockHeader>* pPendingHeaders = nullptr) const;
+
+	//
+	// Validates the cuckoo cycle. This is the expensive part of validating proof of work, but doesn't depend on any other header,
+	// so it can be done in parallel for many headers, before taking any locks.
+	//
+	bool IsProofValid(const BlockHeader& header) const;
+
 private:
 	const Config& m_config;
 	const IBlockDB& m_blockDB;
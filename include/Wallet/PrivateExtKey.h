@@ -7,11 +7,9 @@ class PrivateExtKey : public IExtendedKey
 public:
 	static PrivateExtKey Create(const uint32_t network, const uint8_t depth, const uint32_t parentFingerprint, const uint32_t childNumber, SecretKey&& chainCode, SecretKey&& privateKey)
 	{
-		std::vector<unsigned char> keyBytes;
-		keyBytes.reserve(33);
-		keyBytes.push_back(0);
-		keyBytes.insert(keyBytes.end(), privateKey.GetBytes().GetData().cbegin(), privateKey.GetBytes().GetData().cend());
-		return PrivateExtKey(network, depth, parentFingerprint, childNumber, std::move(chainCode), CBigInteger<33>(std::move(keyBytes)), std::move(privateKey));
+		CBigInteger<33> keyBytes;
+		std::copy(privateKey.GetBytes().cbegin(), privateKey.GetBytes().cend(), keyBytes.data() + 1);
+		return PrivateExtKey(network, depth, parentFingerprint, childNumber, std::move(chainCode), std::move(keyBytes), std::move(privateKey));
 	}
 
 	inline const SecretKey& GetPrivateKey() const { return m_privateKey; }
@@ -25,8 +23,7 @@ public:
 		SecretKey chainCode = byteBuffer.ReadBigInteger<32>();
 		CBigInteger<33> keyBytes = byteBuffer.ReadBigInteger<33>();
 
-		std::vector<unsigned char> privateKeyBytes(keyBytes.GetData().cbegin() + 1, keyBytes.GetData().cend());
-		SecretKey privateKey(std::move(privateKeyBytes));
+		SecretKey privateKey(CBigInteger<32>(keyBytes.data() + 1));
 
 		return PrivateExtKey(network, depth, parentFingerprint, childNumber, std::move(chainCode), std::move(keyBytes), std::move(privateKey));
 	}